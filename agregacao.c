@@ -0,0 +1,465 @@
+/*
+->agregacao.c
+Implementação da agregação (GROUP BY) das amostras agrícolas em memória.
+Calcula contagem, soma, média, mínimo e máximo de produção, valor total, área plantada,
+preço por tonelada e rendimento, agrupados por qualquer combinação de estado, cultura e ano
+(ou intervalo de anos, como décadas).
+A agregação é feita por hash: cada grupo tem uma chave de 64 bits (classe do estado, classe da
+cultura e ano) e uma tabela de endereçamento aberto leva da chave ao grupo. Os registros do
+armazém são divididos em partições contíguas, uma por thread; cada thread agrega a sua partição
+em uma tabela própria, sem travas, e as tabelas parciais são mescladas ao final.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "agregacao.h"
+#include "memoria.h"
+
+#define CHAVE_VAZIA_AGREGACAO -1
+
+typedef struct{
+    const ArmazemRegistros *armazem;
+    int inicio;
+    int fim;
+    TabelaAgregacao parcial;
+} ParticaoAgregacao;
+
+/*
+Inicializa uma tabela de agregação vazia.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    agrupar - combinação de AGRUPAR_ESTADO, AGRUPAR_CULTURA e AGRUPAR_ANO (0 para um único grupo)
+    largura_ano - tamanho do intervalo de anos de cada grupo (1 para ano a ano, 10 para décadas)
+*/
+void iniciar_agregacao(TabelaAgregacao *tabela, int agrupar, int largura_ano){
+    tabela->grupos = NULL;
+    tabela->chaves = NULL;
+    tabela->total = 0;
+    tabela->capacidade = 0;
+    tabela->baldes = NULL;
+    tabela->n_baldes = 0;
+    tabela->agrupar = agrupar;
+    tabela->largura_ano = largura_ano < 1 ? 1 : largura_ano;
+}
+
+/*
+Monta a chave de um grupo. Campos que não fazem parte do agrupamento valem -1.
+*/
+static unsigned long long chave_agregacao(int estado, int cultura, int ano){
+    return ((unsigned long long)(unsigned short)(estado + 1) << 48)
+        | ((unsigned long long)(unsigned short)(cultura + 1) << 32)
+        | (unsigned int)ano;
+}
+
+/*
+Espalha os bits de uma chave para escolher o balde (finalizador do splitmix64).
+*/
+static unsigned int hash_agregacao(unsigned long long chave){
+    chave ^= chave >> 30;
+    chave *= 0xbf58476d1ce4e5b9ULL;
+    chave ^= chave >> 27;
+    chave *= 0x94d049bb133111ebULL;
+    chave ^= chave >> 31;
+    return (unsigned int)chave;
+}
+
+/*
+Refaz a tabela de baldes com um novo número de baldes (potência de 2).
+Parâmetros:
+    tabela - ponteiro para a tabela
+    n_baldes - novo número de baldes
+*/
+static void refazer_baldes_agregacao(TabelaAgregacao *tabela, int n_baldes){
+    int *baldes = (int*)alocar_memoria(MEMORIA_AGREGACAO, n_baldes * sizeof(int));
+    if(!baldes){
+        printf("Erro ao alocar memoria para a agregacao\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0;
+    for(i; i < n_baldes; i++){
+        baldes[i] = CHAVE_VAZIA_AGREGACAO;
+    }
+    for(i = 0; i < tabela->total; i++){
+        unsigned int b = hash_agregacao(tabela->chaves[i]) & (n_baldes - 1);
+        while(baldes[b] != CHAVE_VAZIA_AGREGACAO){
+            b = (b + 1) & (n_baldes - 1);
+        }
+        baldes[b] = i;
+    }
+    liberar_memoria(MEMORIA_AGREGACAO, tabela->baldes);
+    tabela->baldes = baldes;
+    tabela->n_baldes = n_baldes;
+}
+
+/*
+Procura o grupo de uma chave, criando-o (vazio) se ainda não existir.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    chave - chave do grupo (chave_agregacao)
+    estado, cultura, ano - campos do grupo, usados quando ele é criado
+Retorno: ponteiro para o grupo
+*/
+static GrupoAgregacao* grupo_agregacao(TabelaAgregacao *tabela, unsigned long long chave, int estado, int cultura, int ano){
+    if(tabela->n_baldes > 0){
+        unsigned int b = hash_agregacao(chave) & (tabela->n_baldes - 1);
+        while(tabela->baldes[b] != CHAVE_VAZIA_AGREGACAO){
+            if(tabela->chaves[tabela->baldes[b]] == chave){
+                return &tabela->grupos[tabela->baldes[b]];
+            }
+            b = (b + 1) & (tabela->n_baldes - 1);
+        }
+    }
+
+    if(tabela->total == tabela->capacidade){
+        int nova_capacidade = tabela->capacidade == 0 ? 64 : tabela->capacidade * 2;
+        GrupoAgregacao *grupos = (GrupoAgregacao*)realocar_memoria(MEMORIA_AGREGACAO, tabela->grupos, nova_capacidade * sizeof(GrupoAgregacao));
+        unsigned long long *chaves = (unsigned long long*)realocar_memoria(MEMORIA_AGREGACAO, tabela->chaves, nova_capacidade * sizeof(unsigned long long));
+        if(!grupos || !chaves){
+            printf("Erro ao alocar memoria para a agregacao\n");
+            exit(EXIT_FAILURE);
+        }
+        tabela->grupos = grupos;
+        tabela->chaves = chaves;
+        tabela->capacidade = nova_capacidade;
+    }
+
+    GrupoAgregacao *grupo = &tabela->grupos[tabela->total];
+    grupo->estado = estado;
+    grupo->cultura = cultura;
+    grupo->ano = ano;
+    grupo->contagem = 0;
+    int m = 0;
+    for(m; m < N_MEDIDAS_AGREGACAO; m++){
+        grupo->medidas[m].soma = 0;
+        grupo->medidas[m].minimo = 0;
+        grupo->medidas[m].maximo = 0;
+    }
+    tabela->chaves[tabela->total] = chave;
+    tabela->total++;
+
+    /* Mantém a ocupação dos baldes em no máximo 50% */
+    if(tabela->total * 2 > tabela->n_baldes){
+        refazer_baldes_agregacao(tabela, tabela->n_baldes == 0 ? 128 : tabela->n_baldes * 2);
+    }else{
+        unsigned int b = hash_agregacao(chave) & (tabela->n_baldes - 1);
+        while(tabela->baldes[b] != CHAVE_VAZIA_AGREGACAO){
+            b = (b + 1) & (tabela->n_baldes - 1);
+        }
+        tabela->baldes[b] = tabela->total - 1;
+    }
+    return grupo;
+}
+
+/*
+Acumula um valor na estatística de uma medida.
+*/
+static void acumular_medida(EstatisticaAgregacao *e, double valor, int primeiro){
+    e->soma += valor;
+    if(primeiro || valor < e->minimo){
+        e->minimo = valor;
+    }
+    if(primeiro || valor > e->maximo){
+        e->maximo = valor;
+    }
+}
+
+/*
+Acrescenta um registro ao seu grupo. Estados e culturas são agrupados pela classe do
+dicionário, como nos filtros (sem diferenciar maiúsculas de minúsculas).
+Parâmetros:
+    tabela - ponteiro para a tabela
+    r - ponteiro para o registro
+*/
+void agregar_registro(TabelaAgregacao *tabela, const Registro *r){
+    int estado = (tabela->agrupar & AGRUPAR_ESTADO) ? dicionario_estados.classes[r->estado] : -1;
+    int cultura = (tabela->agrupar & AGRUPAR_CULTURA) ? dicionario_culturas.classes[r->cultura] : -1;
+    int ano = -1;
+    if(tabela->agrupar & AGRUPAR_ANO){
+        ano = r->ano - r->ano % tabela->largura_ano;
+    }
+
+    GrupoAgregacao *grupo = grupo_agregacao(tabela, chave_agregacao(estado, cultura, ano), estado, cultura, ano);
+    int primeiro = grupo->contagem == 0;
+    grupo->contagem++;
+    acumular_medida(&grupo->medidas[MEDIDA_PRODUCAO], r->producao, primeiro);
+    acumular_medida(&grupo->medidas[MEDIDA_VALOR_TOTAL], r->valor_total, primeiro);
+    acumular_medida(&grupo->medidas[MEDIDA_AREA_PLANTADA], r->area_plantada, primeiro);
+    acumular_medida(&grupo->medidas[MEDIDA_PRECO_TON], r->preco_ton, primeiro);
+    acumular_medida(&grupo->medidas[MEDIDA_RENDIMENTO], r->rendimento, primeiro);
+}
+
+/*
+Mescla em uma tabela os grupos de outra tabela com o mesmo agrupamento.
+Parâmetros:
+    destino - ponteiro para a tabela que recebe os grupos
+    origem - ponteiro para a tabela parcial
+*/
+void mesclar_agregacao(TabelaAgregacao *destino, const TabelaAgregacao *origem){
+    int i = 0;
+    for(i; i < origem->total; i++){
+        const GrupoAgregacao *parcial = &origem->grupos[i];
+        GrupoAgregacao *grupo = grupo_agregacao(destino, origem->chaves[i], parcial->estado, parcial->cultura, parcial->ano);
+        int primeiro = grupo->contagem == 0;
+        int m = 0;
+        for(m; m < N_MEDIDAS_AGREGACAO; m++){
+            EstatisticaAgregacao *e = &grupo->medidas[m];
+            e->soma += parcial->medidas[m].soma;
+            if(primeiro || parcial->medidas[m].minimo < e->minimo){
+                e->minimo = parcial->medidas[m].minimo;
+            }
+            if(primeiro || parcial->medidas[m].maximo > e->maximo){
+                e->maximo = parcial->medidas[m].maximo;
+            }
+        }
+        grupo->contagem += parcial->contagem;
+    }
+}
+
+/*
+Agrega uma partição do armazém (intervalo de posições), ignorando as posições livres.
+Executada por uma thread de agregação.
+Parâmetro: arg - ponteiro para a ParticaoAgregacao com o intervalo e a tabela parcial
+Retorno: 0
+*/
+static DWORD WINAPI agregar_particao(LPVOID arg){
+    ParticaoAgregacao *particao = (ParticaoAgregacao*)arg;
+    const ArmazemRegistros *armazem = particao->armazem;
+    int b = 0;
+    for(b; b < armazem->n_blocos; b++){
+        const BlocoRegistros *bloco = &armazem->blocos[b];
+        int de = particao->inicio > bloco->inicio ? particao->inicio : bloco->inicio;
+        int ate = bloco->inicio + bloco->usados;
+        if(particao->fim < ate){
+            ate = particao->fim;
+        }
+        int j = de;
+        for(j; j < ate; j++){
+            const Registro *r = &bloco->itens[j - bloco->inicio];
+            if(r->id != ID_LIVRE_ARMAZEM){
+                agregar_registro(&particao->parcial, r);
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+Agrega todos os registros do armazém, dividindo as posições em partições contíguas
+processadas em paralelo.
+Parâmetros:
+    tabela - ponteiro para a tabela (iniciada com o agrupamento desejado)
+    armazem - ponteiro para o armazém
+    n_threads - número de threads; 0 escolhe automaticamente (uma por processador, sem
+                partições menores que TAM_MIN_PARTICAO_AGREGACAO registros)
+*/
+void agregar_armazem(TabelaAgregacao *tabela, const ArmazemRegistros *armazem, int n_threads){
+    ParticaoAgregacao particoes[MAX_THREADS_AGREGACAO];
+    HANDLE threads[MAX_THREADS_AGREGACAO];
+
+    int posicoes = 0;
+    if(armazem->n_blocos > 0){
+        const BlocoRegistros *ultimo = &armazem->blocos[armazem->n_blocos - 1];
+        posicoes = ultimo->inicio + ultimo->usados;
+    }
+
+    if(n_threads <= 0){
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        n_threads = (int)info.dwNumberOfProcessors;
+        if(n_threads > armazem->total / TAM_MIN_PARTICAO_AGREGACAO){
+            n_threads = armazem->total / TAM_MIN_PARTICAO_AGREGACAO;
+        }
+    }
+    if(n_threads > MAX_THREADS_AGREGACAO){
+        n_threads = MAX_THREADS_AGREGACAO;
+    }
+    if(n_threads < 1){
+        n_threads = 1;
+    }
+
+    int i = 0;
+    for(i; i < n_threads; i++){
+        particoes[i].armazem = armazem;
+        particoes[i].inicio = (int)((long long)posicoes * i / n_threads);
+        particoes[i].fim = (int)((long long)posicoes * (i + 1) / n_threads);
+        iniciar_agregacao(&particoes[i].parcial, tabela->agrupar, tabela->largura_ano);
+    }
+
+    if(n_threads == 1){
+        agregar_particao(&particoes[0]);
+    }else{
+        for(i = 0; i < n_threads; i++){
+            threads[i] = CreateThread(NULL, 0, agregar_particao, &particoes[i], 0, NULL);
+            if(threads[i] == NULL){
+                printf("Erro ao criar thread de agregacao\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        WaitForMultipleObjects(n_threads, threads, TRUE, INFINITE);
+        for(i = 0; i < n_threads; i++){
+            CloseHandle(threads[i]);
+        }
+    }
+
+    for(i = 0; i < n_threads; i++){
+        mesclar_agregacao(tabela, &particoes[i].parcial);
+        liberar_agregacao(&particoes[i].parcial);
+    }
+}
+
+/*
+Compara dois textos de grupo; campos fora do agrupamento (-1) ficam iguais.
+*/
+static int comparar_campo_agregacao(int a, int b, const char* (*nome)(int)){
+    if(a < 0 || b < 0){
+        return (a > b) - (a < b);
+    }
+    return strcmp(nome(a), nome(b));
+}
+
+/*
+Compara dois grupos por estado, cultura e ano, para uso com qsort.
+*/
+static int comparar_grupos_agregacao(const void *a, const void *b){
+    const GrupoAgregacao *ga = (const GrupoAgregacao*)a;
+    const GrupoAgregacao *gb = (const GrupoAgregacao*)b;
+    int c = comparar_campo_agregacao(ga->estado, gb->estado, nome_estado);
+    if(c == 0){
+        c = comparar_campo_agregacao(ga->cultura, gb->cultura, nome_cultura);
+    }
+    if(c == 0){
+        c = (ga->ano > gb->ano) - (ga->ano < gb->ano);
+    }
+    return c;
+}
+
+/*
+Ordena os grupos por estado, cultura e ano (em ordem alfabética dos textos).
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void ordenar_agregacao(TabelaAgregacao *tabela){
+    qsort(tabela->grupos, tabela->total, sizeof(GrupoAgregacao), comparar_grupos_agregacao);
+    int i = 0;
+    for(i; i < tabela->total; i++){
+        tabela->chaves[i] = chave_agregacao(tabela->grupos[i].estado, tabela->grupos[i].cultura, tabela->grupos[i].ano);
+    }
+    if(tabela->n_baldes > 0){
+        refazer_baldes_agregacao(tabela, tabela->n_baldes);
+    }
+}
+
+/*
+Retorna a média de uma medida em um grupo.
+Parâmetros:
+    grupo - ponteiro para o grupo
+    medida - uma das constantes MEDIDA_*
+Retorno: média (0 para grupo vazio)
+*/
+double media_agregacao(const GrupoAgregacao *grupo, int medida){
+    if(grupo->contagem == 0){
+        return 0;
+    }
+    return grupo->medidas[medida].soma / grupo->contagem;
+}
+
+/*
+Retorna o nome de uma medida, para exibição.
+Parâmetro: medida - uma das constantes MEDIDA_*
+Retorno: nome da medida
+*/
+const char* nome_medida_agregacao(int medida){
+    switch(medida){
+        case MEDIDA_PRODUCAO: return "Producao";
+        case MEDIDA_VALOR_TOTAL: return "Valor Total";
+        case MEDIDA_AREA_PLANTADA: return "Area";
+        case MEDIDA_PRECO_TON: return "Preco/Ton";
+        case MEDIDA_RENDIMENTO: return "Rendimento";
+    }
+    return "";
+}
+
+/*
+Imprime os grupos com contagem, soma, média, mínimo e máximo de uma medida.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    medida - uma das constantes MEDIDA_*
+*/
+void imprimir_agregacao(const TabelaAgregacao *tabela, int medida){
+    printf("\n===AGREGACAO: %s===\n", nome_medida_agregacao(medida));
+    int i = 0;
+    for(i; i < tabela->total; i++){
+        const GrupoAgregacao *g = &tabela->grupos[i];
+        if(tabela->agrupar & AGRUPAR_ESTADO){
+            printf("%s | ", nome_estado(g->estado));
+        }
+        if(tabela->agrupar & AGRUPAR_CULTURA){
+            printf("%s | ", nome_cultura(g->cultura));
+        }
+        if(tabela->agrupar & AGRUPAR_ANO){
+            if(tabela->largura_ano > 1){
+                printf("%d-%d | ", g->ano, g->ano + tabela->largura_ano - 1);
+            }else{
+                printf("%d | ", g->ano);
+            }
+        }
+        const EstatisticaAgregacao *e = &g->medidas[medida];
+        printf("Contagem: %lld | Soma: %.2f | Media: %.2f | Minimo: %.2f | Maximo: %.2f\n",
+            g->contagem, e->soma, media_agregacao(g, medida), e->minimo, e->maximo);
+    }
+    printf("\nTotal de grupos: %d\n", tabela->total);
+}
+
+/*
+Libera a memória da tabela de agregação, mantendo o agrupamento.
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void liberar_agregacao(TabelaAgregacao *tabela){
+    liberar_memoria(MEMORIA_AGREGACAO, tabela->grupos);
+    liberar_memoria(MEMORIA_AGREGACAO, tabela->chaves);
+    liberar_memoria(MEMORIA_AGREGACAO, tabela->baldes);
+    iniciar_agregacao(tabela, tabela->agrupar, tabela->largura_ano);
+}
+
+/*
+Mede o tempo médio de uma agregação completa do dataset em memória.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    agrupar - combinação de AGRUPAR_ESTADO, AGRUPAR_CULTURA e AGRUPAR_ANO
+    largura_ano - tamanho do intervalo de anos de cada grupo
+    n_threads - número de threads (0 escolhe automaticamente)
+    repeticoes - número de agregações completas
+Retorno: tempo médio por agregação em segundos (double)
+*/
+double bench_tempo_agregacao(const char *nome_arquivo, int agrupar, int largura_ano, int n_threads, int repeticoes){
+    struct timespec inicio, fim;
+    Dataset ds;
+    ArmazemRegistros armazem;
+    iniciar_dataset(&ds);
+    iniciar_armazem(&armazem);
+    carregar_dataset(&ds, nome_arquivo);
+    adotar_dataset_armazem(&armazem, &ds);
+
+    if(repeticoes < 1){
+        repeticoes = 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < repeticoes; i++){
+        TabelaAgregacao tabela;
+        iniciar_agregacao(&tabela, agrupar, largura_ano);
+        agregar_armazem(&tabela, &armazem, n_threads);
+        liberar_agregacao(&tabela);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    liberar_armazem(&armazem);
+
+    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    return tempo / repeticoes;
+}
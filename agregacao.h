@@ -0,0 +1,58 @@
+#ifndef AGREGACAO_H
+#define AGREGACAO_H
+
+#include <stdio.h>
+#include "dataset.h"
+#include "registros.h"
+
+#define AGRUPAR_ESTADO 1
+#define AGRUPAR_CULTURA 2
+#define AGRUPAR_ANO 4
+
+#define MEDIDA_PRODUCAO 0
+#define MEDIDA_VALOR_TOTAL 1
+#define MEDIDA_AREA_PLANTADA 2
+#define MEDIDA_PRECO_TON 3
+#define MEDIDA_RENDIMENTO 4
+#define N_MEDIDAS_AGREGACAO 5
+
+#define MAX_THREADS_AGREGACAO 16
+#define TAM_MIN_PARTICAO_AGREGACAO 65536
+
+typedef struct{
+    double soma;
+    double minimo;
+    double maximo;
+} EstatisticaAgregacao;
+
+typedef struct{
+    int estado;
+    int cultura;
+    int ano;
+    long long contagem;
+    EstatisticaAgregacao medidas[N_MEDIDAS_AGREGACAO];
+} GrupoAgregacao;
+
+typedef struct{
+    GrupoAgregacao *grupos;
+    unsigned long long *chaves;
+    int total;
+    int capacidade;
+    int *baldes;
+    int n_baldes;
+    int agrupar;
+    int largura_ano;
+} TabelaAgregacao;
+
+void iniciar_agregacao(TabelaAgregacao *tabela, int agrupar, int largura_ano);
+void agregar_registro(TabelaAgregacao *tabela, const Registro *r);
+void mesclar_agregacao(TabelaAgregacao *destino, const TabelaAgregacao *origem);
+void agregar_armazem(TabelaAgregacao *tabela, const ArmazemRegistros *armazem, int n_threads);
+void ordenar_agregacao(TabelaAgregacao *tabela);
+double media_agregacao(const GrupoAgregacao *grupo, int medida);
+const char* nome_medida_agregacao(int medida);
+void imprimir_agregacao(const TabelaAgregacao *tabela, int medida);
+void liberar_agregacao(TabelaAgregacao *tabela);
+double bench_tempo_agregacao(const char *nome_arquivo, int agrupar, int largura_ano, int n_threads, int repeticoes);
+
+#endif
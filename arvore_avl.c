@@ -2,8 +2,8 @@
 ->arvore_avl.c
 Implementação de uma árvore AVL para manipulação de amostras agrícolas.
 Este arquivo contém as funções para inserir, remover, buscar, filtrar, imprimir 
-e carregar dados em uma árvore AVL, além de funções auxiliares
-e do conjunto de nove funções para benchmark.
+e carregar dados em uma árvore AVL, além de funções auxiliares e das primitivas
+usadas pelo modo benchmark (bench.c).
 */
 
 #include <stdio.h>
@@ -13,6 +13,7 @@ e do conjunto de nove funções para benchmark.
 #include <time.h>
 #include <windows.h>
 #include "arvore_avl.h"
+#include "memoria.h"
 
 /*
 Calcula a altura de um nó da árvore AVL.
@@ -90,18 +91,19 @@ int fator_balanceamento(ItemAVL *no){
 }
 
 /*
-Cria um novo nó para a árvore AVL a partir de uma estrutura fornecida.
-Parâmetro: novo - estrutura com os dados a serem inseridos
+Cria um novo nó para a árvore AVL que aponta para o registro fornecido.
+Parâmetro: registro - ponteiro para o registro a ser indexado
 Retorno: ponteiro para o novo nó criado
 */
-ItemAVL* novo_no(ItemAVL novo){
-    ItemAVL *no = (ItemAVL*)malloc(sizeof(ItemAVL));
+ItemAVL* novo_no(Registro *registro){
+    ItemAVL *no = (ItemAVL*)alocar_memoria(MEMORIA_AVL, sizeof(ItemAVL));
     if(!no){
         printf("Erro ao alocar memoria\n");
         exit(EXIT_FAILURE);
     }
 
-    *no = novo;
+    no->id = registro->id;
+    no->registro = registro;
     no->esq = NULL;
     no->dir = NULL;
     no->altura = 1;
@@ -110,19 +112,21 @@ ItemAVL* novo_no(ItemAVL novo){
 }
 
 /*
-Insere um novo elemento na árvore AVL.
+Insere um novo elemento na árvore AVL. O nó guarda apenas o ID e o ponteiro para o registro,
+que pertence ao armazém de registros.
 Parâmetros:
     raiz - ponteiro para a raiz da árvore
-    novo - estrutura com os dados a serem inseridos
+    registro - ponteiro para o registro a ser indexado
 Retorno: ponteiro para a nova raiz da árvore
 */
-ItemAVL* inserir_avl(ItemAVL *raiz, ItemAVL novo){
-    if(raiz == NULL) return novo_no(novo);
+ItemAVL* inserir_avl(ItemAVL *raiz, Registro *registro){
+    if(raiz == NULL) return novo_no(registro);
 
-    if(novo.id < raiz->id){
-        raiz->esq = inserir_avl(raiz->esq, novo);
-    }else if(novo.id > raiz->id){
-        raiz->dir = inserir_avl(raiz->dir, novo);
+    int id = registro->id;
+    if(id < raiz->id){
+        raiz->esq = inserir_avl(raiz->esq, registro);
+    }else if(id > raiz->id){
+        raiz->dir = inserir_avl(raiz->dir, registro);
     }else{
         return raiz;
     }
@@ -130,17 +134,17 @@ ItemAVL* inserir_avl(ItemAVL *raiz, ItemAVL novo){
     raiz->altura = 1 + maximo(altura(raiz->esq), altura(raiz->dir));
     int balanceamento = fator_balanceamento(raiz);
 
-    if(balanceamento > 1 && novo.id < raiz->esq->id){
+    if(balanceamento > 1 && id < raiz->esq->id){
         return rotacao_direita(raiz);
     }
-    if(balanceamento < -1 && novo.id > raiz->dir->id){
+    if(balanceamento < -1 && id > raiz->dir->id){
         return rotacao_esquerda(raiz);
     }
-    if(balanceamento > 1 && novo.id > raiz->esq->id){
+    if(balanceamento > 1 && id > raiz->esq->id){
         raiz->esq = rotacao_esquerda(raiz->esq);
         return rotacao_direita(raiz);
     }
-    if(balanceamento < -1 && novo.id < raiz->dir->id){
+    if(balanceamento < -1 && id < raiz->dir->id){
         raiz->dir = rotacao_direita(raiz->dir);
         return rotacao_esquerda(raiz);
     }
@@ -148,6 +152,71 @@ ItemAVL* inserir_avl(ItemAVL *raiz, ItemAVL novo){
     return raiz;
 }
 
+/*
+Constrói uma árvore perfeitamente balanceada a partir de um vetor de registros em ordem
+estritamente crescente de ID, em tempo linear: o registro do meio vira a raiz e as duas
+metades viram as subárvores. Como as alturas das subárvores diferem no máximo em 1, a
+árvore resultante já satisfaz a propriedade AVL, sem nenhuma rotação.
+Parâmetros:
+    itens - vetor de registros ordenado por ID
+    n - número de registros
+Retorno: ponteiro para a raiz da árvore construída (NULL se n == 0)
+*/
+ItemAVL* construir_avl(Registro *itens, int n){
+    if(n <= 0) return NULL;
+
+    int meio = n / 2;
+    ItemAVL *raiz = novo_no(&itens[meio]);
+    raiz->esq = construir_avl(itens, meio);
+    raiz->dir = construir_avl(itens + meio + 1, n - meio - 1);
+    raiz->altura = 1 + maximo(altura(raiz->esq), altura(raiz->dir));
+
+    return raiz;
+}
+
+/*
+Constrói uma árvore perfeitamente balanceada a partir de um vetor de ponteiros para registros,
+em ordem estritamente crescente de ID, da mesma forma que construir_avl.
+*/
+static ItemAVL* construir_ponteiros_avl(Registro **registros, int n){
+    if(n <= 0) return NULL;
+
+    int meio = n / 2;
+    ItemAVL *raiz = novo_no(registros[meio]);
+    raiz->esq = construir_ponteiros_avl(registros, meio);
+    raiz->dir = construir_ponteiros_avl(registros + meio + 1, n - meio - 1);
+    raiz->altura = 1 + maximo(altura(raiz->esq), altura(raiz->dir));
+
+    return raiz;
+}
+
+/*
+Insere um lote de registros na árvore. Se a árvore está vazia e o lote está em ordem
+estritamente crescente de ID, a árvore é construída em tempo linear, sem rotações; caso
+contrário os registros são inseridos um a um.
+Parâmetros:
+    raiz - ponteiro para o ponteiro da raiz da árvore
+    registros - vetor de ponteiros para os registros do lote
+    n - número de registros do lote
+*/
+void inserir_lote_avl(ItemAVL **raiz, Registro **registros, int n){
+    int ordenado = *raiz == NULL;
+    int i = 1;
+    for(i; i < n && ordenado; i++){
+        if(registros[i]->id <= registros[i - 1]->id){
+            ordenado = 0;
+        }
+    }
+    if(ordenado){
+        *raiz = construir_ponteiros_avl(registros, n);
+        return;
+    }
+
+    for(i = 0; i < n; i++){
+        *raiz = inserir_avl(*raiz, registros[i]);
+    }
+}
+
 /*
 Encontra o nó de menor valor em uma subárvore AVL.
 Parâmetro: no - ponteiro para o nó raiz da subárvore
@@ -188,18 +257,11 @@ ItemAVL* remover_avl(ItemAVL* raiz, int id){
                 raiz = NULL;
             }else
                 *raiz = *temp;
-            free(temp);
+            liberar_memoria(MEMORIA_AVL, temp);
         }else{
             ItemAVL* temp = min_valor_no(raiz->dir);
             raiz->id = temp->id;
-            raiz->ano = temp->ano;
-            strcpy(raiz->estado, temp->estado);
-            strcpy(raiz->cultura, temp->cultura);
-            raiz->preco_ton = temp->preco_ton;
-            raiz->rendimento = temp->rendimento;
-            raiz->producao = temp->producao;
-            raiz->area_plantada = temp->area_plantada;
-            raiz->valor_total = temp->valor_total;
+            raiz->registro = temp->registro;
             raiz->dir = remover_avl(raiz->dir, temp->id);
         }
     }
@@ -256,7 +318,7 @@ void liberar_avl(ItemAVL *raiz){
     }
     liberar_avl(raiz->esq);
     liberar_avl(raiz->dir);
-    free(raiz);
+    liberar_memoria(MEMORIA_AVL, raiz);
 }
 
 /*
@@ -269,80 +331,47 @@ void imprimir_avl(ItemAVL *raiz){
     }
 
     imprimir_avl(raiz->esq);
+    const Registro *r = raiz->registro;
     printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-        raiz->id, raiz->ano, raiz->estado, raiz->cultura, raiz->preco_ton,
-        raiz->rendimento, raiz->producao, raiz->area_plantada, raiz->valor_total);
+        r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+        r->rendimento, r->producao, r->area_plantada, r->valor_total);
     imprimir_avl(raiz->dir);
 }
 
 /*
-Carrega dados de um arquivo e insere na árvore AVL.
+Carrega dados de um arquivo e insere na árvore AVL. Os registros passam a pertencer ao armazém.
 Parâmetros:
     raiz - ponteiro para o ponteiro da raiz da árvore
+    armazem - ponteiro para o armazém que recebe os registros
     nome_arquivo - nome do arquivo de entrada (dataset)
 */
-void carregar_dados_avl(ItemAVL **raiz, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    while(fgets(linha, sizeof(linha), arquivo)){
-        ItemAVL novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        *raiz = inserir_avl(*raiz, novo);
-    }
-    fclose(arquivo);
+void carregar_dados_avl(ItemAVL **raiz, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_avl(raiz, &ds);
+    adotar_dataset_armazem(armazem, &ds);
 }
 
 /*
-Salva todos os elementos da árvore AVL em um arquivo (dataset). Usada internamente
-para gravar os dados com o arquivo ja aberto.
+Indexa na árvore AVL todos os registros de um dataset já carregado em memória. O vetor do
+dataset deve permanecer alocado (normalmente transferido para o armazém de registros).
+Se a árvore está vazia e o dataset está ordenado por ID (o caso do arquivo de dados), a árvore
+é construída diretamente em tempo linear; caso contrário os registros são inseridos um a um.
 Parâmetros:
-    raiz - ponteiro para a raiz da árvore
-    nome_arquivo - nome do arquivo de saída
+    raiz - ponteiro para o ponteiro da raiz da árvore
+    ds - ponteiro para o dataset com os registros
 */
-void salvar_aux_avl(ItemAVL *no, FILE *arquivo){
-    if(no == NULL){
+void carregar_registros_avl(ItemAVL **raiz, Dataset *ds){
+    if(*raiz == NULL && dataset_ordenado(ds)){
+        *raiz = construir_avl(ds->itens, ds->total);
         return;
     }
 
-    salvar_aux_avl(no->esq, arquivo);
-
-    fprintf(arquivo, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n",
-        no->id, no->ano, no->estado, no->cultura, no->preco_ton,
-        no->rendimento, no->producao, no->area_plantada, no->valor_total);
-
-    salvar_aux_avl(no->dir, arquivo);
-}
-
-/*
-Salva todos os elementos da árvore AVL em um arquivo (dataset). Abre e fecha o arquivo
-utilizando a função auxiliar para gravar os dados.
-Parâmetros:
-    raiz - ponteiro para a raiz da árvore
-    nome_arquivo - nome do arquivo de saída (dataset)
-*/
-void salvar_dados_avl(ItemAVL *raiz, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "w");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
+    int i = 0;
+    for(i; i < ds->total; i++){
+        *raiz = inserir_avl(*raiz, &ds->itens[i]);
     }
-
-    fprintf(arquivo, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
-    salvar_aux_avl(raiz, arquivo);
-    fclose(arquivo);
 }
 
 /*
@@ -364,63 +393,32 @@ void busca_maior_id_avl(ItemAVL *no, int *maior){
 }
 
 /*
-Retorna o próximo ID disponível na árvore AVL.
+Retorna o próximo ID disponível na árvore AVL. Como a árvore é ordenada por ID,
+o maior ID está no nó mais à direita.
 Parâmetro: raiz - ponteiro para a raiz da árvore
 Retorno: inteiro representando o próximo ID
 */
 int proximo_id_avl(ItemAVL *raiz){
     int maior = 0;
-    busca_maior_id_avl(raiz, &maior);
+    ItemAVL *atual = raiz;
+    while(atual != NULL){
+        maior = atual->id;
+        atual = atual->dir;
+    }
     return maior + 1;
 }
 
 /*
 Cria uma nova amostra a partir da entrada do usuário e insere na árvore AVL.
-Parâmetro: raiz - ponteiro para o ponteiro da raiz da árvore
+Parâmetros:
+    raiz - ponteiro para o ponteiro da raiz da árvore
+    armazem - ponteiro para o armazém que recebe o novo registro
 */
-void criar_amostra_avl(ItemAVL **raiz){
-    ItemAVL novo;
-    char entrada[50];
-    novo.id = proximo_id_avl(*raiz);
-
-    printf("\n===Insira os dados da nova amostra===\n");
-
-    printf("Ano: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%d", &novo.ano);
-
-    printf("Estado: ");
-    fgets(novo.estado, sizeof(novo.estado), stdin);
-    novo.estado[strcspn(novo.estado, "\n")] = '\0';
-
-    printf("Cultura: ");
-    fgets(novo.cultura, sizeof(novo.cultura), stdin);
-    novo.cultura[strcspn(novo.cultura, "\n")] = '\0';
-
-    printf("Preco por tonelada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.preco_ton);
-
-    printf("Rendimento: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.rendimento);
-
-    printf("Producao: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.producao);
+void criar_amostra_avl(ItemAVL **raiz, ArmazemRegistros *armazem){
+    Registro novo;
+    ler_registro_usuario(&novo, proximo_id_avl(*raiz));
 
-    printf("Area plantada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.area_plantada);
-
-    printf("Valor total: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.valor_total);
-    
-    novo.esq = NULL;
-    novo.dir = NULL;
-    novo.altura = 1;
-    *raiz = inserir_avl(*raiz, novo);
+    *raiz = inserir_avl(*raiz, adicionar_armazem(armazem, &novo));
     printf("\nAmostra inserida com sucesso\n");
 }
 
@@ -430,22 +428,22 @@ internamente para comparar os parâmetros da busca com as amostras.
 Parâmetros:
   cabeca - ponteiro para a cabeça da lista
   ano_min, ano_max - intervalo de anos
-  cultura - filtro de cultura (string)
-  estado - filtro de estado (string)
+  estado - filtro de estado (filtro_dicionario)
+  cultura - filtro de cultura (filtro_dicionario)
+  encontrados - ponteiro para o contador de resultados
 */
-void buscar_filtros_aux_avl(ItemAVL *no, int ano_min, int ano_max, const char *estado, const char *cultura, int *encontrados){
+void buscar_filtros_aux_avl(ItemAVL *no, int ano_min, int ano_max, int estado, int cultura, int *encontrados){
     if(no == NULL){
         return;
     }
 
-    int ano_certo = (no->ano >= ano_min) && (no->ano <= ano_max);
-    int estado_certo = (estado == NULL || strlen(estado) == 0 || strcasecmp(no->estado, estado) == 0);
-    int cultura_certa = (cultura == NULL || strlen(cultura) == 0 || strcasecmp(no->cultura, cultura) == 0);
+    const Registro *r = no->registro;
+    int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
+    int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, estado);
+    int cultura_certa = ACEITA_FILTRO(dicionario_culturas, r->cultura, cultura);
 
     if(ano_certo && estado_certo && cultura_certa){
-        printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-            no->id, no->ano, no->estado, no->cultura, no->preco_ton,
-            no->rendimento, no->producao, no->area_plantada, no->valor_total);
+        imprimir_registro(r);
         (*encontrados)++;
     }
     buscar_filtros_aux_avl(no->esq, ano_min, ano_max, estado, cultura, encontrados);
@@ -454,19 +452,24 @@ void buscar_filtros_aux_avl(ItemAVL *no, int ano_min, int ano_max, const char *e
 
 /*
 Busca e imprime elementos que atendem aos filtros de ano, estado e cultura. Utiliza a 
-função auxiliar para dar um panorama geral da busca.
+função auxiliar para dar um panorama geral da busca, ou o índice de bitmaps quando houver.
 Parâmetros:
-  cabeca - ponteiro para a cabeça da lista
+  raiz - ponteiro para a raiz da árvore
   ano_min, ano_max - intervalo de anos
   cultura - filtro de cultura (string)
   estado - filtro de estado (string)
+  indice - índice de bitmaps sobre os mesmos registros, ou NULL para percorrer a árvore
 */
-void buscar_filtros_avl(ItemAVL *raiz, int ano_min, int ano_max, const char *estado, const char *cultura){
+void buscar_filtros_avl(ItemAVL *raiz, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice){
     int encontrados = 0;
 
     printf("\n===RESULTADOS DA BUSCA===\n");
 
-    buscar_filtros_aux_avl(raiz, ano_min, ano_max, estado, cultura, &encontrados);
+    if(indice != NULL){
+        encontrados = imprimir_filtro_indice_bitmap(indice, ano_min, ano_max, estado, cultura, imprimir_registro);
+    }else{
+        buscar_filtros_aux_avl(raiz, ano_min, ano_max, filtro_dicionario(&dicionario_estados, estado), filtro_dicionario(&dicionario_culturas, cultura), &encontrados);
+    }
     if(encontrados==0){
         printf("Nenhum resultado encontrado.\n");
     }else{
@@ -474,174 +477,6 @@ void buscar_filtros_avl(ItemAVL *raiz, int ano_min, int ano_max, const char *est
     }
 }
 
-/*
-Mede o tempo de inserção de n elementos na árvore AVL a partir de um arquivo.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_insercao_avl(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemAVL *raiz = NULL;
-    int total = 0;
-    
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemAVL novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        raiz = inserir_avl(raiz, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    
-    liberar_avl(raiz);
-    fclose(arquivo);
-    return tempo;
-}
-
-/*
-Função auxiliar utilizada para coletar todos os IDs presentes na estrutura
-Parâmetros:
-    no - ponteiro para o nó atual da árvore AVL
-    ids - vetor de inteiros onde os IDs serão armazenados
-    total - ponteiro para o contador de IDs já coletados (atualizado pela função)
-    limite - número máximo de IDs a serem coletados
-*/ 
-void coletar_ids_avl(ItemAVL *no, int *ids, int *total, int limite){
-    if(no == NULL || *total >= limite){
-        return;
-    }
-
-    ids[*total] = no->id;
-    (*total)++;
-
-    coletar_ids_avl(no->esq, ids, total, limite);
-    coletar_ids_avl(no->dir, ids, total, limite);
-}
-
-/*
-Mede o tempo de remoção de n elementos da árvore AVL.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (daataset)
-    n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_remocao_avl(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    ItemAVL *raiz = NULL;
-    carregar_dados_avl(&raiz, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Erro ao alocar memoria para ids\n");
-        liberar_avl(raiz);
-        return -1;
-    }
-
-    int total_ids = 0;
-    coletar_ids_avl(raiz, ids, &total_ids, n);
-
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int k = 0;
-    for(k; k < total_ids; k++){
-        raiz = remover_avl(raiz, ids[k]);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    liberar_avl(raiz);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos na árvore AVL.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de buscas a serem realizadas
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_busca_avl(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    ItemAVL *raiz = NULL;
-    carregar_dados_avl(&raiz, nome_arquivo);
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Erro ao alocar memoria para ids\n");
-        liberar_avl(raiz);
-        return -1;
-    }
-
-    int total_ids = 0;
-    coletar_ids_avl(raiz, ids, &total_ids, n);
-
-    if(total_ids == 0){
-        printf("Nenhum id encontrado\n");
-        free(ids);
-        liberar_avl(raiz);
-        return 0;
-    }
-
-    srand((unsigned int)time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int k = 0;
-    int num_buscas = n < total_ids ? n : total_ids;
-    for(k; k < num_buscas; k++){
-        buscar_avl(raiz, ids[k]);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    liberar_avl(raiz);
-
-    return tempo;
-}
-
 /*
 Percorre recursivamente a árvore AVL e conta o número total de nós.
 Parâmetros:
@@ -659,299 +494,25 @@ void conta_nos(ItemAVL *no, int *cont){
 }
 
 /*
-Calcula o uso de memória da árvore AVL após inserir n elementos.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de elementos a serem considerados
-Retorno: memória utilizada (bytes)
-*/
-size_t bench_uso_memoria_avl(const char *nome_arquivo, int n){
-    ItemAVL *raiz = NULL;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-    int total = 0;
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemAVL novo;
-
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        raiz = inserir_avl(raiz, novo);
-        total++;
-    }
-
-    fclose(arquivo);
-
-    int cont = 0;
-    conta_nos(raiz, &cont);
-    size_t uso_memoria = cont * sizeof(ItemAVL);
-
-    liberar_avl(raiz);
-    return uso_memoria;
-}
-
-/*
-Mede o tempo de inserção com memória restrita na árvore AVL.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    lim_memoria_mb - limite de memória em MB
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_mem_restrita_avl(const char *nome_arquivo, double lim_memoria_mb){
-    struct timespec inicio, fim;
-    size_t lim_bytes = (size_t)(lim_memoria_mb * 1024 * 1024);
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemAVL *raiz = NULL;
-    size_t memoria_usada = 0;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo)){
-        if(memoria_usada + sizeof(ItemAVL) > lim_bytes){
-            printf("\nLimite de memoria atingido apos %d elementos\n", total);
-            break;
-        }
-
-        ItemAVL novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        raiz = inserir_avl(raiz, novo);
-        memoria_usada += sizeof(ItemAVL);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    fclose(arquivo);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    liberar_avl(raiz);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de inserção de n elementos na árvore AVL com delay entre inserções.
+Busca um ID descendo no máximo lim níveis da árvore.
 Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de elementos a serem inseridos
-    delay_ms - tempo de delay em milissegundos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_com_delay_avl(const char *nome_arquivo, int n, int delay_ms){
-    struct timespec inicio, fim;
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemAVL *raiz = NULL;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemAVL novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        raiz = inserir_avl(raiz, novo);
-
-        Sleep(delay_ms);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    fclose(arquivo);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    liberar_avl(raiz);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos na árvore AVL com latência simulada.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de buscas a serem realizadas
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_latencia_avl(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemAVL *raiz = NULL;
-    carregar_dados_avl(&raiz, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Erro ao alocar memoria para ids\n");
-        liberar_avl(raiz);
-        return -1;
-    }
-
-    int coletados = 0;
-
-    coletar_ids_avl(raiz, ids, &coletados, n);
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int i = 0;
-    for(i; i < n; i++){
-        int indice = rand() % coletados;
-        int id_buscado = ids[indice];
-        buscar_avl(raiz, id_buscado);
-
-        int delay = 2 + rand() % 8;
-        Sleep(delay);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    free(ids);
-    liberar_avl(raiz);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    return tempo;
-}
-
-/*
-Mede o tempo de inserção de n elementos na árvore AVL com perda simulada de dados.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
+    raiz - ponteiro para a raiz da árvore AVL
+    id - identificador a ser buscado
+    lim - número máximo de nós visitados
+Retorno: ponteiro para o nó encontrado ou NULL se o limite acabar antes
 */
-double bench_tempo_insercao_perda_avl(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemAVL *raiz = NULL;
-    int total = 0;
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        if((rand() % 100) < 20){
-            continue;
+ItemAVL* buscar_lim_acessos_avl(ItemAVL *raiz, int id, int lim){
+    int acessos = 0;
+    while(raiz != NULL && acessos < lim){
+        if(raiz->id == id){
+            return raiz;
         }
-
-        ItemAVL novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.esq = NULL;
-        novo.dir = NULL;
-        novo.altura = 1;
-        raiz = inserir_avl(raiz, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    fclose(arquivo);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    liberar_avl(raiz);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos na árvore AVL com limite de acessos.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada (dataset)
-    n - número de buscas a serem realizadas
-    lim - limite de acessos por busca
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_lim_acessos_avl(const char *nome_arquivo, int n, int lim){
-    struct timespec inicio, fim;
-
-    ItemAVL *raiz = NULL;
-    carregar_dados_avl(&raiz, nome_arquivo);
-
-    int maior_id = 0;
-    busca_maior_id_avl(raiz, &maior_id);
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int i = 0;
-    for(i; i < n; i++){
-        int id_buscado = rand() % maior_id + 1;
-
-        ItemAVL *atual = raiz;
-        int acessos = 0;
-        while(atual != NULL && acessos < lim){
-            if(atual->id == id_buscado){
-                break;
-            }
-            if(id_buscado < atual->id){
-                atual = atual->esq;
-            }else{
-                atual = atual->dir;
-            }
-            acessos++;
+        if(id < raiz->id){
+            raiz = raiz->esq;
+        }else{
+            raiz = raiz->dir;
         }
+        acessos++;
     }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    liberar_avl(raiz);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    return tempo;
+    return NULL;
 }
@@ -2,17 +2,13 @@
 #define ARVORE_AVL_H
 
 #include <stdio.h>
+#include "dataset.h"
+#include "registros.h"
+#include "indice_bitmap.h"
 
 typedef struct ItemAVL {
     int id;
-    int ano;
-    char estado[10];
-    char cultura[50];
-    float preco_ton;
-    float rendimento;
-    float producao;
-    float area_plantada;
-    float valor_total;
+    Registro *registro;
     struct ItemAVL *esq;
     struct ItemAVL *dir;
     int altura;
@@ -23,33 +19,24 @@ int maximo(int a, int b);
 ItemAVL* rotacao_direita(ItemAVL *y);
 ItemAVL* rotacao_esquerda(ItemAVL *x);
 int fator_balanceamento(ItemAVL *no);
-ItemAVL* novo_no(ItemAVL novo);
+ItemAVL* novo_no(Registro *registro);
 
-ItemAVL* inserir_avl(ItemAVL *raiz, ItemAVL novo);
+ItemAVL* inserir_avl(ItemAVL *raiz, Registro *registro);
+ItemAVL* construir_avl(Registro *itens, int n);
+void inserir_lote_avl(ItemAVL **raiz, Registro **registros, int n);
 ItemAVL* min_valor_no(ItemAVL* no);
 ItemAVL* remover_avl(ItemAVL *raiz, int id);
 ItemAVL* buscar_avl(ItemAVL *raiz, int id);
 void liberar_avl(ItemAVL *raiz);
 void imprimir_avl(ItemAVL *raiz);
-void carregar_dados_avl(ItemAVL **raiz, const char *nome_arquivo);
-void salvar_aux_avl(ItemAVL *no, FILE *arquivo);
-void salvar_dados_avl(ItemAVL *raiz, const char *nome_arquivo);
+void carregar_dados_avl(ItemAVL **raiz, ArmazemRegistros *armazem, const char *nome_arquivo);
+void carregar_registros_avl(ItemAVL **raiz, Dataset *ds);
 void busca_maior_id_avl(ItemAVL *no, int *maior);
-void criar_amostra_avl(ItemAVL **raiz);
+void criar_amostra_avl(ItemAVL **raiz, ArmazemRegistros *armazem);
 int proximo_id_avl(ItemAVL *raiz);
-void buscar_filtros_aux_avl(ItemAVL *no, int ano_min, int ano_max, const char *estado, const char *cultura, int *encontrados);
-void buscar_filtros_avl(ItemAVL *raiz, int ano_min, int ano_max, const char *estado, const char *cultura);
+void buscar_filtros_aux_avl(ItemAVL *no, int ano_min, int ano_max, int estado, int cultura, int *encontrados);
+void buscar_filtros_avl(ItemAVL *raiz, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice);
 
-double bench_tempo_insercao_avl(const char *nome_arquivo, int n);
-void coleta_ids(ItemAVL *no, int *ids, int n, int *coletados);
-double bench_tempo_remocao_avl(const char *nome_arquivo, int n);
-double bench_tempo_busca_avl(const char *nome_arquivo, int n);
-size_t bench_uso_memoria_avl(const char *nome_arquivo, int n);
-double bench_insercao_mem_restrita_avl(const char *nome_arquivo, double lim_memoria_mb);
-double bench_insercao_com_delay_avl(const char *nome_arquivo, int n, int delay_ms);
-void coleta_ids(ItemAVL *no, int *ids, int n, int *coletados);
-double bench_busca_latencia_avl(const char *nome_arquivo, int n);
-double bench_tempo_insercao_perda_avl(const char *nome_arquivo, int n);
-double bench_busca_lim_acessos_avl(const char *nome_arquivo, int n, int lim);
+ItemAVL* buscar_lim_acessos_avl(ItemAVL *raiz, int id, int lim);
 
 #endif
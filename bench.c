@@ -0,0 +1,892 @@
+/*
+->bench.c
+Implementação do modo benchmark comum a todas as estruturas indexadas por ID.
+Cada estrutura é descrita por uma entrada da tabela estruturas_bench, com ponteiros para as
+suas operações (iniciar, inserir, carregar em lote, buscar, buscar com limite de acessos,
+remover e liberar) e com a categoria de memória em que os seus nós são contados. Os nove cenários
+são escritos uma única vez e executados da mesma forma para todas as entradas, de modo que
+incluir uma nova estrutura no benchmark exige apenas uma entrada na tabela.
+Os registros são lidos do arquivo e guardados no armazém antes de iniciar o relógio, então os
+tempos medem apenas as operações da estrutura. Cada cenário é repetido após execuções de
+aquecimento, com sementes fixas, e resumido por mediana, percentis e desvio padrão. Os resultados
+são acumulados em um relatório que pode ser salvo em CSV ou JSON.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <windows.h>
+#include "bench.h"
+#include "registros.h"
+#include "lista_encadeada.h"
+#include "lista_ordenada.h"
+#include "arvore_avl.h"
+#include "hash.h"
+#include "hash_aberto.h"
+#include "skiplist.h"
+#include "memoria.h"
+
+static const char *nomes_cenarios_bench[TOTAL_CENARIOS_BENCH + 1] = {
+    "", "insercao", "remocao", "busca", "uso_memoria", "insercao_mem_restrita",
+    "insercao_delay", "busca_latencia", "insercao_perda", "busca_lim_acessos"
+};
+
+static const char *titulos_cenarios_bench[TOTAL_CENARIOS_BENCH + 1] = {
+    "", "Tempo de insercao", "Tempo de remocao", "Tempo de busca por ID", "Uso de memoria",
+    "Tempo de insercao com memoria restrita", "Tempo de insercao com delay",
+    "Tempo de busca com latencia", "Tempo de insercao com perda",
+    "Tempo de busca com limite de acessos"
+};
+
+/*
+Aloca memória para o benchmark, encerrando o programa em caso de falha.
+Parâmetro: tamanho - número de bytes
+Retorno: ponteiro para a memória alocada
+*/
+static void* alocar_bench(size_t tamanho){
+    void *p = alocar_memoria(MEMORIA_GERAL, tamanho > 0 ? tamanho : 1);
+    if(!p){
+        printf("Erro ao alocar memoria para o benchmark\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+/* Lista encadeada: a estrutura é o ponteiro para a cabeça. */
+static void* iniciar_LE_bench(void){
+    ItemListaEncadeada **cabeca = alocar_bench(sizeof(ItemListaEncadeada*));
+    *cabeca = NULL;
+    return cabeca;
+}
+
+static void inserir_LE_bench(void *estrutura, Registro *registro){
+    inserir_LE((ItemListaEncadeada**)estrutura, registro);
+}
+
+static Registro* buscar_LE_bench(void *estrutura, int id){
+    ItemListaEncadeada *item = buscar_LE(*(ItemListaEncadeada**)estrutura, id);
+    return item != NULL ? item->registro : NULL;
+}
+
+static Registro* buscar_lim_acessos_LE_bench(void *estrutura, int id, int lim){
+    ItemListaEncadeada *item = buscar_lim_acessos_LE(*(ItemListaEncadeada**)estrutura, id, lim);
+    return item != NULL ? item->registro : NULL;
+}
+
+static void remover_LE_bench(void *estrutura, int id){
+    remover_LE((ItemListaEncadeada**)estrutura, id);
+}
+
+static void liberar_LE_bench(void *estrutura){
+    libera_LE(*(ItemListaEncadeada**)estrutura);
+    liberar_memoria(MEMORIA_GERAL, estrutura);
+}
+
+/* Lista ordenada: a estrutura é o ponteiro para a cabeça; a carga usa a inserção em lote. */
+static void* iniciar_LO_bench(void){
+    ItemLista **cabeca = alocar_bench(sizeof(ItemLista*));
+    *cabeca = NULL;
+    return cabeca;
+}
+
+static void inserir_LO_bench(void *estrutura, Registro *registro){
+    insereOrdenadoID_LO((ItemLista**)estrutura, registro);
+}
+
+static void carregar_LO_bench(void *estrutura, Registro **registros, int n){
+    inserir_lote_LO((ItemLista**)estrutura, registros, n);
+}
+
+static Registro* buscar_LO_bench(void *estrutura, int id){
+    ItemLista *item = buscarId_LO(*(ItemLista**)estrutura, id);
+    return item != NULL ? item->registro : NULL;
+}
+
+static Registro* buscar_lim_acessos_LO_bench(void *estrutura, int id, int lim){
+    ItemLista *item = buscar_lim_acessos_LO(*(ItemLista**)estrutura, id, lim);
+    return item != NULL ? item->registro : NULL;
+}
+
+static void remover_LO_bench(void *estrutura, int id){
+    remover_LO((ItemLista**)estrutura, id);
+}
+
+static void liberar_LO_bench(void *estrutura){
+    libera_LO(*(ItemLista**)estrutura);
+    liberar_memoria(MEMORIA_GERAL, estrutura);
+}
+
+/* Árvore AVL: a estrutura é o ponteiro para a raiz; a carga constrói a árvore balanceada. */
+static void* iniciar_avl_bench(void){
+    ItemAVL **raiz = alocar_bench(sizeof(ItemAVL*));
+    *raiz = NULL;
+    return raiz;
+}
+
+static void inserir_avl_bench(void *estrutura, Registro *registro){
+    ItemAVL **raiz = estrutura;
+    *raiz = inserir_avl(*raiz, registro);
+}
+
+static void carregar_avl_bench(void *estrutura, Registro **registros, int n){
+    inserir_lote_avl((ItemAVL**)estrutura, registros, n);
+}
+
+static Registro* buscar_avl_bench(void *estrutura, int id){
+    ItemAVL *no = buscar_avl(*(ItemAVL**)estrutura, id);
+    return no != NULL ? no->registro : NULL;
+}
+
+static Registro* buscar_lim_acessos_avl_bench(void *estrutura, int id, int lim){
+    ItemAVL *no = buscar_lim_acessos_avl(*(ItemAVL**)estrutura, id, lim);
+    return no != NULL ? no->registro : NULL;
+}
+
+static void remover_avl_bench(void *estrutura, int id){
+    ItemAVL **raiz = estrutura;
+    *raiz = remover_avl(*raiz, id);
+}
+
+static void liberar_avl_bench(void *estrutura){
+    liberar_avl(*(ItemAVL**)estrutura);
+    liberar_memoria(MEMORIA_GERAL, estrutura);
+}
+
+/* Tabela hash com encadeamento. */
+static void* iniciar_hash_bench(void){
+    TabelaHash *tabela = alocar_bench(sizeof(TabelaHash));
+    iniciar_hash(tabela);
+    return tabela;
+}
+
+static void inserir_hash_bench(void *estrutura, Registro *registro){
+    inserir_tabela_hash(estrutura, registro);
+}
+
+static Registro* buscar_hash_bench(void *estrutura, int id){
+    ItemHash *item = buscar_tabela_hash(estrutura, id);
+    return item != NULL ? item->registro : NULL;
+}
+
+static Registro* buscar_lim_acessos_hash_bench(void *estrutura, int id, int lim){
+    ItemHash *item = buscar_lim_acessos_hash(estrutura, id, lim);
+    return item != NULL ? item->registro : NULL;
+}
+
+static void remover_hash_bench(void *estrutura, int id){
+    remover_tabela_hash(estrutura, id);
+}
+
+static void liberar_hash_bench(void *estrutura){
+    liberar_tabela_hash(estrutura);
+    liberar_memoria(MEMORIA_GERAL, estrutura);
+}
+
+/* Tabela hash com endereçamento aberto. */
+static void* iniciar_hash_aberto_bench(void){
+    TabelaHashAberta *tabela = alocar_bench(sizeof(TabelaHashAberta));
+    iniciar_hash_aberto(tabela);
+    return tabela;
+}
+
+static void inserir_hash_aberto_bench(void *estrutura, Registro *registro){
+    inserir_hash_aberto(estrutura, registro);
+}
+
+static Registro* buscar_hash_aberto_bench(void *estrutura, int id){
+    return buscar_hash_aberto(estrutura, id);
+}
+
+static Registro* buscar_lim_acessos_hash_aberto_bench(void *estrutura, int id, int lim){
+    return buscar_lim_acessos_hash_aberto(estrutura, id, lim);
+}
+
+static void remover_hash_aberto_bench(void *estrutura, int id){
+    remover_hash_aberto(estrutura, id);
+}
+
+static void liberar_hash_aberto_bench(void *estrutura){
+    liberar_hash_aberto(estrutura);
+    liberar_memoria(MEMORIA_GERAL, estrutura);
+}
+
+/* Skiplist. */
+static void* iniciar_skiplist_bench(void){
+    return iniciar_skiplist();
+}
+
+static void inserir_skiplist_bench(void *estrutura, Registro *registro){
+    inserir_skiplist(estrutura, registro);
+}
+
+static Registro* buscar_skiplist_bench(void *estrutura, int id){
+    ElementoSkiplist *elemento = buscar_skiplist(estrutura, id);
+    return elemento != NULL ? elemento->registro : NULL;
+}
+
+static Registro* buscar_lim_acessos_skiplist_bench(void *estrutura, int id, int lim){
+    ElementoSkiplist *elemento = buscar_lim_acessos_skiplist(estrutura, id, lim);
+    return elemento != NULL ? elemento->registro : NULL;
+}
+
+static void remover_skiplist_bench(void *estrutura, int id){
+    remover_skiplist(estrutura, id);
+}
+
+static void liberar_skiplist_bench(void *estrutura){
+    libera_skiplist(estrutura);
+}
+
+/*
+Estruturas avaliadas pelo modo benchmark, na ordem em que aparecem nos resultados.
+O campo carregar é opcional: quando NULL a carga inicial e o cenário de inserção inserem os
+registros um a um.
+O campo categoria é a categoria do contador de memória em que a estrutura aloca os seus nós.
+*/
+const OperacoesEstrutura estruturas_bench[] = {
+    {"Lista Encadeada", iniciar_LE_bench, inserir_LE_bench, NULL, buscar_LE_bench,
+        buscar_lim_acessos_LE_bench, remover_LE_bench, liberar_LE_bench, MEMORIA_LISTA_ENCADEADA},
+    {"Lista Ordenada", iniciar_LO_bench, inserir_LO_bench, carregar_LO_bench, buscar_LO_bench,
+        buscar_lim_acessos_LO_bench, remover_LO_bench, liberar_LO_bench, MEMORIA_LISTA_ORDENADA},
+    {"Arvore AVL", iniciar_avl_bench, inserir_avl_bench, carregar_avl_bench, buscar_avl_bench,
+        buscar_lim_acessos_avl_bench, remover_avl_bench, liberar_avl_bench, MEMORIA_AVL},
+    {"Hash", iniciar_hash_bench, inserir_hash_bench, NULL, buscar_hash_bench,
+        buscar_lim_acessos_hash_bench, remover_hash_bench, liberar_hash_bench, MEMORIA_HASH},
+    {"Hash aberto", iniciar_hash_aberto_bench, inserir_hash_aberto_bench, NULL, buscar_hash_aberto_bench,
+        buscar_lim_acessos_hash_aberto_bench, remover_hash_aberto_bench, liberar_hash_aberto_bench, MEMORIA_HASH_ABERTO},
+    {"Skiplist", iniciar_skiplist_bench, inserir_skiplist_bench, NULL, buscar_skiplist_bench,
+        buscar_lim_acessos_skiplist_bench, remover_skiplist_bench, liberar_skiplist_bench, MEMORIA_SKIPLIST},
+};
+
+const int total_estruturas_bench = sizeof(estruturas_bench) / sizeof(estruturas_bench[0]);
+
+/*
+Retorna o identificador de um cenário, usado nos arquivos de resultados.
+Parâmetro: cenario - número do cenário (CENARIO_*)
+Retorno: nome do cenário ou "desconhecido"
+*/
+const char* nome_cenario_bench(int cenario){
+    if(cenario < 1 || cenario > TOTAL_CENARIOS_BENCH){
+        return "desconhecido";
+    }
+    return nomes_cenarios_bench[cenario];
+}
+
+/*
+Retorna a unidade do valor medido em um cenário.
+Parâmetro: cenario - número do cenário (CENARIO_*)
+Retorno: "bytes" para o uso de memória, "segundos" para os demais
+*/
+const char* unidade_cenario_bench(int cenario){
+    return cenario == CENARIO_USO_MEMORIA ? "bytes" : "segundos";
+}
+
+/*
+Calcula o tempo entre duas marcações do relógio.
+Parâmetros:
+    inicio - marcação inicial
+    fim - marcação final
+Retorno: tempo em segundos
+*/
+static double tempo_bench(struct timespec inicio, struct timespec fim){
+    return (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+}
+
+/*
+Sorteia um inteiro em [0, limite). Combina duas chamadas de rand() porque RAND_MAX pode ser
+apenas 32767, o que deixaria a maior parte dos IDs de um arquivo grande fora do sorteio.
+Parâmetro: limite - limite superior (exclusivo)
+Retorno: inteiro sorteado
+*/
+static int sortear_bench(int limite){
+    unsigned int valor = ((unsigned int)rand() << 15) ^ (unsigned int)rand();
+    return (int)(valor % (unsigned int)limite);
+}
+
+/*
+Lê até n registros do arquivo para o armazém e guarda os ponteiros em um vetor.
+Parâmetros:
+    armazem - armazém que recebe os registros
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    n - número máximo de registros (0 ou negativo para ler o arquivo inteiro)
+    registros - recebe o vetor de ponteiros, que deve ser liberado pelo chamador
+Retorno: número de registros lidos
+*/
+static int ler_registros_bench(ArmazemRegistros *armazem, const char *nome_arquivo, int n, Registro ***registros){
+    LeitorCSV leitor;
+    Registro r;
+    int capacidade = n > 0 ? n : 1024;
+    int total = 0;
+    Registro **vetor = alocar_bench(capacidade * sizeof(Registro*));
+
+    abrir_leitor_csv(&leitor, nome_arquivo);
+    while((n <= 0 || total < n) && proximo_registro_csv(&leitor, &r)){
+        if(total == capacidade){
+            capacidade *= 2;
+            Registro **novo = realocar_memoria(MEMORIA_GERAL, vetor, capacidade * sizeof(Registro*));
+            if(!novo){
+                printf("Erro ao alocar memoria para o benchmark\n");
+                exit(EXIT_FAILURE);
+            }
+            vetor = novo;
+        }
+        vetor[total] = adicionar_armazem(armazem, &r);
+        total++;
+    }
+    fechar_leitor_csv(&leitor);
+
+    *registros = vetor;
+    return total;
+}
+
+/*
+Copia os n primeiros ponteiros do vetor, para as cargas em lote que podem reordenar o lote
+(inserir_lote_LO) não alterarem a ordem vista pelas execuções seguintes.
+*/
+static Registro** copiar_registros_bench(Registro **registros, int n){
+    Registro **copia = alocar_bench(n * sizeof(Registro*));
+    memcpy(copia, registros, n * sizeof(Registro*));
+    return copia;
+}
+
+/*
+Insere todos os registros na estrutura fora da medição, usando a carga em lote quando a
+estrutura oferece uma.
+Parâmetros:
+    ops - operações da estrutura
+    estrutura - estrutura que recebe os registros
+    registros - vetor de ponteiros para os registros
+    n - número de registros
+*/
+static void preencher_bench(const OperacoesEstrutura *ops, void *estrutura, Registro **registros, int n){
+    if(ops->carregar != NULL){
+        Registro **lote = copiar_registros_bench(registros, n);
+        ops->carregar(estrutura, lote, n);
+        liberar_memoria(MEMORIA_GERAL, lote);
+        return;
+    }
+    int i = 0;
+    for(i; i < n; i++){
+        ops->inserir(estrutura, registros[i]);
+    }
+}
+
+/*
+Executa uma vez um cenário de benchmark sobre uma estrutura nova.
+Cenários de inserção usam os n primeiros registros do vetor; no cenário de inserção sem delay,
+as estruturas com carga em lote (construção da AVL, inserção em lote da lista ordenada) são
+medidas por ela. Cenários de busca e remoção inserem o vetor inteiro antes de medir e sorteiam
+os IDs entre os carregados.
+Parâmetros:
+    ops - operações da estrutura avaliada
+    cenario - número do cenário (CENARIO_*)
+    registros - registros já lidos do arquivo
+    total - número de registros do vetor
+    n - número de amostras (operações) do cenário
+    parametro - limite de memória em MB, delay em ms ou limite de acessos, conforme o cenário
+    semente - semente dos sorteios, inclusive dos níveis da skiplist
+    latencias - histograma que recebe a duração de cada busca, medida individualmente
+        (NULL para medir apenas o tempo total)
+    operacoes - recebe o número de operações efetivamente realizadas (pode ser NULL)
+Retorno: tempo em segundos, ou bytes no cenário de uso de memória (bytes vivos que a categoria
+    da estrutura ganhou no contador de memória, com cabeçalhos e arredondamentos do heap)
+*/
+double executar_cenario_bench(const OperacoesEstrutura *ops, int cenario, Registro **registros, int total, int n, double parametro, unsigned int semente, Histograma *latencias, int *operacoes){
+    struct timespec inicio, fim;
+    int insercao = cenario == CENARIO_INSERCAO || cenario == CENARIO_USO_MEMORIA
+        || cenario == CENARIO_INSERCAO_DELAY || cenario == CENARIO_INSERCAO_PERDA;
+    double valor = 0;
+    int feitas = 0;
+    int i = 0;
+
+    if(insercao && n < total){
+        total = n;
+    }
+    if(operacoes != NULL){
+        *operacoes = 0;
+    }
+    if(total <= 0){
+        return 0;
+    }
+
+    srand(semente);
+    semear_aleatorio_skiplist(semente);
+    long long memoria_inicial = memoria_viva(ops->categoria);
+    void *estrutura = ops->iniciar();
+
+    if(cenario != CENARIO_MEM_RESTRITA && !insercao){
+        preencher_bench(ops, estrutura, registros, total);
+    }
+
+    if(cenario == CENARIO_INSERCAO && ops->carregar != NULL){
+        Registro **lote = copiar_registros_bench(registros, total);
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        ops->carregar(estrutura, lote, total);
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+        feitas = total;
+        liberar_memoria(MEMORIA_GERAL, lote);
+    }else if(cenario == CENARIO_INSERCAO || cenario == CENARIO_INSERCAO_DELAY){
+        int delay = (int)parametro;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        for(i; i < total; i++){
+            ops->inserir(estrutura, registros[i]);
+            if(cenario == CENARIO_INSERCAO_DELAY){
+                Sleep(delay);
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+        feitas = total;
+    }else if(cenario == CENARIO_INSERCAO_PERDA){
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        for(i; i < total; i++){
+            if((rand() % 100) < PERDA_PERCENTUAL_BENCH){
+                continue;
+            }
+            ops->inserir(estrutura, registros[i]);
+            feitas++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+    }else if(cenario == CENARIO_USO_MEMORIA){
+        preencher_bench(ops, estrutura, registros, total);
+        valor = (double)(memoria_viva(ops->categoria) - memoria_inicial);
+        feitas = total;
+    }else if(cenario == CENARIO_MEM_RESTRITA){
+        /* O contador da categoria é lido a cada inserção: ele já inclui o tamanho real de cada
+        bloco no heap e custa uma leitura, então o limite é respeitado sem parar o relógio. */
+        long long lim_bytes = (long long)(parametro * 1024 * 1024);
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        while(feitas < total){
+            long long usada = memoria_viva(ops->categoria) - memoria_inicial + (long long)feitas * (long long)sizeof(Registro);
+            if(usada >= lim_bytes){
+                break;
+            }
+            ops->inserir(estrutura, registros[feitas]);
+            feitas++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+    }else if(cenario == CENARIO_REMOCAO){
+        int *ids = alocar_bench(total * sizeof(int));
+        for(i = 0; i < total; i++){
+            ids[i] = registros[i]->id;
+        }
+        for(i = total - 1; i > 0; i--){
+            int j = sortear_bench(i + 1);
+            int tmp = ids[i];
+            ids[i] = ids[j];
+            ids[j] = tmp;
+        }
+        feitas = n < total ? n : total;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        for(i = 0; i < feitas; i++){
+            ops->remover(estrutura, ids[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+        liberar_memoria(MEMORIA_GERAL, ids);
+    }else{
+        int lim = (int)parametro;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        for(i; i < n; i++){
+            int id_buscado = registros[sortear_bench(total)]->id;
+            unsigned long long marca = latencias != NULL ? marcar_relogio_histograma() : 0;
+            if(cenario == CENARIO_BUSCA_LIM_ACESSOS){
+                ops->buscar_lim_acessos(estrutura, id_buscado, lim);
+            }else{
+                ops->buscar(estrutura, id_buscado);
+            }
+            if(latencias != NULL){
+                registrar_histograma(latencias, nanossegundos_histograma(marca, marcar_relogio_histograma()));
+            }
+            if(cenario == CENARIO_BUSCA_LATENCIA){
+                Sleep(2 + rand() % 8);
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        valor = tempo_bench(inicio, fim);
+        feitas = n;
+    }
+
+    ops->liberar(estrutura);
+
+    if(operacoes != NULL){
+        *operacoes = feitas;
+    }
+    return valor;
+}
+
+/*
+Preenche a configuração padrão das execuções: AQUECIMENTO_PADRAO_BENCH execuções de
+aquecimento, REPETICOES_PADRAO_BENCH repetições medidas, a semente SEMENTE_PADRAO_BENCH e a
+medição individual de cada busca ligada.
+Parâmetro: configuracao - ponteiro para a configuração
+*/
+void iniciar_configuracao_bench(ConfiguracaoBench *configuracao){
+    configuracao->aquecimento = AQUECIMENTO_PADRAO_BENCH;
+    configuracao->repeticoes = REPETICOES_PADRAO_BENCH;
+    configuracao->semente = SEMENTE_PADRAO_BENCH;
+    configuracao->latencias = 1;
+}
+
+static int comparar_valores_bench(const void *a, const void *b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+Calcula o percentil p de um vetor ordenado, interpolando entre os dois vizinhos.
+Parâmetros:
+    valores - vetor ordenado
+    n - número de valores (maior que zero)
+    p - percentil entre 0 e 1
+Retorno: valor do percentil
+*/
+static double percentil_bench(const double *valores, int n, double p){
+    double posicao = p * (n - 1);
+    int abaixo = (int)posicao;
+    if(abaixo + 1 >= n){
+        return valores[n - 1];
+    }
+    double fracao = posicao - abaixo;
+    return valores[abaixo] + (valores[abaixo + 1] - valores[abaixo]) * fracao;
+}
+
+/*
+Resume as medições de um cenário. Valores fora das cercas de Tukey (quartis afastados de
+FATOR_IQR_BENCH vezes a distância interquartil) são descartados antes de calcular a mediana,
+a média, o desvio padrão e os percentis 95 e 99; com menos de 4 medições nada é descartado.
+Parâmetros:
+    valores - medições (o vetor é ordenado pela função)
+    n - número de medições
+    estatistica - recebe o resumo
+*/
+void calcular_estatistica_bench(double *valores, int n, EstatisticaBench *estatistica){
+    memset(estatistica, 0, sizeof(EstatisticaBench));
+    if(n <= 0){
+        return;
+    }
+
+    qsort(valores, n, sizeof(double), comparar_valores_bench);
+
+    int primeiro = 0;
+    int ultimo = n - 1;
+    if(n >= 4){
+        double q1 = percentil_bench(valores, n, 0.25);
+        double q3 = percentil_bench(valores, n, 0.75);
+        double cerca_baixa = q1 - FATOR_IQR_BENCH * (q3 - q1);
+        double cerca_alta = q3 + FATOR_IQR_BENCH * (q3 - q1);
+        while(valores[primeiro] < cerca_baixa){
+            primeiro++;
+        }
+        while(valores[ultimo] > cerca_alta){
+            ultimo--;
+        }
+    }
+
+    const double *validos = &valores[primeiro];
+    int k = ultimo - primeiro + 1;
+    double soma = 0;
+    double soma_quadrados = 0;
+    int i = 0;
+    for(i; i < k; i++){
+        soma += validos[i];
+    }
+    estatistica->media = soma / k;
+    for(i = 0; i < k; i++){
+        soma_quadrados += (validos[i] - estatistica->media) * (validos[i] - estatistica->media);
+    }
+
+    estatistica->desvio = k > 1 ? sqrt(soma_quadrados / (k - 1)) : 0;
+    estatistica->mediana = percentil_bench(validos, k, 0.5);
+    estatistica->p95 = percentil_bench(validos, k, 0.95);
+    estatistica->p99 = percentil_bench(validos, k, 0.99);
+    estatistica->minimo = validos[0];
+    estatistica->maximo = validos[k - 1];
+    estatistica->validas = k;
+    estatistica->descartadas = n - k;
+}
+
+/*
+Mede repetidamente uma operação avulsa do benchmark (opções de vazão e de tempo que não
+passam pela tabela de estruturas) e exibe o resumo no mesmo formato de executar_bench: a
+medição passa por configuracao->aquecimento execuções descartadas e configuracao->repeticoes
+execuções medidas, e a repetição i recebe a semente configuracao->semente + i.
+Parâmetros:
+    configuracao - aquecimento, repetições e semente
+    titulo - descrição exibida antes do resumo
+    unidade - unidade da medição ("s", "MB/s", "buscas/s", ...)
+    medir - função que executa a operação uma vez e retorna a medição
+    contexto - parâmetros repassados a medir
+    estatistica - recebe o resumo (pode ser NULL)
+*/
+void medir_repetido_bench(const ConfiguracaoBench *configuracao, const char *titulo, const char *unidade, MedicaoBench medir, void *contexto, EstatisticaBench *estatistica){
+    int repeticoes = configuracao->repeticoes > 0 ? configuracao->repeticoes : 1;
+    double *valores = alocar_bench(repeticoes * sizeof(double));
+    EstatisticaBench resumo;
+
+    int j = 0;
+    for(j; j < configuracao->aquecimento; j++){
+        medir(contexto, configuracao->semente + j);
+    }
+    for(j = 0; j < repeticoes; j++){
+        valores[j] = medir(contexto, configuracao->semente + j);
+    }
+    calcular_estatistica_bench(valores, repeticoes, &resumo);
+
+    if(strcmp(unidade, "s") == 0){
+        printf("%s: mediana %.8f s | p95 %.8f | p99 %.8f | desvio %.8f | %d/%d repeticoes validas\n",
+            titulo, resumo.mediana, resumo.p95, resumo.p99, resumo.desvio, resumo.validas, repeticoes);
+    }else{
+        printf("%s: mediana %.2f %s | p95 %.2f | p99 %.2f | desvio %.2f | %d/%d repeticoes validas\n",
+            titulo, resumo.mediana, unidade, resumo.p95, resumo.p99, resumo.desvio, resumo.validas, repeticoes);
+    }
+    if(estatistica != NULL){
+        *estatistica = resumo;
+    }
+    liberar_memoria(MEMORIA_GERAL, valores);
+}
+
+/*
+Inicializa um relatório vazio.
+Parâmetro: relatorio - ponteiro para o relatório
+*/
+void iniciar_relatorio_bench(RelatorioBench *relatorio){
+    relatorio->resultados = NULL;
+    relatorio->total = 0;
+    relatorio->capacidade = 0;
+}
+
+/*
+Acrescenta um resultado ao relatório.
+Parâmetros:
+    relatorio - ponteiro para o relatório
+    resultado - resultado a ser copiado
+*/
+static void adicionar_relatorio_bench(RelatorioBench *relatorio, const ResultadoBench *resultado){
+    if(relatorio->total == relatorio->capacidade){
+        int nova = relatorio->capacidade > 0 ? relatorio->capacidade * 2 : 16;
+        ResultadoBench *novo = realocar_memoria(MEMORIA_GERAL, relatorio->resultados, nova * sizeof(ResultadoBench));
+        if(!novo){
+            printf("Erro ao alocar memoria para o relatorio\n");
+            exit(EXIT_FAILURE);
+        }
+        relatorio->resultados = novo;
+        relatorio->capacidade = nova;
+    }
+    relatorio->resultados[relatorio->total] = *resultado;
+    relatorio->total++;
+}
+
+/*
+Executa um cenário em todas as estruturas da tabela, exibe os resultados e os acrescenta
+ao relatório. O arquivo é lido uma única vez; cada estrutura passa por
+configuracao->aquecimento execuções descartadas e configuracao->repeticoes execuções medidas,
+e a repetição i usa a semente configuracao->semente + i, de modo que duas execuções com a
+mesma configuração sorteiam exatamente os mesmos IDs.
+Nos cenários de busca, se configuracao->latencias estiver ligado, cada busca das repetições
+medidas é cronometrada isoladamente e registrada em um histograma por estrutura, exibido após
+o resumo e guardado no relatório. O tempo total passa então a incluir a leitura do relógio.
+Parâmetros:
+    relatorio - relatório que acumula os resultados (pode ser NULL)
+    configuracao - aquecimento, repetições e semente
+    cenario - número do cenário (CENARIO_*)
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    n - número de amostras
+    parametro - parâmetro do cenário (ver executar_cenario_bench)
+*/
+void executar_bench(RelatorioBench *relatorio, const ConfiguracaoBench *configuracao, int cenario, const char *nome_arquivo, int n, double parametro){
+    int insercao = cenario == CENARIO_INSERCAO || cenario == CENARIO_USO_MEMORIA
+        || cenario == CENARIO_INSERCAO_DELAY || cenario == CENARIO_INSERCAO_PERDA;
+    int busca = cenario == CENARIO_BUSCA || cenario == CENARIO_BUSCA_LATENCIA
+        || cenario == CENARIO_BUSCA_LIM_ACESSOS;
+    ArmazemRegistros armazem;
+    Registro **registros = NULL;
+    iniciar_armazem(&armazem);
+    int total = ler_registros_bench(&armazem, nome_arquivo, insercao ? n : 0, &registros);
+    if(total == 0){
+        printf("Nenhum registro carregado!\n");
+        liberar_armazem(&armazem);
+        liberar_memoria(MEMORIA_GERAL, registros);
+        return;
+    }
+
+    int repeticoes = configuracao->repeticoes > 0 ? configuracao->repeticoes : 1;
+    double *valores = alocar_bench(repeticoes * sizeof(double));
+    int medir_latencias = busca && configuracao->latencias;
+    if(medir_latencias){
+        calibrar_relogio_histograma();
+    }
+
+    int i = 0;
+    for(i; i < total_estruturas_bench; i++){
+        const OperacoesEstrutura *ops = &estruturas_bench[i];
+        ResultadoBench resultado;
+        resultado.estrutura = ops->nome;
+        resultado.cenario = cenario;
+        resultado.amostras = n;
+        resultado.parametro = parametro;
+        resultado.aquecimento = configuracao->aquecimento;
+        resultado.repeticoes = repeticoes;
+        resultado.semente = configuracao->semente;
+        resultado.latencias = NULL;
+        if(medir_latencias){
+            resultado.latencias = alocar_bench(sizeof(Histograma));
+            iniciar_histograma(resultado.latencias);
+        }
+
+        int j = 0;
+        for(j; j < configuracao->aquecimento; j++){
+            executar_cenario_bench(ops, cenario, registros, total, n, parametro, configuracao->semente + j, NULL, NULL);
+        }
+        for(j = 0; j < repeticoes; j++){
+            valores[j] = executar_cenario_bench(ops, cenario, registros, total, n, parametro, configuracao->semente + j, resultado.latencias, &resultado.operacoes);
+        }
+        calcular_estatistica_bench(valores, repeticoes, &resultado.estatistica);
+
+        const EstatisticaBench *e = &resultado.estatistica;
+        if(cenario == CENARIO_USO_MEMORIA){
+            printf("%s (%s): mediana %.0f bytes | p95 %.0f | p99 %.0f | desvio %.0f | %d/%d repeticoes validas",
+                titulos_cenarios_bench[cenario], ops->nome, e->mediana, e->p95, e->p99, e->desvio, e->validas, repeticoes);
+        }else{
+            printf("%s (%s): mediana %.8f s | p95 %.8f | p99 %.8f | desvio %.8f | %d/%d repeticoes validas",
+                titulos_cenarios_bench[cenario], ops->nome, e->mediana, e->p95, e->p99, e->desvio, e->validas, repeticoes);
+        }
+        if(cenario == CENARIO_MEM_RESTRITA || cenario == CENARIO_INSERCAO_PERDA){
+            printf(" | %d insercoes", resultado.operacoes);
+        }
+        printf("\n");
+        if(resultado.latencias != NULL){
+            imprimir_histograma(resultado.latencias, "  Latencia por busca");
+        }
+
+        if(relatorio != NULL){
+            adicionar_relatorio_bench(relatorio, &resultado);
+        }else{
+            liberar_memoria(MEMORIA_GERAL, resultado.latencias);
+        }
+    }
+
+    liberar_memoria(MEMORIA_GERAL, valores);
+    liberar_memoria(MEMORIA_GERAL, registros);
+    liberar_armazem(&armazem);
+}
+
+/*
+Salva os resultados do relatório em CSV, uma linha por estrutura e cenário.
+Parâmetros:
+    relatorio - ponteiro para o relatório
+    nome_arquivo - nome do arquivo de saída
+*/
+void salvar_csv_bench(const RelatorioBench *relatorio, const char *nome_arquivo){
+    FILE *arquivo = fopen(nome_arquivo, "w");
+    if(!arquivo){
+        printf("Erro ao criar o arquivo %s\n", nome_arquivo);
+        return;
+    }
+
+    fprintf(arquivo, "estrutura,cenario,amostras,parametro,operacoes,aquecimento,repeticoes,descartadas,semente,mediana,media,desvio,p95,p99,minimo,maximo,unidade\n");
+    int i = 0;
+    for(i; i < relatorio->total; i++){
+        const ResultadoBench *r = &relatorio->resultados[i];
+        const EstatisticaBench *e = &r->estatistica;
+        fprintf(arquivo, "%s,%s,%d,%g,%d,%d,%d,%d,%u,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%s\n",
+            r->estrutura, nome_cenario_bench(r->cenario), r->amostras, r->parametro, r->operacoes,
+            r->aquecimento, r->repeticoes, e->descartadas, r->semente, e->mediana, e->media, e->desvio,
+            e->p95, e->p99, e->minimo, e->maximo, unidade_cenario_bench(r->cenario));
+    }
+    fclose(arquivo);
+}
+
+/*
+Salva os resultados do relatório em JSON, como um vetor de objetos com os mesmos campos
+do CSV.
+Parâmetros:
+    relatorio - ponteiro para o relatório
+    nome_arquivo - nome do arquivo de saída
+*/
+void salvar_json_bench(const RelatorioBench *relatorio, const char *nome_arquivo){
+    FILE *arquivo = fopen(nome_arquivo, "w");
+    if(!arquivo){
+        printf("Erro ao criar o arquivo %s\n", nome_arquivo);
+        return;
+    }
+
+    fprintf(arquivo, "[\n");
+    int i = 0;
+    for(i; i < relatorio->total; i++){
+        const ResultadoBench *r = &relatorio->resultados[i];
+        const EstatisticaBench *e = &r->estatistica;
+        fprintf(arquivo, "  {\"estrutura\": \"%s\", \"cenario\": \"%s\", \"amostras\": %d, \"parametro\": %g, \"operacoes\": %d, "
+            "\"aquecimento\": %d, \"repeticoes\": %d, \"descartadas\": %d, \"semente\": %u, "
+            "\"mediana\": %.9f, \"media\": %.9f, \"desvio\": %.9f, \"p95\": %.9f, \"p99\": %.9f, \"minimo\": %.9f, \"maximo\": %.9f, "
+            "\"unidade\": \"%s\"",
+            r->estrutura, nome_cenario_bench(r->cenario), r->amostras, r->parametro, r->operacoes,
+            r->aquecimento, r->repeticoes, e->descartadas, r->semente,
+            e->mediana, e->media, e->desvio, e->p95, e->p99, e->minimo, e->maximo,
+            unidade_cenario_bench(r->cenario));
+        if(r->latencias != NULL){
+            const Histograma *h = r->latencias;
+            fprintf(arquivo, ", \"latencia_ns\": {\"medicoes\": %llu, \"minimo\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"maximo\": %llu, \"media\": %.3f}",
+                h->total, h->minimo, percentil_histograma(h, 50), percentil_histograma(h, 90),
+                percentil_histograma(h, 99), percentil_histograma(h, 99.9), h->maximo, media_histograma(h));
+        }
+        fprintf(arquivo, "}%s\n", i + 1 < relatorio->total ? "," : "");
+    }
+    fprintf(arquivo, "]\n");
+    fclose(arquivo);
+}
+
+/*
+Salva os histogramas de latência do relatório em CSV, um bloco de baldes por estrutura e
+cenário de busca (ver escrever_csv_histograma).
+Parâmetros:
+    relatorio - ponteiro para o relatório
+    nome_arquivo - nome do arquivo de saída
+Retorno: número de histogramas salvos (o arquivo só é criado se houver algum)
+*/
+int salvar_latencias_bench(const RelatorioBench *relatorio, const char *nome_arquivo){
+    int salvos = 0;
+    int i = 0;
+    for(i; i < relatorio->total; i++){
+        if(relatorio->resultados[i].latencias != NULL){
+            salvos++;
+        }
+    }
+    if(salvos == 0){
+        return 0;
+    }
+
+    FILE *arquivo = fopen(nome_arquivo, "w");
+    if(!arquivo){
+        printf("Erro ao criar o arquivo %s\n", nome_arquivo);
+        return 0;
+    }
+    fprintf(arquivo, "estrutura,cenario,limite_inferior_ns,limite_superior_ns,contagem,percentual_acumulado\n");
+    for(i = 0; i < relatorio->total; i++){
+        const ResultadoBench *r = &relatorio->resultados[i];
+        if(r->latencias != NULL){
+            escrever_csv_histograma(r->latencias, arquivo, r->estrutura, nome_cenario_bench(r->cenario));
+        }
+    }
+    fclose(arquivo);
+    return salvos;
+}
+
+/*
+Libera os resultados acumulados no relatório.
+Parâmetro: relatorio - ponteiro para o relatório
+*/
+void liberar_relatorio_bench(RelatorioBench *relatorio){
+    int i = 0;
+    for(i; i < relatorio->total; i++){
+        liberar_memoria(MEMORIA_GERAL, relatorio->resultados[i].latencias);
+    }
+    liberar_memoria(MEMORIA_GERAL, relatorio->resultados);
+    iniciar_relatorio_bench(relatorio);
+}
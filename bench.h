@@ -0,0 +1,94 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include "dataset.h"
+#include "histograma.h"
+
+#define CENARIO_INSERCAO 1
+#define CENARIO_REMOCAO 2
+#define CENARIO_BUSCA 3
+#define CENARIO_USO_MEMORIA 4
+#define CENARIO_MEM_RESTRITA 5
+#define CENARIO_INSERCAO_DELAY 6
+#define CENARIO_BUSCA_LATENCIA 7
+#define CENARIO_INSERCAO_PERDA 8
+#define CENARIO_BUSCA_LIM_ACESSOS 9
+#define TOTAL_CENARIOS_BENCH 9
+
+#define PERDA_PERCENTUAL_BENCH 20
+
+#define AQUECIMENTO_PADRAO_BENCH 1
+#define REPETICOES_PADRAO_BENCH 5
+#define SEMENTE_PADRAO_BENCH 12345u
+#define FATOR_IQR_BENCH 1.5
+
+typedef struct{
+    const char *nome;
+    void* (*iniciar)(void);
+    void (*inserir)(void *estrutura, Registro *registro);
+    void (*carregar)(void *estrutura, Registro **registros, int n);
+    Registro* (*buscar)(void *estrutura, int id);
+    Registro* (*buscar_lim_acessos)(void *estrutura, int id, int lim);
+    void (*remover)(void *estrutura, int id);
+    void (*liberar)(void *estrutura);
+    int categoria;
+} OperacoesEstrutura;
+
+typedef struct{
+    int aquecimento;
+    int repeticoes;
+    unsigned int semente;
+    int latencias;
+} ConfiguracaoBench;
+
+typedef struct{
+    double mediana;
+    double media;
+    double desvio;
+    double p95;
+    double p99;
+    double minimo;
+    double maximo;
+    int validas;
+    int descartadas;
+} EstatisticaBench;
+
+typedef struct{
+    const char *estrutura;
+    int cenario;
+    int amostras;
+    double parametro;
+    int operacoes;
+    int aquecimento;
+    int repeticoes;
+    unsigned int semente;
+    EstatisticaBench estatistica;
+    Histograma *latencias;
+} ResultadoBench;
+
+typedef struct{
+    ResultadoBench *resultados;
+    int total;
+    int capacidade;
+} RelatorioBench;
+
+typedef double (*MedicaoBench)(void *contexto, unsigned int semente);
+
+extern const OperacoesEstrutura estruturas_bench[];
+extern const int total_estruturas_bench;
+
+const char* nome_cenario_bench(int cenario);
+const char* unidade_cenario_bench(int cenario);
+double executar_cenario_bench(const OperacoesEstrutura *ops, int cenario, Registro **registros, int total, int n, double parametro, unsigned int semente, Histograma *latencias, int *operacoes);
+void iniciar_configuracao_bench(ConfiguracaoBench *configuracao);
+void calcular_estatistica_bench(double *valores, int n, EstatisticaBench *estatistica);
+void medir_repetido_bench(const ConfiguracaoBench *configuracao, const char *titulo, const char *unidade, MedicaoBench medir, void *contexto, EstatisticaBench *estatistica);
+void iniciar_relatorio_bench(RelatorioBench *relatorio);
+void executar_bench(RelatorioBench *relatorio, const ConfiguracaoBench *configuracao, int cenario, const char *nome_arquivo, int n, double parametro);
+void salvar_csv_bench(const RelatorioBench *relatorio, const char *nome_arquivo);
+void salvar_json_bench(const RelatorioBench *relatorio, const char *nome_arquivo);
+int salvar_latencias_bench(const RelatorioBench *relatorio, const char *nome_arquivo);
+void liberar_relatorio_bench(RelatorioBench *relatorio);
+
+#endif
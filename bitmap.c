@@ -0,0 +1,560 @@
+/*
+->bitmap.c
+Implementação de um bitmap compactado no estilo "roaring" para conjuntos de posições.
+Os valores (inteiros de 32 bits) são divididos pelos seus 16 bits mais altos em containers,
+mantidos em ordem crescente de chave. Cada container guarda os 16 bits mais baixos de até
+65536 valores de uma de duas formas:
+    - vetor ordenado de unsigned short, enquanto tiver até LIMITE_ARRAY_BITMAP valores;
+    - mapa de 65536 bits (1024 palavras de 64 bits) quando ficar mais denso que isso.
+Interseções e uniões são feitas container a container; entre dois mapas de bits, palavra a
+palavra com contagem de bits (popcount).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitmap.h"
+#include "memoria.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CONTAR_BITS(x) ((int)__popcnt64(x))
+static int primeiro_bit(unsigned long long x){
+    unsigned long indice;
+    _BitScanForward64(&indice, x);
+    return (int)indice;
+}
+#else
+#define CONTAR_BITS(x) __builtin_popcountll(x)
+#define primeiro_bit(x) __builtin_ctzll(x)
+#endif
+
+/*
+Aloca memória ou encerra o programa em caso de falha.
+*/
+static void* alocar_bitmap(size_t tamanho){
+    void *p = alocar_memoria(MEMORIA_BITMAP, tamanho > 0 ? tamanho : 1);
+    if(!p){
+        printf("Erro ao alocar memoria para o bitmap\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+/*
+Inicializa um bitmap vazio.
+Parâmetro: bitmap - ponteiro para o bitmap
+*/
+void iniciar_bitmap(Bitmap *bitmap){
+    bitmap->containers = NULL;
+    bitmap->total = 0;
+    bitmap->capacidade = 0;
+}
+
+/*
+Libera a memória de um container.
+*/
+static void liberar_container(ContainerBitmap *c){
+    liberar_memoria(MEMORIA_BITMAP, c->valores);
+    liberar_memoria(MEMORIA_BITMAP, c->bits);
+    c->valores = NULL;
+    c->bits = NULL;
+}
+
+/*
+Libera a memória do bitmap, deixando-o vazio.
+Parâmetro: bitmap - ponteiro para o bitmap
+*/
+void liberar_bitmap(Bitmap *bitmap){
+    int i = 0;
+    for(i; i < bitmap->total; i++){
+        liberar_container(&bitmap->containers[i]);
+    }
+    liberar_memoria(MEMORIA_BITMAP, bitmap->containers);
+    iniciar_bitmap(bitmap);
+}
+
+/*
+Procura o container de uma chave (busca binária).
+Parâmetros:
+    bitmap - ponteiro para o bitmap
+    chave - 16 bits mais altos do valor
+    posicao - recebe a posição do container, ou onde ele deveria ser inserido
+Retorno: 1 se o container existe, 0 caso contrário
+*/
+static int buscar_container(const Bitmap *bitmap, unsigned short chave, int *posicao){
+    int inicio = 0;
+    int fim = bitmap->total;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if(bitmap->containers[meio].chave < chave){
+            inicio = meio + 1;
+        }else{
+            fim = meio;
+        }
+    }
+    *posicao = inicio;
+    return inicio < bitmap->total && bitmap->containers[inicio].chave == chave;
+}
+
+/*
+Reserva no fim do bitmap um novo container vazio (usado pelas operações que produzem os
+containers já em ordem crescente de chave).
+Retorno: ponteiro para o container criado
+*/
+static ContainerBitmap* acrescentar_container(Bitmap *bitmap, unsigned short chave){
+    if(bitmap->total == bitmap->capacidade){
+        int nova_capacidade = bitmap->capacidade == 0 ? 4 : bitmap->capacidade * 2;
+        ContainerBitmap *containers = (ContainerBitmap*)realocar_memoria(MEMORIA_BITMAP, bitmap->containers, nova_capacidade * sizeof(ContainerBitmap));
+        if(!containers){
+            printf("Erro ao alocar memoria para o bitmap\n");
+            exit(EXIT_FAILURE);
+        }
+        bitmap->containers = containers;
+        bitmap->capacidade = nova_capacidade;
+    }
+    ContainerBitmap *c = &bitmap->containers[bitmap->total];
+    c->chave = chave;
+    c->eh_bits = 0;
+    c->cardinalidade = 0;
+    c->capacidade = 0;
+    c->valores = NULL;
+    c->bits = NULL;
+    bitmap->total++;
+    return c;
+}
+
+/*
+Converte um container de vetor para mapa de bits.
+*/
+static void converter_para_bits(ContainerBitmap *c){
+    unsigned long long *bits = (unsigned long long*)alocar_zerada_memoria(MEMORIA_BITMAP, PALAVRAS_CONTAINER_BITMAP, sizeof(unsigned long long));
+    if(!bits){
+        printf("Erro ao alocar memoria para o bitmap\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0;
+    for(i; i < c->cardinalidade; i++){
+        bits[c->valores[i] >> 6] |= 1ULL << (c->valores[i] & 63);
+    }
+    liberar_memoria(MEMORIA_BITMAP, c->valores);
+    c->valores = NULL;
+    c->capacidade = 0;
+    c->bits = bits;
+    c->eh_bits = 1;
+}
+
+/*
+Converte um container de mapa de bits para vetor ordenado.
+*/
+static void converter_para_vetor(ContainerBitmap *c){
+    unsigned short *valores = (unsigned short*)alocar_bitmap(c->cardinalidade * sizeof(unsigned short));
+    int n = 0;
+    int i = 0;
+    for(i; i < PALAVRAS_CONTAINER_BITMAP; i++){
+        unsigned long long palavra = c->bits[i];
+        while(palavra != 0){
+            valores[n++] = (unsigned short)(i * 64 + primeiro_bit(palavra));
+            palavra &= palavra - 1;
+        }
+    }
+    liberar_memoria(MEMORIA_BITMAP, c->bits);
+    c->bits = NULL;
+    c->valores = valores;
+    c->capacidade = c->cardinalidade;
+    c->eh_bits = 0;
+}
+
+/*
+Procura um valor baixo no vetor de um container (busca binária).
+Retorno: posição do valor, ou onde ele deveria ser inserido
+*/
+static int posicao_valor(const ContainerBitmap *c, unsigned short valor){
+    int inicio = 0;
+    int fim = c->cardinalidade;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if(c->valores[meio] < valor){
+            inicio = meio + 1;
+        }else{
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/*
+Acrescenta um valor ao bitmap.
+Parâmetros:
+    bitmap - ponteiro para o bitmap
+    valor - valor a ser acrescentado
+*/
+void adicionar_bitmap(Bitmap *bitmap, unsigned int valor){
+    unsigned short chave = (unsigned short)(valor >> 16);
+    unsigned short baixo = (unsigned short)(valor & 0xFFFF);
+    int posicao;
+
+    if(!buscar_container(bitmap, chave, &posicao)){
+        acrescentar_container(bitmap, chave);
+        ContainerBitmap novo = bitmap->containers[bitmap->total - 1];
+        memmove(&bitmap->containers[posicao + 1], &bitmap->containers[posicao], (bitmap->total - 1 - posicao) * sizeof(ContainerBitmap));
+        bitmap->containers[posicao] = novo;
+    }
+
+    ContainerBitmap *c = &bitmap->containers[posicao];
+    if(c->eh_bits){
+        unsigned long long mascara = 1ULL << (baixo & 63);
+        if(!(c->bits[baixo >> 6] & mascara)){
+            c->bits[baixo >> 6] |= mascara;
+            c->cardinalidade++;
+        }
+        return;
+    }
+
+    int i = posicao_valor(c, baixo);
+    if(i < c->cardinalidade && c->valores[i] == baixo){
+        return;
+    }
+    if(c->cardinalidade >= LIMITE_ARRAY_BITMAP){
+        converter_para_bits(c);
+        c->bits[baixo >> 6] |= 1ULL << (baixo & 63);
+        c->cardinalidade++;
+        return;
+    }
+    if(c->cardinalidade == c->capacidade){
+        int nova_capacidade = c->capacidade == 0 ? 4 : c->capacidade * 2;
+        unsigned short *valores = (unsigned short*)realocar_memoria(MEMORIA_BITMAP, c->valores, nova_capacidade * sizeof(unsigned short));
+        if(!valores){
+            printf("Erro ao alocar memoria para o bitmap\n");
+            exit(EXIT_FAILURE);
+        }
+        c->valores = valores;
+        c->capacidade = nova_capacidade;
+    }
+    memmove(&c->valores[i + 1], &c->valores[i], (c->cardinalidade - i) * sizeof(unsigned short));
+    c->valores[i] = baixo;
+    c->cardinalidade++;
+}
+
+/*
+Retira um valor do bitmap. Um mapa de bits que volta a ter até LIMITE_ARRAY_BITMAP valores é
+convertido de volta para vetor, e um container vazio é descartado.
+Parâmetros:
+    bitmap - ponteiro para o bitmap
+    valor - valor a ser retirado
+Retorno: 1 se o valor estava no bitmap, 0 caso contrário
+*/
+int remover_bitmap(Bitmap *bitmap, unsigned int valor){
+    unsigned short chave = (unsigned short)(valor >> 16);
+    unsigned short baixo = (unsigned short)(valor & 0xFFFF);
+    int posicao;
+
+    if(!buscar_container(bitmap, chave, &posicao)){
+        return 0;
+    }
+
+    ContainerBitmap *c = &bitmap->containers[posicao];
+    if(c->eh_bits){
+        unsigned long long mascara = 1ULL << (baixo & 63);
+        if(!(c->bits[baixo >> 6] & mascara)){
+            return 0;
+        }
+        c->bits[baixo >> 6] &= ~mascara;
+        c->cardinalidade--;
+        if(c->cardinalidade <= LIMITE_ARRAY_BITMAP){
+            converter_para_vetor(c);
+        }
+    }else{
+        int i = posicao_valor(c, baixo);
+        if(i == c->cardinalidade || c->valores[i] != baixo){
+            return 0;
+        }
+        memmove(&c->valores[i], &c->valores[i + 1], (c->cardinalidade - i - 1) * sizeof(unsigned short));
+        c->cardinalidade--;
+    }
+
+    if(c->cardinalidade == 0){
+        liberar_container(c);
+        memmove(&bitmap->containers[posicao], &bitmap->containers[posicao + 1], (bitmap->total - posicao - 1) * sizeof(ContainerBitmap));
+        bitmap->total--;
+    }
+    return 1;
+}
+
+/*
+Verifica se um valor está no bitmap.
+Parâmetros:
+    bitmap - ponteiro para o bitmap
+    valor - valor procurado
+Retorno: 1 se está, 0 caso contrário
+*/
+int contem_bitmap(const Bitmap *bitmap, unsigned int valor){
+    unsigned short baixo = (unsigned short)(valor & 0xFFFF);
+    int posicao;
+    if(!buscar_container(bitmap, (unsigned short)(valor >> 16), &posicao)){
+        return 0;
+    }
+    const ContainerBitmap *c = &bitmap->containers[posicao];
+    if(c->eh_bits){
+        return (c->bits[baixo >> 6] >> (baixo & 63)) & 1;
+    }
+    int i = posicao_valor(c, baixo);
+    return i < c->cardinalidade && c->valores[i] == baixo;
+}
+
+/*
+Retorna o número de valores do bitmap.
+Parâmetro: bitmap - ponteiro para o bitmap
+Retorno: número de valores
+*/
+long long cardinalidade_bitmap(const Bitmap *bitmap){
+    long long total = 0;
+    int i = 0;
+    for(i; i < bitmap->total; i++){
+        total += bitmap->containers[i].cardinalidade;
+    }
+    return total;
+}
+
+/*
+Calcula a interseção de dois containers de mesma chave e, se não for vazia, acrescenta-a à saída.
+*/
+static void intersectar_containers(const ContainerBitmap *a, const ContainerBitmap *b, Bitmap *saida){
+    if(a->eh_bits && b->eh_bits){
+        unsigned long long *bits = (unsigned long long*)alocar_bitmap(PALAVRAS_CONTAINER_BITMAP * sizeof(unsigned long long));
+        int cardinalidade = 0;
+        int i = 0;
+        for(i; i < PALAVRAS_CONTAINER_BITMAP; i++){
+            bits[i] = a->bits[i] & b->bits[i];
+            cardinalidade += CONTAR_BITS(bits[i]);
+        }
+        if(cardinalidade == 0){
+            liberar_memoria(MEMORIA_BITMAP, bits);
+            return;
+        }
+        ContainerBitmap *c = acrescentar_container(saida, a->chave);
+        c->eh_bits = 1;
+        c->bits = bits;
+        c->cardinalidade = cardinalidade;
+        if(cardinalidade <= LIMITE_ARRAY_BITMAP){
+            converter_para_vetor(c);
+        }
+        return;
+    }
+
+    if(a->eh_bits || b->eh_bits){
+        const ContainerBitmap *vetor = a->eh_bits ? b : a;
+        const ContainerBitmap *mapa = a->eh_bits ? a : b;
+        unsigned short *valores = (unsigned short*)alocar_bitmap(vetor->cardinalidade * sizeof(unsigned short));
+        int n = 0;
+        int i = 0;
+        for(i; i < vetor->cardinalidade; i++){
+            unsigned short v = vetor->valores[i];
+            if((mapa->bits[v >> 6] >> (v & 63)) & 1){
+                valores[n++] = v;
+            }
+        }
+        if(n == 0){
+            liberar_memoria(MEMORIA_BITMAP, valores);
+            return;
+        }
+        ContainerBitmap *c = acrescentar_container(saida, a->chave);
+        c->valores = valores;
+        c->cardinalidade = n;
+        c->capacidade = vetor->cardinalidade;
+        return;
+    }
+
+    int menor = a->cardinalidade < b->cardinalidade ? a->cardinalidade : b->cardinalidade;
+    unsigned short *valores = (unsigned short*)alocar_bitmap(menor * sizeof(unsigned short));
+    int n = 0, i = 0, j = 0;
+    while(i < a->cardinalidade && j < b->cardinalidade){
+        if(a->valores[i] < b->valores[j]){
+            i++;
+        }else if(a->valores[i] > b->valores[j]){
+            j++;
+        }else{
+            valores[n++] = a->valores[i];
+            i++;
+            j++;
+        }
+    }
+    if(n == 0){
+        liberar_memoria(MEMORIA_BITMAP, valores);
+        return;
+    }
+    ContainerBitmap *c = acrescentar_container(saida, a->chave);
+    c->valores = valores;
+    c->cardinalidade = n;
+    c->capacidade = menor;
+}
+
+/*
+Calcula a interseção (AND) de dois bitmaps.
+Parâmetros:
+    a, b - ponteiros para os bitmaps
+    saida - ponteiro para o bitmap que recebe o resultado (deve estar iniciado e vazio)
+*/
+void intersectar_bitmap(const Bitmap *a, const Bitmap *b, Bitmap *saida){
+    int i = 0, j = 0;
+    while(i < a->total && j < b->total){
+        if(a->containers[i].chave < b->containers[j].chave){
+            i++;
+        }else if(a->containers[i].chave > b->containers[j].chave){
+            j++;
+        }else{
+            intersectar_containers(&a->containers[i], &b->containers[j], saida);
+            i++;
+            j++;
+        }
+    }
+}
+
+/*
+Copia um container para o fim da saída.
+*/
+static void copiar_container(const ContainerBitmap *origem, Bitmap *saida){
+    ContainerBitmap *c = acrescentar_container(saida, origem->chave);
+    c->eh_bits = origem->eh_bits;
+    c->cardinalidade = origem->cardinalidade;
+    if(origem->eh_bits){
+        c->bits = (unsigned long long*)alocar_bitmap(PALAVRAS_CONTAINER_BITMAP * sizeof(unsigned long long));
+        memcpy(c->bits, origem->bits, PALAVRAS_CONTAINER_BITMAP * sizeof(unsigned long long));
+    }else{
+        c->valores = (unsigned short*)alocar_bitmap(origem->cardinalidade * sizeof(unsigned short));
+        memcpy(c->valores, origem->valores, origem->cardinalidade * sizeof(unsigned short));
+        c->capacidade = origem->cardinalidade;
+    }
+}
+
+/*
+Calcula a união de dois containers de mesma chave e acrescenta-a à saída.
+*/
+static void unir_containers(const ContainerBitmap *a, const ContainerBitmap *b, Bitmap *saida){
+    if(!a->eh_bits && !b->eh_bits && a->cardinalidade + b->cardinalidade <= LIMITE_ARRAY_BITMAP){
+        unsigned short *valores = (unsigned short*)alocar_bitmap((a->cardinalidade + b->cardinalidade) * sizeof(unsigned short));
+        int n = 0, i = 0, j = 0;
+        while(i < a->cardinalidade || j < b->cardinalidade){
+            if(j == b->cardinalidade || (i < a->cardinalidade && a->valores[i] < b->valores[j])){
+                valores[n++] = a->valores[i++];
+            }else if(i == a->cardinalidade || b->valores[j] < a->valores[i]){
+                valores[n++] = b->valores[j++];
+            }else{
+                valores[n++] = a->valores[i];
+                i++;
+                j++;
+            }
+        }
+        ContainerBitmap *c = acrescentar_container(saida, a->chave);
+        c->valores = valores;
+        c->cardinalidade = n;
+        c->capacidade = a->cardinalidade + b->cardinalidade;
+        return;
+    }
+
+    unsigned long long *bits = (unsigned long long*)alocar_zerada_memoria(MEMORIA_BITMAP, PALAVRAS_CONTAINER_BITMAP, sizeof(unsigned long long));
+    if(!bits){
+        printf("Erro ao alocar memoria para o bitmap\n");
+        exit(EXIT_FAILURE);
+    }
+    const ContainerBitmap *lados[2] = {a, b};
+    int k = 0;
+    for(k; k < 2; k++){
+        const ContainerBitmap *lado = lados[k];
+        int i = 0;
+        if(lado->eh_bits){
+            for(i; i < PALAVRAS_CONTAINER_BITMAP; i++){
+                bits[i] |= lado->bits[i];
+            }
+        }else{
+            for(i; i < lado->cardinalidade; i++){
+                bits[lado->valores[i] >> 6] |= 1ULL << (lado->valores[i] & 63);
+            }
+        }
+    }
+
+    int cardinalidade = 0;
+    int i = 0;
+    for(i; i < PALAVRAS_CONTAINER_BITMAP; i++){
+        cardinalidade += CONTAR_BITS(bits[i]);
+    }
+    ContainerBitmap *c = acrescentar_container(saida, a->chave);
+    c->eh_bits = 1;
+    c->bits = bits;
+    c->cardinalidade = cardinalidade;
+    if(cardinalidade <= LIMITE_ARRAY_BITMAP){
+        converter_para_vetor(c);
+    }
+}
+
+/*
+Calcula a união (OR) de dois bitmaps.
+Parâmetros:
+    a, b - ponteiros para os bitmaps
+    saida - ponteiro para o bitmap que recebe o resultado (deve estar iniciado e vazio)
+*/
+void unir_bitmap(const Bitmap *a, const Bitmap *b, Bitmap *saida){
+    int i = 0, j = 0;
+    while(i < a->total || j < b->total){
+        if(j == b->total || (i < a->total && a->containers[i].chave < b->containers[j].chave)){
+            copiar_container(&a->containers[i], saida);
+            i++;
+        }else if(i == a->total || b->containers[j].chave < a->containers[i].chave){
+            copiar_container(&b->containers[j], saida);
+            j++;
+        }else{
+            unir_containers(&a->containers[i], &b->containers[j], saida);
+            i++;
+            j++;
+        }
+    }
+}
+
+/*
+Escreve em ordem crescente todos os valores do bitmap.
+Parâmetros:
+    bitmap - ponteiro para o bitmap
+    saida - vetor com pelo menos cardinalidade_bitmap(bitmap) posições
+Retorno: número de valores escritos
+*/
+int listar_bitmap(const Bitmap *bitmap, unsigned int *saida){
+    int n = 0;
+    int i = 0;
+    for(i; i < bitmap->total; i++){
+        const ContainerBitmap *c = &bitmap->containers[i];
+        unsigned int alto = (unsigned int)c->chave << 16;
+        int j = 0;
+        if(c->eh_bits){
+            for(j; j < PALAVRAS_CONTAINER_BITMAP; j++){
+                unsigned long long palavra = c->bits[j];
+                while(palavra != 0){
+                    saida[n++] = alto | (unsigned int)(j * 64 + primeiro_bit(palavra));
+                    palavra &= palavra - 1;
+                }
+            }
+        }else{
+            for(j; j < c->cardinalidade; j++){
+                saida[n++] = alto | c->valores[j];
+            }
+        }
+    }
+    return n;
+}
+
+/*
+Retorna a memória ocupada pelo bitmap.
+Parâmetro: bitmap - ponteiro para o bitmap
+Retorno: memória em bytes
+*/
+size_t memoria_bitmap(const Bitmap *bitmap){
+    size_t memoria = sizeof(Bitmap) + (size_t)bitmap->capacidade * sizeof(ContainerBitmap);
+    int i = 0;
+    for(i; i < bitmap->total; i++){
+        if(bitmap->containers[i].eh_bits){
+            memoria += PALAVRAS_CONTAINER_BITMAP * sizeof(unsigned long long);
+        }else{
+            memoria += (size_t)bitmap->containers[i].capacidade * sizeof(unsigned short);
+        }
+    }
+    return memoria;
+}
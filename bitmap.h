@@ -0,0 +1,35 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <stdio.h>
+
+#define PALAVRAS_CONTAINER_BITMAP 1024
+#define LIMITE_ARRAY_BITMAP 4096
+
+typedef struct{
+    unsigned short chave;
+    unsigned short eh_bits;
+    int cardinalidade;
+    int capacidade;
+    unsigned short *valores;
+    unsigned long long *bits;
+} ContainerBitmap;
+
+typedef struct{
+    ContainerBitmap *containers;
+    int total;
+    int capacidade;
+} Bitmap;
+
+void iniciar_bitmap(Bitmap *bitmap);
+void liberar_bitmap(Bitmap *bitmap);
+void adicionar_bitmap(Bitmap *bitmap, unsigned int valor);
+int remover_bitmap(Bitmap *bitmap, unsigned int valor);
+int contem_bitmap(const Bitmap *bitmap, unsigned int valor);
+long long cardinalidade_bitmap(const Bitmap *bitmap);
+void intersectar_bitmap(const Bitmap *a, const Bitmap *b, Bitmap *saida);
+void unir_bitmap(const Bitmap *a, const Bitmap *b, Bitmap *saida);
+int listar_bitmap(const Bitmap *bitmap, unsigned int *saida);
+size_t memoria_bitmap(const Bitmap *bitmap);
+
+#endif
@@ -0,0 +1,388 @@
+/*
+->colunas.c
+Implementação de uma cópia colunar (struct-of-arrays) do dataset para varreduras com filtros.
+Cada campo do registro fica em um vetor contíguo próprio, de modo que um filtro por ano, estado
+e cultura lê apenas as colunas que usa (4 + 2 + 2 bytes por linha) em vez de percorrer os
+registros inteiros por ponteiros.
+Os filtros são avaliados em lotes de 8 linhas com AVX2 quando o processador tem suporte, ou por
+um laço escalar sem desvios caso contrário; o resultado é um vetor de seleção com os números
+das linhas aprovadas, em ordem crescente.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "colunas.h"
+#include "memoria.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLUNAR_AVX2 1
+#include <immintrin.h>
+#endif
+
+/*
+Inicializa uma tabela colunar vazia.
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void iniciar_colunar(TabelaColunar *tabela){
+    memset(tabela, 0, sizeof(TabelaColunar));
+}
+
+/*
+Realoca uma coluna para uma nova capacidade.
+Parâmetros:
+    coluna - ponteiro para o vetor da coluna
+    tamanho_item - tamanho de cada valor da coluna
+    capacidade - nova capacidade em linhas
+*/
+static void crescer_coluna(void **coluna, size_t tamanho_item, int capacidade){
+    void *nova = realocar_memoria(MEMORIA_COLUNAS, *coluna, (size_t)capacidade * tamanho_item);
+    if(!nova){
+        printf("Erro ao alocar memoria para a tabela colunar\n");
+        exit(EXIT_FAILURE);
+    }
+    *coluna = nova;
+}
+
+/*
+Garante espaço para um número de linhas, dobrando a capacidade de todas as colunas até que
+ele caiba.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    capacidade - número mínimo de linhas
+*/
+static void garantir_capacidade_colunar(TabelaColunar *tabela, int capacidade){
+    if(capacidade <= tabela->capacidade){
+        return;
+    }
+    int nova_capacidade = tabela->capacidade == 0 ? 1024 : tabela->capacidade;
+    while(nova_capacidade < capacidade){
+        nova_capacidade *= 2;
+    }
+    crescer_coluna((void**)&tabela->ids, sizeof(int), nova_capacidade);
+    crescer_coluna((void**)&tabela->anos, sizeof(int), nova_capacidade);
+    crescer_coluna((void**)&tabela->estados, sizeof(unsigned short), nova_capacidade);
+    crescer_coluna((void**)&tabela->culturas, sizeof(unsigned short), nova_capacidade);
+    crescer_coluna((void**)&tabela->preco_ton, sizeof(float), nova_capacidade);
+    crescer_coluna((void**)&tabela->rendimento, sizeof(float), nova_capacidade);
+    crescer_coluna((void**)&tabela->producao, sizeof(float), nova_capacidade);
+    crescer_coluna((void**)&tabela->area_plantada, sizeof(float), nova_capacidade);
+    crescer_coluna((void**)&tabela->valor_total, sizeof(float), nova_capacidade);
+    tabela->capacidade = nova_capacidade;
+}
+
+/*
+Acrescenta um registro ao final da tabela colunar.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    r - ponteiro para o registro a ser copiado
+*/
+void adicionar_colunar(TabelaColunar *tabela, const Registro *r){
+    garantir_capacidade_colunar(tabela, tabela->total + 1);
+    int i = tabela->total;
+    tabela->ids[i] = r->id;
+    tabela->anos[i] = r->ano;
+    tabela->estados[i] = r->estado;
+    tabela->culturas[i] = r->cultura;
+    tabela->preco_ton[i] = r->preco_ton;
+    tabela->rendimento[i] = r->rendimento;
+    tabela->producao[i] = r->producao;
+    tabela->area_plantada[i] = r->area_plantada;
+    tabela->valor_total[i] = r->valor_total;
+    tabela->total++;
+}
+
+/*
+Copia para a tabela colunar todos os registros de um dataset já carregado.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    ds - ponteiro para o dataset
+*/
+void carregar_registros_colunar(TabelaColunar *tabela, const Dataset *ds){
+    garantir_capacidade_colunar(tabela, tabela->total + ds->total);
+    int i = 0;
+    for(i; i < ds->total; i++){
+        adicionar_colunar(tabela, &ds->itens[i]);
+    }
+}
+
+/*
+Remonta o registro de uma linha da tabela colunar.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    linha - número da linha (por exemplo, vindo do vetor de seleção)
+    r - ponteiro para o registro que recebe os valores
+*/
+void registro_colunar(const TabelaColunar *tabela, int linha, Registro *r){
+    r->id = tabela->ids[linha];
+    r->ano = tabela->anos[linha];
+    r->estado = tabela->estados[linha];
+    r->cultura = tabela->culturas[linha];
+    r->preco_ton = tabela->preco_ton[linha];
+    r->rendimento = tabela->rendimento[linha];
+    r->producao = tabela->producao[linha];
+    r->area_plantada = tabela->area_plantada[linha];
+    r->valor_total = tabela->valor_total[linha];
+}
+
+/*
+Verifica se o processador tem suporte a AVX2.
+Retorno: 1 se os filtros vetoriais podem ser usados, 0 caso contrário
+*/
+int avx2_disponivel_colunar(void){
+#ifdef COLUNAR_AVX2
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+/*
+Filtro escalar: avalia os predicados linha a linha, sem desvios, escrevendo sempre a linha no
+vetor de seleção e avançando o contador somente quando ela é aprovada. Os predicados são
+combinados com & e | sobre valores 0/1, e não com ACEITA_FILTRO, cujo || encerraria a
+avaliação antes da consulta ao dicionário.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    ano_min, ano_max - intervalo de anos
+    estado, cultura - filtros obtidos com filtro_dicionario (classes)
+    selecao - vetor que recebe as linhas aprovadas
+Retorno: número de linhas aprovadas
+*/
+static int selecionar_escalar(const TabelaColunar *tabela, int ano_min, int ano_max, int estado, int cultura, int *selecao){
+    int qualquer_estado = estado == FILTRO_QUALQUER;
+    int qualquer_cultura = cultura == FILTRO_QUALQUER;
+    int n = 0;
+    int i = 0;
+    for(i; i < tabela->total; i++){
+        int ano = tabela->anos[i];
+        int aprovada = (ano >= ano_min) & (ano <= ano_max)
+            & (qualquer_estado | (dicionario_estados.classes[tabela->estados[i]] == estado))
+            & (qualquer_cultura | (dicionario_culturas.classes[tabela->culturas[i]] == cultura));
+        selecao[n] = i;
+        n += aprovada;
+    }
+    return n;
+}
+
+#ifdef COLUNAR_AVX2
+/*
+Filtro AVX2: avalia 8 linhas por vez (intervalo de anos e igualdade de estado e cultura) e
+converte a máscara resultante em números de linha. Compara códigos diretamente, portanto só é
+usado quando cada filtro corresponde a um único código do dicionário.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    ano_min, ano_max - intervalo de anos
+    estado, cultura - código procurado, ou FILTRO_QUALQUER
+    selecao - vetor que recebe as linhas aprovadas
+Retorno: número de linhas aprovadas
+*/
+__attribute__((target("avx2")))
+static int selecionar_avx2(const TabelaColunar *tabela, int ano_min, int ano_max, int estado, int cultura, int *selecao){
+    const __m256i minimo = _mm256_set1_epi32(ano_min);
+    const __m256i maximo = _mm256_set1_epi32(ano_max);
+    const __m256i codigo_estado = _mm256_set1_epi32(estado);
+    const __m256i codigo_cultura = _mm256_set1_epi32(cultura);
+    int n = 0;
+    int i = 0;
+
+    for(i; i + 8 <= tabela->total; i += 8){
+        __m256i anos = _mm256_loadu_si256((const __m256i*)(tabela->anos + i));
+        /* min(max(ano, ano_min), ano_max) == ano  <=>  ano_min <= ano <= ano_max, sem estouro */
+        __m256i aprovadas = _mm256_cmpeq_epi32(_mm256_min_epi32(_mm256_max_epi32(anos, minimo), maximo), anos);
+        if(estado != FILTRO_QUALQUER){
+            __m256i estados = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(tabela->estados + i)));
+            aprovadas = _mm256_and_si256(aprovadas, _mm256_cmpeq_epi32(estados, codigo_estado));
+        }
+        if(cultura != FILTRO_QUALQUER){
+            __m256i culturas = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(tabela->culturas + i)));
+            aprovadas = _mm256_and_si256(aprovadas, _mm256_cmpeq_epi32(culturas, codigo_cultura));
+        }
+
+        unsigned int mascara = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(aprovadas));
+        while(mascara != 0){
+            selecao[n++] = i + __builtin_ctz(mascara);
+            mascara &= mascara - 1;
+        }
+    }
+
+    for(i; i < tabela->total; i++){
+        int ano = tabela->anos[i];
+        int aprovada = (ano >= ano_min) & (ano <= ano_max)
+            & (estado == FILTRO_QUALQUER || tabela->estados[i] == estado)
+            & (cultura == FILTRO_QUALQUER || tabela->culturas[i] == cultura);
+        selecao[n] = i;
+        n += aprovada;
+    }
+    return n;
+}
+#endif
+
+/*
+Verifica se uma classe do dicionário tem um único código (o caso comum: o texto só aparece com
+uma grafia), caso em que o filtro pode comparar códigos diretamente.
+Parâmetros:
+    dicionario - ponteiro para o dicionário
+    filtro - filtro obtido com filtro_dicionario
+Retorno: 1 se o filtro equivale a uma comparação com um único código, 0 caso contrário
+*/
+static int filtro_codigo_unico(const Dicionario *dicionario, int filtro){
+    if(filtro == FILTRO_QUALQUER){
+        return 1;
+    }
+    int total = (int)dicionario->total;
+    int i = filtro + 1;
+    for(i; i < total; i++){
+        if(dicionario->classes[i] == filtro){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+Seleciona as linhas da tabela que atendem aos filtros de ano, estado e cultura.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    ano_min, ano_max - intervalo de anos
+    estado - filtro de estado (string, vazio para ignorar)
+    cultura - filtro de cultura (string, vazio para ignorar)
+    vetorial - 1 para usar AVX2 quando disponível, 0 para forçar o filtro escalar
+    selecao - vetor com pelo menos tabela->total posições que recebe as linhas aprovadas
+Retorno: número de linhas aprovadas
+*/
+int selecionar_colunar(const TabelaColunar *tabela, int ano_min, int ano_max, const char *estado, const char *cultura, int vetorial, int *selecao){
+    int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+    int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+    if(filtro_estado == FILTRO_NENHUM || filtro_cultura == FILTRO_NENHUM || ano_min > ano_max){
+        return 0;
+    }
+
+#ifdef COLUNAR_AVX2
+    if(vetorial && avx2_disponivel_colunar()
+        && filtro_codigo_unico(&dicionario_estados, filtro_estado)
+        && filtro_codigo_unico(&dicionario_culturas, filtro_cultura)){
+        return selecionar_avx2(tabela, ano_min, ano_max, filtro_estado, filtro_cultura, selecao);
+    }
+#endif
+    return selecionar_escalar(tabela, ano_min, ano_max, filtro_estado, filtro_cultura, selecao);
+}
+
+/*
+Retorna a memória ocupada pela tabela colunar.
+Parâmetro: tabela - ponteiro para a tabela
+Retorno: memória em bytes
+*/
+size_t memoria_colunar(const TabelaColunar *tabela){
+    size_t por_linha = 2 * sizeof(int) + 2 * sizeof(unsigned short) + 5 * sizeof(float);
+    return sizeof(TabelaColunar) + (size_t)tabela->capacidade * por_linha;
+}
+
+/*
+Libera todas as colunas, deixando a tabela vazia.
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void liberar_colunar(TabelaColunar *tabela){
+    liberar_memoria(MEMORIA_COLUNAS, tabela->ids);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->anos);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->estados);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->culturas);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->preco_ton);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->rendimento);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->producao);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->area_plantada);
+    liberar_memoria(MEMORIA_COLUNAS, tabela->valor_total);
+    iniciar_colunar(tabela);
+}
+
+/*
+Filtro por linhas usado como referência no benchmark: percorre os registros por ponteiros,
+como fazem as funções buscar_filtros_* das estruturas.
+*/
+static int selecionar_linhas(Registro **linhas, int total, int ano_min, int ano_max, int estado, int cultura, int *selecao){
+    int n = 0;
+    int i = 0;
+    for(i; i < total; i++){
+        const Registro *r = linhas[i];
+        int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
+        int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, estado);
+        int cultura_certa = ACEITA_FILTRO(dicionario_culturas, r->cultura, cultura);
+        if(ano_certo && estado_certo && cultura_certa){
+            selecao[n++] = i;
+        }
+    }
+    return n;
+}
+
+/*
+Mede o tempo médio de uma varredura completa com filtros de ano, estado e cultura sobre o
+dataset inteiro, por linhas (ponteiros para registros) ou pela tabela colunar.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    repeticoes - número de varreduras completas
+    ano_min, ano_max - intervalo de anos
+    estado, cultura - filtros (string, vazio para ignorar)
+    modo - MODO_FILTRO_LINHAS, MODO_FILTRO_ESCALAR ou MODO_FILTRO_AVX2
+    encontrados - recebe o número de linhas aprovadas em cada varredura
+Retorno: tempo médio por varredura em segundos (double)
+*/
+double bench_tempo_filtro_colunar(const char *nome_arquivo, int repeticoes, int ano_min, int ano_max, const char *estado, const char *cultura, int modo, int *encontrados){
+    struct timespec inicio, fim;
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+
+    if(repeticoes < 1){
+        repeticoes = 1;
+    }
+
+    TabelaColunar tabela;
+    iniciar_colunar(&tabela);
+    Registro **linhas = NULL;
+    if(modo == MODO_FILTRO_LINHAS){
+        linhas = (Registro**)alocar_memoria(MEMORIA_COLUNAS, (ds.total > 0 ? ds.total : 1) * sizeof(Registro*));
+        if(!linhas){
+            printf("Erro ao alocar memoria para o benchmark\n");
+            exit(EXIT_FAILURE);
+        }
+        int i = 0;
+        for(i; i < ds.total; i++){
+            linhas[i] = &ds.itens[i];
+        }
+    }else{
+        carregar_registros_colunar(&tabela, &ds);
+    }
+
+    int *selecao = (int*)alocar_memoria(MEMORIA_COLUNAS, (ds.total > 0 ? ds.total : 1) * sizeof(int));
+    if(!selecao){
+        printf("Erro ao alocar memoria para o benchmark\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+    int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+    int n = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < repeticoes; i++){
+        if(modo == MODO_FILTRO_LINHAS){
+            n = selecionar_linhas(linhas, ds.total, ano_min, ano_max, filtro_estado, filtro_cultura, selecao);
+        }else{
+            n = selecionar_colunar(&tabela, ano_min, ano_max, estado, cultura, modo == MODO_FILTRO_AVX2, selecao);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    *encontrados = n;
+    liberar_memoria(MEMORIA_COLUNAS, selecao);
+    liberar_memoria(MEMORIA_COLUNAS, linhas);
+    liberar_colunar(&tabela);
+    liberar_dataset(&ds);
+
+    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    return tempo / repeticoes;
+}
@@ -0,0 +1,35 @@
+#ifndef COLUNAS_H
+#define COLUNAS_H
+
+#include <stdio.h>
+#include "dataset.h"
+
+#define MODO_FILTRO_LINHAS 0
+#define MODO_FILTRO_ESCALAR 1
+#define MODO_FILTRO_AVX2 2
+
+typedef struct{
+    int *ids;
+    int *anos;
+    unsigned short *estados;
+    unsigned short *culturas;
+    float *preco_ton;
+    float *rendimento;
+    float *producao;
+    float *area_plantada;
+    float *valor_total;
+    int total;
+    int capacidade;
+} TabelaColunar;
+
+void iniciar_colunar(TabelaColunar *tabela);
+void adicionar_colunar(TabelaColunar *tabela, const Registro *r);
+void carregar_registros_colunar(TabelaColunar *tabela, const Dataset *ds);
+void registro_colunar(const TabelaColunar *tabela, int linha, Registro *r);
+int avx2_disponivel_colunar(void);
+int selecionar_colunar(const TabelaColunar *tabela, int ano_min, int ano_max, const char *estado, const char *cultura, int vetorial, int *selecao);
+size_t memoria_colunar(const TabelaColunar *tabela);
+void liberar_colunar(TabelaColunar *tabela);
+double bench_tempo_filtro_colunar(const char *nome_arquivo, int repeticoes, int ano_min, int ano_max, const char *estado, const char *cultura, int modo, int *encontrados);
+
+#endif
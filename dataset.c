@@ -0,0 +1,839 @@
+/*
+->dataset.c
+Implementação do carregamento compartilhado do dataset de amostras agrícolas.
+Este arquivo contém as funções que leem o arquivo uma única vez para um vetor de
+registros em memória, a partir do qual todas as estruturas de dados são construídas.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include <io.h>
+#include "dataset.h"
+#include "memoria.h"
+
+/*
+Inicializa um dataset vazio.
+Parâmetro: ds - ponteiro para o dataset
+*/
+void iniciar_dataset(Dataset *ds){
+    ds->itens = NULL;
+    ds->total = 0;
+    ds->capacidade = 0;
+}
+
+/*
+Adiciona um registro ao final do dataset, dobrando a capacidade do vetor quando necessário.
+Parâmetros:
+    ds - ponteiro para o dataset
+    novo - registro a ser adicionado
+*/
+void adicionar_dataset(Dataset *ds, Registro novo){
+    if(ds->total == ds->capacidade){
+        int nova_capacidade = ds->capacidade == 0 ? 1024 : ds->capacidade * 2;
+        Registro *itens = (Registro*)realocar_memoria(MEMORIA_DATASET, ds->itens, nova_capacidade * sizeof(Registro));
+        if(!itens){
+            printf("Erro ao alocar memoria para o dataset\n");
+            exit(EXIT_FAILURE);
+        }
+        ds->itens = itens;
+        ds->capacidade = nova_capacidade;
+    }
+
+    ds->itens[ds->total] = novo;
+    ds->total++;
+}
+
+/*
+Mapeia o arquivo inteiro em memória somente para leitura.
+Parâmetros:
+    am - ponteiro para a estrutura que recebe o mapeamento
+    nome_arquivo - nome do arquivo a ser mapeado
+Retorno: 1 se o arquivo foi mapeado, 0 em caso de erro
+*/
+int mapear_arquivo(ArquivoMapeado *am, const char *nome_arquivo){
+    am->dados = NULL;
+    am->tamanho = 0;
+    am->mapeamento = NULL;
+
+    am->arquivo = CreateFileA(nome_arquivo, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(am->arquivo == INVALID_HANDLE_VALUE){
+        return 0;
+    }
+
+    LARGE_INTEGER tamanho;
+    if(!GetFileSizeEx(am->arquivo, &tamanho)){
+        CloseHandle(am->arquivo);
+        return 0;
+    }
+    am->tamanho = (size_t)tamanho.QuadPart;
+
+    if(am->tamanho == 0){
+        return 1;
+    }
+
+    am->mapeamento = CreateFileMappingA(am->arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(am->mapeamento == NULL){
+        CloseHandle(am->arquivo);
+        return 0;
+    }
+
+    am->dados = (const char*)MapViewOfFile(am->mapeamento, FILE_MAP_READ, 0, 0, 0);
+    if(am->dados == NULL){
+        CloseHandle(am->mapeamento);
+        CloseHandle(am->arquivo);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+Desfaz o mapeamento do arquivo e fecha os handles associados.
+Parâmetro: am - ponteiro para o arquivo mapeado
+*/
+void desmapear_arquivo(ArquivoMapeado *am){
+    if(am->dados != NULL){
+        UnmapViewOfFile(am->dados);
+    }
+    if(am->mapeamento != NULL){
+        CloseHandle(am->mapeamento);
+    }
+    CloseHandle(am->arquivo);
+
+    am->dados = NULL;
+    am->tamanho = 0;
+}
+
+/*
+Converte um campo inteiro a partir do cursor, sem sscanf e sem depender de locale.
+Parâmetros:
+    p - posição inicial do campo
+    fim - fim do buffer
+    valor - ponteiro para o inteiro lido
+Retorno: posição logo após o último caractere consumido
+*/
+static const char* ler_inteiro_campo(const char *p, const char *fim, int *valor){
+    int negativo = 0;
+    int resultado = 0;
+
+    if(p < fim && (*p == '-' || *p == '+')){
+        negativo = (*p == '-');
+        p++;
+    }
+    while(p < fim && *p >= '0' && *p <= '9'){
+        resultado = resultado * 10 + (*p - '0');
+        p++;
+    }
+
+    *valor = negativo ? -resultado : resultado;
+    return p;
+}
+
+/*
+Converte um campo decimal (com parte fracionária e expoente opcionais) a partir do cursor,
+sem sscanf e sem depender de locale. O separador decimal é sempre o ponto.
+Parâmetros:
+    p - posição inicial do campo
+    fim - fim do buffer
+    valor - ponteiro para o float lido
+Retorno: posição logo após o último caractere consumido
+*/
+static const char* ler_float_campo(const char *p, const char *fim, float *valor){
+    static const double potencias[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                       1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    int negativo = 0;
+    double resultado = 0.0;
+
+    if(p < fim && (*p == '-' || *p == '+')){
+        negativo = (*p == '-');
+        p++;
+    }
+    while(p < fim && *p >= '0' && *p <= '9'){
+        resultado = resultado * 10.0 + (*p - '0');
+        p++;
+    }
+
+    if(p < fim && *p == '.'){
+        p++;
+        long long fracao = 0;
+        int casas = 0;
+        while(p < fim && *p >= '0' && *p <= '9'){
+            if(casas < 18){
+                fracao = fracao * 10 + (*p - '0');
+                casas++;
+            }
+            p++;
+        }
+        resultado += fracao / potencias[casas];
+    }
+
+    if(p < fim && (*p == 'e' || *p == 'E')){
+        int expoente = 0;
+        p = ler_inteiro_campo(p + 1, fim, &expoente);
+        while(expoente > 0){
+            resultado *= 10.0;
+            expoente--;
+        }
+        while(expoente < 0){
+            resultado /= 10.0;
+            expoente++;
+        }
+    }
+
+    *valor = (float)(negativo ? -resultado : resultado);
+    return p;
+}
+
+/*
+Copia um campo de texto até o próximo ';' ou fim de linha, truncando no tamanho do destino.
+Parâmetros:
+    p - posição inicial do campo
+    fim - fim do buffer
+    destino - vetor que recebe o texto
+    tamanho - tamanho do vetor de destino
+Retorno: posição do delimitador que encerrou o campo
+*/
+static const char* ler_texto_campo(const char *p, const char *fim, char *destino, int tamanho){
+    int i = 0;
+    while(p < fim && *p != ';' && *p != '\n' && *p != '\r'){
+        if(i < tamanho - 1){
+            destino[i++] = *p;
+        }
+        p++;
+    }
+    destino[i] = '\0';
+    return p;
+}
+
+/*
+Avança o cursor para o início da próxima linha.
+Parâmetros:
+    p - posição atual
+    fim - fim do buffer
+Retorno: posição do primeiro caractere da próxima linha (ou fim)
+*/
+const char* proxima_linha_csv(const char *p, const char *fim){
+    const char *quebra = (const char*)memchr(p, '\n', fim - p);
+    if(quebra == NULL){
+        return fim;
+    }
+    return quebra + 1;
+}
+
+/*
+Interpreta uma linha do dataset (id;ano;estado;cultura;preco;rendimento;producao;area;valor)
+diretamente sobre o buffer, e avança o cursor para a linha seguinte.
+Parâmetros:
+    cursor - ponteiro para a posição atual no buffer (atualizado pela função)
+    fim - fim do buffer
+    r - ponteiro para o registro que recebe os campos
+Retorno: 1 se a linha continha os nove campos, 0 caso contrário
+*/
+int ler_linha_csv(const char **cursor, const char *fim, Registro *r){
+    const char *p = *cursor;
+    const char *inicio = p;
+    int campos = 0;
+
+    p = ler_inteiro_campo(p, fim, &r->id);
+    if(p > inicio){
+        campos = 1;
+    }
+    if(campos == 1 && p < fim && *p == ';'){
+        p = ler_inteiro_campo(p + 1, fim, &r->ano);
+        campos++;
+    }
+    if(campos == 2 && p < fim && *p == ';'){
+        char estado[TAM_ESTADO];
+        p = ler_texto_campo(p + 1, fim, estado, sizeof(estado));
+        r->estado = (unsigned short)codigo_estado(estado);
+        campos++;
+    }
+    if(campos == 3 && p < fim && *p == ';'){
+        char cultura[TAM_CULTURA];
+        p = ler_texto_campo(p + 1, fim, cultura, sizeof(cultura));
+        r->cultura = (unsigned short)codigo_cultura(cultura);
+        campos++;
+    }
+    if(campos == 4 && p < fim && *p == ';'){
+        p = ler_float_campo(p + 1, fim, &r->preco_ton);
+        campos++;
+    }
+    if(campos == 5 && p < fim && *p == ';'){
+        p = ler_float_campo(p + 1, fim, &r->rendimento);
+        campos++;
+    }
+    if(campos == 6 && p < fim && *p == ';'){
+        p = ler_float_campo(p + 1, fim, &r->producao);
+        campos++;
+    }
+    if(campos == 7 && p < fim && *p == ';'){
+        p = ler_float_campo(p + 1, fim, &r->area_plantada);
+        campos++;
+    }
+    if(campos == 8 && p < fim && *p == ';'){
+        p = ler_float_campo(p + 1, fim, &r->valor_total);
+        campos++;
+    }
+
+    *cursor = proxima_linha_csv(p, fim);
+    return campos == 9;
+}
+
+/*
+Abre o dataset para leitura sequencial: mapeia o arquivo e posiciona o cursor após o cabeçalho.
+Encerra o programa se o arquivo não puder ser aberto, como as demais funções de carga.
+Parâmetros:
+    leitor - ponteiro para o leitor
+    nome_arquivo - nome do arquivo de entrada (dataset)
+*/
+void abrir_leitor_csv(LeitorCSV *leitor, const char *nome_arquivo){
+    if(!mapear_arquivo(&leitor->arquivo, nome_arquivo)){
+        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    leitor->fim = leitor->arquivo.dados + leitor->arquivo.tamanho;
+    leitor->cursor = leitor->arquivo.dados;
+    if(leitor->cursor != NULL){
+        leitor->cursor = proxima_linha_csv(leitor->cursor, leitor->fim);
+    }
+}
+
+/*
+Lê o próximo registro válido do dataset, ignorando linhas malformadas ou vazias.
+Parâmetros:
+    leitor - ponteiro para o leitor
+    r - ponteiro para o registro que recebe os campos
+Retorno: 1 se um registro foi lido, 0 no fim do arquivo
+*/
+int proximo_registro_csv(LeitorCSV *leitor, Registro *r){
+    while(leitor->cursor != NULL && leitor->cursor < leitor->fim){
+        if(ler_linha_csv(&leitor->cursor, leitor->fim, r)){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+Fecha o leitor e desfaz o mapeamento do arquivo.
+Parâmetro: leitor - ponteiro para o leitor
+*/
+void fechar_leitor_csv(LeitorCSV *leitor){
+    desmapear_arquivo(&leitor->arquivo);
+    leitor->cursor = NULL;
+    leitor->fim = NULL;
+}
+
+/*
+Lê o arquivo (dataset) uma única vez e armazena todas as amostras no vetor de registros.
+O arquivo é mapeado em memória e interpretado diretamente, sem fgets/sscanf. Arquivos
+grandes são divididos entre os processadores disponíveis (ver carregar_dataset_paralelo).
+Parâmetros:
+    ds - ponteiro para o dataset (deve estar inicializado)
+    nome_arquivo - nome do arquivo de entrada (dataset)
+*/
+void carregar_dataset(Dataset *ds, const char *nome_arquivo){
+    carregar_dataset_paralelo(ds, nome_arquivo, 0);
+}
+
+/*
+Compara dois registros pelo ID, para uso com qsort.
+*/
+static int comparar_registros_id(const void *a, const void *b){
+    const Registro *ra = (const Registro*)a;
+    const Registro *rb = (const Registro*)b;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+/*
+Interpreta as linhas de um bloco do arquivo mapeado e deixa o vetor do bloco ordenado por ID
+(a ordenação só é feita se o trecho do arquivo estiver fora de ordem). Executada por uma
+thread de leitura.
+Parâmetro: arg - ponteiro para o BlocoLeitura com o intervalo e o vetor de saída
+Retorno: 0
+*/
+static DWORD WINAPI ler_bloco_csv(LPVOID arg){
+    BlocoLeitura *bloco = (BlocoLeitura*)arg;
+    const char *cursor = bloco->inicio;
+    Registro novo;
+    int ordenado = 1;
+
+    while(cursor < bloco->fim){
+        if(ler_linha_csv(&cursor, bloco->fim, &novo)){
+            if(bloco->registros.total > 0 && bloco->registros.itens[bloco->registros.total - 1].id > novo.id){
+                ordenado = 0;
+            }
+            adicionar_dataset(&bloco->registros, novo);
+        }
+    }
+
+    if(!ordenado){
+        qsort(bloco->registros.itens, bloco->registros.total, sizeof(Registro), comparar_registros_id);
+    }
+    return 0;
+}
+
+/*
+Retorna o número de threads de leitura adequado ao tamanho do arquivo: uma por processador,
+mas sem criar blocos menores que TAM_MIN_BLOCO_LEITURA.
+Parâmetro: tamanho - tamanho em bytes da parte do arquivo a ser interpretada
+Retorno: número de threads (entre 1 e MAX_THREADS_LEITURA)
+*/
+int threads_leitura(size_t tamanho){
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    int n = (int)info.dwNumberOfProcessors;
+    int por_tamanho = (int)(tamanho / TAM_MIN_BLOCO_LEITURA);
+    if(n > por_tamanho){
+        n = por_tamanho;
+    }
+    if(n > MAX_THREADS_LEITURA){
+        n = MAX_THREADS_LEITURA;
+    }
+    if(n < 1){
+        n = 1;
+    }
+    return n;
+}
+
+/*
+Intercala os vetores de cada bloco no dataset em ordem crescente de ID. Em caso de IDs
+iguais prevalece a ordem do arquivo.
+Parâmetros:
+    ds - ponteiro para o dataset de destino
+    blocos - vetor de blocos já interpretados
+    n - quantidade de blocos
+*/
+static void intercalar_blocos(Dataset *ds, BlocoLeitura *blocos, int n){
+    int posicao[MAX_THREADS_LEITURA] = {0};
+    int total = 0;
+    int i = 0;
+    for(i; i < n; i++){
+        total += blocos[i].registros.total;
+    }
+
+    while(total > 0){
+        int menor = -1;
+        int b = 0;
+        for(b; b < n; b++){
+            if(posicao[b] < blocos[b].registros.total){
+                if(menor == -1 || blocos[b].registros.itens[posicao[b]].id < blocos[menor].registros.itens[posicao[menor]].id){
+                    menor = b;
+                }
+            }
+        }
+        adicionar_dataset(ds, blocos[menor].registros.itens[posicao[menor]]);
+        posicao[menor]++;
+        total--;
+    }
+}
+
+/*
+Carrega o dataset dividindo o arquivo mapeado em blocos alinhados ao início das linhas,
+interpretados em paralelo, um por thread, em vetores próprios. Ao final os vetores são
+intercalados em ordem de ID antes de as estruturas serem construídas.
+Parâmetros:
+    ds - ponteiro para o dataset (deve estar inicializado)
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    n_threads - número de threads; 0 escolhe automaticamente pelo tamanho do arquivo
+*/
+void carregar_dataset_paralelo(Dataset *ds, const char *nome_arquivo, int n_threads){
+    LeitorCSV leitor;
+    BlocoLeitura blocos[MAX_THREADS_LEITURA];
+    HANDLE threads[MAX_THREADS_LEITURA];
+
+    abrir_leitor_csv(&leitor, nome_arquivo);
+    if(leitor.cursor == NULL){
+        fechar_leitor_csv(&leitor);
+        return;
+    }
+
+    size_t tamanho = leitor.fim - leitor.cursor;
+    if(n_threads <= 0){
+        n_threads = threads_leitura(tamanho);
+    }
+    if(n_threads > MAX_THREADS_LEITURA){
+        n_threads = MAX_THREADS_LEITURA;
+    }
+
+    const char *inicio = leitor.cursor;
+    int i = 0;
+    for(i; i < n_threads; i++){
+        const char *corte = leitor.fim;
+        if(i < n_threads - 1){
+            corte = leitor.cursor + tamanho * (i + 1) / n_threads;
+            if(corte < inicio){
+                corte = inicio;
+            }else if(corte > inicio && corte[-1] != '\n'){
+                corte = proxima_linha_csv(corte, leitor.fim);
+            }
+        }
+
+        blocos[i].inicio = inicio;
+        blocos[i].fim = corte;
+        iniciar_dataset(&blocos[i].registros);
+        inicio = corte;
+    }
+
+    if(n_threads == 1){
+        ler_bloco_csv(&blocos[0]);
+    }else{
+        for(i = 0; i < n_threads; i++){
+            threads[i] = CreateThread(NULL, 0, ler_bloco_csv, &blocos[i], 0, NULL);
+            if(threads[i] == NULL){
+                printf("Erro ao criar thread de leitura\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        WaitForMultipleObjects(n_threads, threads, TRUE, INFINITE);
+        for(i = 0; i < n_threads; i++){
+            CloseHandle(threads[i]);
+        }
+    }
+
+    intercalar_blocos(ds, blocos, n_threads);
+
+    for(i = 0; i < n_threads; i++){
+        liberar_dataset(&blocos[i].registros);
+    }
+    fechar_leitor_csv(&leitor);
+}
+
+/*
+Mede a vazão de interpretação do dataset com o leitor mapeado em memória. O arquivo é
+mapeado uma vez e percorrido por inteiro em cada repetição.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    repeticoes - número de vezes que o arquivo é percorrido
+Retorno: vazão em MB/s (double)
+*/
+double bench_vazao_leitura_csv(const char *nome_arquivo, int repeticoes){
+    struct timespec inicio, fim;
+    LeitorCSV leitor;
+    Registro r;
+    long long linhas = 0;
+
+    abrir_leitor_csv(&leitor, nome_arquivo);
+    const char *primeira = leitor.cursor;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < repeticoes; i++){
+        leitor.cursor = primeira;
+        while(proximo_registro_csv(&leitor, &r)){
+            linhas++;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    double megabytes = (double)leitor.arquivo.tamanho * repeticoes / (1024.0 * 1024.0);
+    fechar_leitor_csv(&leitor);
+
+    if(tempo <= 0 || linhas == 0){
+        return 0;
+    }
+    return megabytes / tempo;
+}
+
+/*
+Mede a vazão da carga paralela do dataset, incluindo a intercalação dos blocos por ID.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    repeticoes - número de cargas completas do arquivo
+    n_threads - número de threads de leitura (0 escolhe automaticamente)
+Retorno: vazão em MB/s (double)
+*/
+double bench_vazao_leitura_paralela(const char *nome_arquivo, int repeticoes, int n_threads){
+    struct timespec inicio, fim;
+    ArquivoMapeado am;
+    if(!mapear_arquivo(&am, nome_arquivo)){
+        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
+        exit(EXIT_FAILURE);
+    }
+    size_t tamanho = am.tamanho;
+    desmapear_arquivo(&am);
+
+    long long linhas = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < repeticoes; i++){
+        Dataset ds;
+        iniciar_dataset(&ds);
+        carregar_dataset_paralelo(&ds, nome_arquivo, n_threads);
+        linhas += ds.total;
+        liberar_dataset(&ds);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    double megabytes = (double)tamanho * repeticoes / (1024.0 * 1024.0);
+    if(tempo <= 0 || linhas == 0){
+        return 0;
+    }
+    return megabytes / tempo;
+}
+
+/*
+Mede a vazão de interpretação do dataset com o método anterior (fgets + sscanf), para
+comparação com o leitor mapeado em memória.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    repeticoes - número de vezes que o arquivo é percorrido
+Retorno: vazão em MB/s (double)
+*/
+double bench_vazao_leitura_sscanf(const char *nome_arquivo, int repeticoes){
+    struct timespec inicio, fim;
+    FILE *arquivo = fopen(nome_arquivo, "r");
+    if(!arquivo){
+        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    char linha[256];
+    long long linhas = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < repeticoes; i++){
+        rewind(arquivo);
+        fgets(linha, sizeof(linha), arquivo);
+        while(fgets(linha, sizeof(linha), arquivo)){
+            Registro r;
+            char estado[TAM_ESTADO];
+            char cultura[TAM_CULTURA];
+            if(sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
+                &r.id, &r.ano, estado, cultura, &r.preco_ton,
+                &r.rendimento, &r.producao, &r.area_plantada, &r.valor_total) == 9){
+                r.estado = (unsigned short)codigo_estado(estado);
+                r.cultura = (unsigned short)codigo_cultura(cultura);
+                linhas++;
+            }
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    fclose(arquivo);
+
+    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    double megabytes = (double)tamanho * repeticoes / (1024.0 * 1024.0);
+    if(tempo <= 0 || linhas == 0){
+        return 0;
+    }
+    return megabytes / tempo;
+}
+
+/*
+Lê os dados de uma nova amostra a partir da entrada do usuário.
+Parâmetros:
+    novo - ponteiro para o registro a ser preenchido
+    id - identificador atribuído à nova amostra
+*/
+void ler_registro_usuario(Registro *novo, int id){
+    char entrada[50];
+    char estado[TAM_ESTADO];
+    char cultura[TAM_CULTURA];
+    novo->id = id;
+
+    printf("\n===Insira os dados da nova amostra===\n");
+
+    printf("Ano: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%d", &novo->ano);
+
+    printf("Estado: ");
+    fgets(estado, sizeof(estado), stdin);
+    estado[strcspn(estado, "\n")] = '\0';
+    novo->estado = (unsigned short)codigo_estado(estado);
+
+    printf("Cultura: ");
+    fgets(cultura, sizeof(cultura), stdin);
+    cultura[strcspn(cultura, "\n")] = '\0';
+    novo->cultura = (unsigned short)codigo_cultura(cultura);
+
+    printf("Preco por tonelada: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%f", &novo->preco_ton);
+
+    printf("Rendimento: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%f", &novo->rendimento);
+
+    printf("Producao: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%f", &novo->producao);
+
+    printf("Area plantada: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%f", &novo->area_plantada);
+
+    printf("Valor total: ");
+    fgets(entrada, sizeof(entrada), stdin);
+    sscanf(entrada, "%f", &novo->valor_total);
+}
+
+/*
+Libera o vetor de registros do dataset.
+Parâmetro: ds - ponteiro para o dataset
+*/
+void liberar_dataset(Dataset *ds){
+    liberar_memoria(MEMORIA_DATASET, ds->itens);
+    iniciar_dataset(ds);
+}
+
+/*
+Verifica se os registros do dataset estão em ordem estritamente crescente de ID.
+Parâmetro: ds - ponteiro para o dataset
+Retorno: 1 se ordenado e sem IDs repetidos, 0 caso contrário
+*/
+int dataset_ordenado(const Dataset *ds){
+    int i = 1;
+    for(i; i < ds->total; i++){
+        if(ds->itens[i].id <= ds->itens[i - 1].id){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+Busca, por pesquisa binária, a posição de um ID no dataset ordenado por ID.
+Parâmetros:
+    ds - ponteiro para o dataset (ordenado por ID)
+    id - identificador procurado
+Retorno: posição do primeiro registro com ID maior ou igual ao procurado
+*/
+int posicao_dataset(const Dataset *ds, int id){
+    int inicio = 0;
+    int fim = ds->total;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if(ds->itens[meio].id < id){
+            inicio = meio + 1;
+        }else{
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/*
+Insere um registro mantendo o dataset ordenado por ID. Se o ID já existir, o registro é
+substituído. Inserções no fim (caso comum, já que novos IDs são sempre os maiores) custam O(1).
+Parâmetros:
+    ds - ponteiro para o dataset (ordenado por ID)
+    novo - registro a ser inserido
+*/
+void inserir_ordenado_dataset(Dataset *ds, Registro novo){
+    if(ds->total == 0 || ds->itens[ds->total - 1].id < novo.id){
+        adicionar_dataset(ds, novo);
+        return;
+    }
+
+    int pos = posicao_dataset(ds, novo.id);
+    if(pos < ds->total && ds->itens[pos].id == novo.id){
+        ds->itens[pos] = novo;
+        return;
+    }
+
+    adicionar_dataset(ds, novo);
+    memmove(&ds->itens[pos + 1], &ds->itens[pos], (ds->total - 1 - pos) * sizeof(Registro));
+    ds->itens[pos] = novo;
+}
+
+/*
+Remove do dataset ordenado o registro com o ID informado.
+Parâmetros:
+    ds - ponteiro para o dataset (ordenado por ID)
+    id - identificador do registro a ser removido
+Retorno: 1 se removido, 0 se não encontrado
+*/
+int remover_dataset(Dataset *ds, int id){
+    int pos = posicao_dataset(ds, id);
+    if(pos >= ds->total || ds->itens[pos].id != id){
+        return 0;
+    }
+
+    memmove(&ds->itens[pos], &ds->itens[pos + 1], (ds->total - 1 - pos) * sizeof(Registro));
+    ds->total--;
+    return 1;
+}
+
+/*
+Imprime um registro como uma linha de resultado (id | ano | estado | cultura | valores).
+Parâmetro: r - ponteiro para o registro
+*/
+void imprimir_registro(const Registro *r){
+    printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
+        r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+        r->rendimento, r->producao, r->area_plantada, r->valor_total);
+}
+
+/*
+Grava a linha de cabeçalho do dataset, com os nomes das colunas.
+Parâmetro: arquivo - arquivo de saída já aberto
+*/
+void escrever_cabecalho_csv(FILE *arquivo){
+    fprintf(arquivo, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
+}
+
+/*
+Grava um registro como uma linha do dataset (id;ano;estado;cultura;preco;rendimento;producao;area;valor).
+Parâmetros:
+    arquivo - arquivo de saída já aberto
+    r - ponteiro para o registro a ser gravado
+*/
+void escrever_registro_csv(FILE *arquivo, const Registro *r){
+    fprintf(arquivo, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n",
+        r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+        r->rendimento, r->producao, r->area_plantada, r->valor_total);
+}
+
+/*
+Grava o dataset inteiro no arquivo CSV. Os dados são escritos primeiro em um arquivo
+temporário, levado ao disco e só então trocado pelo original com MoveFileExA, que substitui
+o arquivo existente em uma única operação: uma queda no meio da gravação deixa o CSV antigo
+ou o novo, nunca nenhum dos dois.
+Parâmetros:
+    ds - ponteiro para o dataset
+    nome_arquivo - nome do arquivo de saída (dataset)
+*/
+void salvar_dataset_csv(const Dataset *ds, const char *nome_arquivo){
+    char temporario[300];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", nome_arquivo);
+
+    FILE *arquivo = fopen(temporario, "w");
+    if(!arquivo){
+        printf("Erro ao abrir o arquivo %s\n", temporario);
+        exit(EXIT_FAILURE);
+    }
+
+    escrever_cabecalho_csv(arquivo);
+    int i = 0;
+    for(i; i < ds->total; i++){
+        escrever_registro_csv(arquivo, &ds->itens[i]);
+    }
+
+    if(fflush(arquivo) != 0 || _commit(_fileno(arquivo)) != 0 || fclose(arquivo) != 0){
+        printf("Erro ao gravar o arquivo %s\n", temporario);
+        exit(EXIT_FAILURE);
+    }
+
+    if(!MoveFileExA(temporario, nome_arquivo, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)){
+        printf("Erro ao substituir o arquivo %s\n", nome_arquivo);
+        exit(EXIT_FAILURE);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <stdio.h>
+#include <windows.h>
+#include "dicionario.h"
+
+#define TAM_ESTADO 10
+#define TAM_CULTURA 50
+#define MAX_THREADS_LEITURA 16
+#define TAM_MIN_BLOCO_LEITURA (256 * 1024)
+
+typedef struct Registro{
+    int id;
+    int ano;
+    unsigned short estado;
+    unsigned short cultura;
+    float preco_ton;
+    float rendimento;
+    float producao;
+    float area_plantada;
+    float valor_total;
+} Registro;
+
+typedef struct{
+    Registro *itens;
+    int total;
+    int capacidade;
+} Dataset;
+
+typedef struct{
+    const char *dados;
+    size_t tamanho;
+    HANDLE arquivo;
+    HANDLE mapeamento;
+} ArquivoMapeado;
+
+typedef struct{
+    ArquivoMapeado arquivo;
+    const char *cursor;
+    const char *fim;
+} LeitorCSV;
+
+typedef struct{
+    const char *inicio;
+    const char *fim;
+    Dataset registros;
+} BlocoLeitura;
+
+int mapear_arquivo(ArquivoMapeado *am, const char *nome_arquivo);
+void desmapear_arquivo(ArquivoMapeado *am);
+const char* proxima_linha_csv(const char *p, const char *fim);
+int ler_linha_csv(const char **cursor, const char *fim, Registro *r);
+void abrir_leitor_csv(LeitorCSV *leitor, const char *nome_arquivo);
+int proximo_registro_csv(LeitorCSV *leitor, Registro *r);
+void fechar_leitor_csv(LeitorCSV *leitor);
+
+void iniciar_dataset(Dataset *ds);
+void adicionar_dataset(Dataset *ds, Registro novo);
+void carregar_dataset(Dataset *ds, const char *nome_arquivo);
+int threads_leitura(size_t tamanho);
+void carregar_dataset_paralelo(Dataset *ds, const char *nome_arquivo, int n_threads);
+void ler_registro_usuario(Registro *novo, int id);
+void liberar_dataset(Dataset *ds);
+int dataset_ordenado(const Dataset *ds);
+int posicao_dataset(const Dataset *ds, int id);
+void inserir_ordenado_dataset(Dataset *ds, Registro novo);
+int remover_dataset(Dataset *ds, int id);
+void imprimir_registro(const Registro *r);
+void escrever_cabecalho_csv(FILE *arquivo);
+void escrever_registro_csv(FILE *arquivo, const Registro *r);
+void salvar_dataset_csv(const Dataset *ds, const char *nome_arquivo);
+double bench_vazao_leitura_csv(const char *nome_arquivo, int repeticoes);
+double bench_vazao_leitura_paralela(const char *nome_arquivo, int repeticoes, int n_threads);
+double bench_vazao_leitura_sscanf(const char *nome_arquivo, int repeticoes);
+
+#endif
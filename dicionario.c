@@ -0,0 +1,218 @@
+/*
+->dicionario.c
+Implementação dos dicionários globais de estados e culturas.
+O dataset tem poucas províncias e culturas distintas, repetidas em todas as amostras. Cada
+texto é guardado uma única vez e recebe um código pequeno; os registros guardam apenas os
+códigos, e os filtros comparam inteiros em vez de strings.
+Os códigos diferenciam maiúsculas de minúsculas (o texto é devolvido exatamente como foi lido),
+mas cada código também tem uma classe: o código do primeiro texto igual a ele sem diferenciar
+maiúsculas, usada pelos filtros.
+Os dicionários só crescem. A busca de um texto já existente não usa trava, de modo que as
+threads de leitura do CSV podem internar textos ao mesmo tempo; a inclusão de um texto novo
+é feita sob uma trava simples e publicada com uma troca atômica.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <windows.h>
+#include "dicionario.h"
+#include "dataset.h"
+#include "memoria.h"
+
+Dicionario dicionario_estados = { .largura = TAM_ESTADO };
+Dicionario dicionario_culturas = { .largura = TAM_CULTURA };
+
+/*
+Calcula o hash (FNV-1a) de um texto.
+Parâmetros:
+    texto - caracteres do texto
+    tam - número de caracteres
+Retorno: posição do texto na tabela de baldes do dicionário
+*/
+static int hash_dicionario(const char *texto, int tam){
+    unsigned int h = 2166136261u;
+    int i = 0;
+    for(i; i < tam; i++){
+        h ^= (unsigned char)texto[i];
+        h *= 16777619u;
+    }
+    return (int)(h & (TAM_TABELA_DICIONARIO - 1));
+}
+
+/*
+Procura um texto (com exatamente tam caracteres) em um balde, sem trava.
+Retorno: código do texto, ou -1 se ele não está no balde
+*/
+static int procurar_balde_dicionario(EntradaDicionario *entrada, const char *texto, int tam){
+    while(entrada != NULL){
+        if(strncmp(entrada->texto, texto, tam) == 0 && entrada->texto[tam] == '\0'){
+            return entrada->codigo;
+        }
+        entrada = entrada->prox;
+    }
+    return -1;
+}
+
+/*
+Retorna o código de um texto no dicionário, acrescentando-o se ainda não existir. Textos
+maiores que a largura do dicionário são truncados, como nos antigos campos de tamanho fixo.
+Parâmetros:
+    dicionario - ponteiro para o dicionário
+    texto - texto a ser internado
+Retorno: código do texto
+*/
+int internar_dicionario(Dicionario *dicionario, const char *texto){
+    int tam = 0;
+    while(tam < dicionario->largura - 1 && texto[tam] != '\0'){
+        tam++;
+    }
+    int balde = hash_dicionario(texto, tam);
+
+    int codigo = procurar_balde_dicionario(dicionario->baldes[balde], texto, tam);
+    if(codigo >= 0){
+        return codigo;
+    }
+
+    while(InterlockedCompareExchange(&dicionario->trava, 1, 0) != 0){
+        YieldProcessor();
+    }
+
+    codigo = procurar_balde_dicionario(dicionario->baldes[balde], texto, tam);
+    if(codigo < 0){
+        if(dicionario->total >= MAX_CODIGOS_DICIONARIO){
+            printf("Erro: limite de %d textos distintos no dicionario atingido\n", MAX_CODIGOS_DICIONARIO);
+            exit(EXIT_FAILURE);
+        }
+
+        EntradaDicionario *entrada = (EntradaDicionario*)alocar_memoria(MEMORIA_DICIONARIO, sizeof(EntradaDicionario) + tam + 1);
+        if(!entrada){
+            printf("Erro ao alocar memoria para o dicionario\n");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(entrada->texto, texto, tam);
+        entrada->texto[tam] = '\0';
+        codigo = (int)dicionario->total;
+        entrada->codigo = codigo;
+        entrada->prox = dicionario->baldes[balde];
+
+        int classe = codigo;
+        int i = 0;
+        for(i; i < codigo; i++){
+            if(strcasecmp(dicionario->textos[i], entrada->texto) == 0){
+                classe = dicionario->classes[i];
+                break;
+            }
+        }
+        dicionario->textos[codigo] = entrada->texto;
+        dicionario->classes[codigo] = (unsigned short)classe;
+
+        /* A troca atômica é uma barreira completa: quem encontrar a entrada no balde já
+           enxerga o texto e a classe preenchidos. */
+        InterlockedExchangePointer((PVOID volatile*)&dicionario->baldes[balde], entrada);
+        InterlockedIncrement(&dicionario->total);
+    }
+
+    InterlockedExchange(&dicionario->trava, 0);
+    return codigo;
+}
+
+/*
+Procura um texto no dicionário sem diferenciar maiúsculas de minúsculas.
+Parâmetros:
+    dicionario - ponteiro para o dicionário
+    texto - texto a ser procurado
+Retorno: classe do texto (código do primeiro texto igual a ele), ou -1 se não existir
+*/
+int procurar_dicionario(const Dicionario *dicionario, const char *texto){
+    int total = (int)dicionario->total;
+    int i = 0;
+    for(i; i < total; i++){
+        if(strcasecmp(dicionario->textos[i], texto) == 0){
+            return dicionario->classes[i];
+        }
+    }
+    return -1;
+}
+
+/*
+Converte o texto de um filtro (estado ou cultura) para a forma usada por ACEITA_FILTRO.
+Parâmetros:
+    dicionario - ponteiro para o dicionário
+    texto - texto do filtro (NULL ou vazio para não filtrar)
+Retorno: FILTRO_QUALQUER, FILTRO_NENHUM (texto inexistente) ou a classe do texto
+*/
+int filtro_dicionario(const Dicionario *dicionario, const char *texto){
+    if(texto == NULL || strlen(texto) == 0){
+        return FILTRO_QUALQUER;
+    }
+    int classe = procurar_dicionario(dicionario, texto);
+    return classe < 0 ? FILTRO_NENHUM : classe;
+}
+
+/*
+Retorna o texto correspondente a um código.
+Parâmetros:
+    dicionario - ponteiro para o dicionário
+    codigo - código obtido com internar_dicionario
+Retorno: ponteiro para o texto (válido enquanto o dicionário existir)
+*/
+const char* texto_dicionario(const Dicionario *dicionario, int codigo){
+    if(codigo < 0 || codigo >= dicionario->total){
+        return "";
+    }
+    return dicionario->textos[codigo];
+}
+
+/*
+Retorna a memória ocupada pelo dicionário.
+Parâmetro: dicionario - ponteiro para o dicionário
+Retorno: memória em bytes
+*/
+size_t memoria_dicionario(const Dicionario *dicionario){
+    size_t memoria = sizeof(Dicionario);
+    int i = 0;
+    for(i; i < dicionario->total; i++){
+        memoria += sizeof(EntradaDicionario) + strlen(dicionario->textos[i]) + 1;
+    }
+    return memoria;
+}
+
+/*
+Libera as entradas do dicionário, deixando-o vazio. Os códigos guardados nos registros
+deixam de ser válidos, então só deve ser chamada no encerramento do programa.
+Parâmetro: dicionario - ponteiro para o dicionário
+*/
+void liberar_dicionario(Dicionario *dicionario){
+    int i = 0;
+    for(i; i < TAM_TABELA_DICIONARIO; i++){
+        EntradaDicionario *entrada = dicionario->baldes[i];
+        while(entrada != NULL){
+            EntradaDicionario *proxima = entrada->prox;
+            liberar_memoria(MEMORIA_DICIONARIO, entrada);
+            entrada = proxima;
+        }
+        dicionario->baldes[i] = NULL;
+    }
+    dicionario->total = 0;
+}
+
+/*
+Funções de conveniência para os dois dicionários globais.
+*/
+int codigo_estado(const char *texto){
+    return internar_dicionario(&dicionario_estados, texto);
+}
+
+int codigo_cultura(const char *texto){
+    return internar_dicionario(&dicionario_culturas, texto);
+}
+
+const char* nome_estado(int codigo){
+    return texto_dicionario(&dicionario_estados, codigo);
+}
+
+const char* nome_cultura(int codigo){
+    return texto_dicionario(&dicionario_culturas, codigo);
+}
@@ -0,0 +1,46 @@
+#ifndef DICIONARIO_H
+#define DICIONARIO_H
+
+#include <stdio.h>
+#include <windows.h>
+
+#define MAX_CODIGOS_DICIONARIO 4096
+#define TAM_TABELA_DICIONARIO 1024
+#define FILTRO_QUALQUER -1
+#define FILTRO_NENHUM -2
+
+typedef struct EntradaDicionario{
+    struct EntradaDicionario *volatile prox;
+    int codigo;
+    char texto[];
+} EntradaDicionario;
+
+typedef struct{
+    int largura;
+    volatile long total;
+    volatile long trava;
+    const char *textos[MAX_CODIGOS_DICIONARIO];
+    unsigned short classes[MAX_CODIGOS_DICIONARIO];
+    EntradaDicionario *volatile baldes[TAM_TABELA_DICIONARIO];
+} Dicionario;
+
+extern Dicionario dicionario_estados;
+extern Dicionario dicionario_culturas;
+
+int internar_dicionario(Dicionario *dicionario, const char *texto);
+int procurar_dicionario(const Dicionario *dicionario, const char *texto);
+int filtro_dicionario(const Dicionario *dicionario, const char *texto);
+const char* texto_dicionario(const Dicionario *dicionario, int codigo);
+size_t memoria_dicionario(const Dicionario *dicionario);
+void liberar_dicionario(Dicionario *dicionario);
+
+int codigo_estado(const char *texto);
+int codigo_cultura(const char *texto);
+const char* nome_estado(int codigo);
+const char* nome_cultura(int codigo);
+
+/* Verdadeiro se o código passa no filtro obtido com filtro_dicionario (comparação de inteiros) */
+#define ACEITA_FILTRO(dicionario, codigo, filtro) \
+    ((filtro) == FILTRO_QUALQUER || (dicionario).classes[(codigo)] == (filtro))
+
+#endif
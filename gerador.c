@@ -0,0 +1,217 @@
+/*
+->gerador.c
+Implementação do gerador de datasets sintéticos no formato do Dados.csv, para medir as
+estruturas com milhões de registros a partir do arquivo real de ~10 mil linhas.
+O arquivo real é o modelo: cada linha gerada copia o ano, o estado e a cultura de um registro
+do modelo e varia as grandezas com um fator log-normal de média 1, de modo que a distribuição
+de províncias, culturas e anos e a ordem de grandeza dos valores são as do arquivo real. Os
+registros do modelo são esticados proporcionalmente ao tamanho pedido, então o arquivo gerado
+segue a mesma ordem de anos do original.
+Os IDs podem sair em ordem crescente, embaralhados ou em grupos de IDs consecutivos com os
+grupos embaralhados. O embaralhamento é uma permutação pseudoaleatória calculada por uma rede
+de Feistel, sem vetor de IDs, então o gerador escreve 100 milhões de linhas com a memória do
+modelo apenas.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gerador.h"
+
+static const char *nomes_ordens_gerador[] = {"", "crescente", "embaralhada", "agrupada"};
+
+static unsigned long long estado_aleatorio_gerador = 0x9e3779b97f4a7c15ULL;
+
+/*
+Embaralha os bits de um número (finalizador do splitmix64). Serve de função de rodada da
+permutação e de semeadura do gerador de números aleatórios.
+*/
+static unsigned long long misturar_gerador(unsigned long long x){
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/*
+Sorteia um número em (0, 1) com o xorshift64*, independente de rand() e de RAND_MAX.
+*/
+static double uniforme_gerador(void){
+    unsigned long long x = estado_aleatorio_gerador;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    estado_aleatorio_gerador = x;
+    return ((double)((x * 0x2545f4914f6cdd1dULL) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+/*
+Sorteia um fator log-normal de média 1 e dispersão DISPERSAO_GERADOR (Box-Muller).
+*/
+static double fator_gerador(void){
+    double normal = sqrt(-2.0 * log(uniforme_gerador())) * cos(6.283185307179586 * uniforme_gerador());
+    return exp(DISPERSAO_GERADOR * normal - DISPERSAO_GERADOR * DISPERSAO_GERADOR / 2);
+}
+
+/*
+Arredonda um valor gerado com a precisão do valor do modelo: inteiro se o original era
+inteiro, duas casas decimais caso contrário.
+*/
+static float arredondar_gerador(float original, double valor){
+    if(original == floorf(original)){
+        return (float)floor(valor + 0.5);
+    }
+    return (float)(floor(valor * 100 + 0.5) / 100);
+}
+
+/*
+Retorna o nome de uma ordem de IDs.
+Parâmetro: ordem - ordem dos IDs (ORDEM_IDS_*)
+Retorno: nome da ordem ou "desconhecida"
+*/
+const char* nome_ordem_ids_gerador(int ordem){
+    if(ordem < ORDEM_IDS_CRESCENTE || ordem > ORDEM_IDS_AGRUPADA){
+        return "desconhecida";
+    }
+    return nomes_ordens_gerador[ordem];
+}
+
+/*
+Prepara uma permutação pseudoaleatória de [0, n). O domínio da rede de Feistel é a menor
+potência de quatro que cobre n, então cada valor precisa em média de menos de quatro passagens
+pela rede até cair dentro de [0, n).
+Parâmetros:
+    p - ponteiro para a permutação
+    n - tamanho do intervalo permutado
+    semente - semente das chaves das rodadas
+*/
+void iniciar_permutacao_gerador(PermutacaoGerador *p, unsigned long long n, unsigned long long semente){
+    int bits = 2;
+    while(bits < 64 && (1ULL << bits) < n){
+        bits += 2;
+    }
+    p->bits_metade = bits / 2;
+    p->mascara = (1ULL << p->bits_metade) - 1;
+    p->limite = n;
+    int i = 0;
+    for(i; i < RODADAS_PERMUTACAO_GERADOR; i++){
+        p->chaves[i] = misturar_gerador(semente * RODADAS_PERMUTACAO_GERADOR + i);
+    }
+}
+
+/*
+Aplica a permutação a um valor. Cada passagem pela rede é uma bijeção do domínio inteiro;
+valores que saem fora de [0, n) passam de novo pela rede até voltar ao intervalo, o que mantém
+a bijeção restrita a [0, n).
+Parâmetros:
+    p - ponteiro para a permutação
+    x - valor em [0, n)
+Retorno: posição de x na permutação, em [0, n)
+*/
+unsigned long long permutar_gerador(const PermutacaoGerador *p, unsigned long long x){
+    do{
+        unsigned long long esquerda = x >> p->bits_metade;
+        unsigned long long direita = x & p->mascara;
+        int i = 0;
+        for(i; i < RODADAS_PERMUTACAO_GERADOR; i++){
+            unsigned long long nova = esquerda ^ (misturar_gerador(direita ^ p->chaves[i]) & p->mascara);
+            esquerda = direita;
+            direita = nova;
+        }
+        x = (esquerda << p->bits_metade) | direita;
+    }while(x >= p->limite);
+    return x;
+}
+
+/*
+Gera um arquivo no formato do Dados.csv com n registros sintéticos modelados em um arquivo real.
+Parâmetros:
+    modelo - nome do arquivo real usado como modelo
+    saida - nome do arquivo gerado (não pode ser o próprio modelo)
+    n - número de registros gerados
+    ordem - ordem dos IDs (ORDEM_IDS_CRESCENTE, ORDEM_IDS_EMBARALHADA ou ORDEM_IDS_AGRUPADA)
+    tam_grupo - número de IDs consecutivos de cada grupo na ordem agrupada
+    semente - semente dos sorteios; a mesma semente gera o mesmo arquivo
+Retorno: número de registros escritos, ou 0 se o arquivo não pôde ser criado ou gravado (um
+    arquivo gravado pela metade é apagado)
+*/
+int gerar_dataset_sintetico(const char *modelo, const char *saida, int n, int ordem, int tam_grupo, unsigned int semente){
+    if(strcmp(modelo, saida) == 0){
+        printf("Erro: o arquivo gerado nao pode substituir o modelo %s\n", modelo);
+        return 0;
+    }
+    if(n <= 0){
+        return 0;
+    }
+
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, modelo);
+    if(ds.total == 0){
+        printf("Erro: o arquivo modelo %s nao tem registros\n", modelo);
+        liberar_dataset(&ds);
+        return 0;
+    }
+
+    FILE *arquivo = fopen(saida, "w");
+    if(!arquivo){
+        printf("Erro ao abrir o arquivo %s\n", saida);
+        liberar_dataset(&ds);
+        return 0;
+    }
+    setvbuf(arquivo, NULL, _IOFBF, TAM_BUFFER_GERADOR);
+
+    if(tam_grupo < 1){
+        tam_grupo = TAM_GRUPO_PADRAO_GERADOR;
+    }
+    /* Na ordem agrupada só os grupos completos são embaralhados; o grupo final, incompleto,
+    fica no fim para que nenhum grupo ultrapasse n. */
+    int grupos = n / tam_grupo;
+    PermutacaoGerador permutacao;
+    if(ordem == ORDEM_IDS_EMBARALHADA){
+        iniciar_permutacao_gerador(&permutacao, (unsigned long long)n, semente);
+    }else if(ordem == ORDEM_IDS_AGRUPADA){
+        iniciar_permutacao_gerador(&permutacao, (unsigned long long)(grupos > 0 ? grupos : 1), semente);
+    }
+    estado_aleatorio_gerador = misturar_gerador(~(unsigned long long)semente);
+    if(estado_aleatorio_gerador == 0){
+        estado_aleatorio_gerador = 0x9e3779b97f4a7c15ULL;
+    }
+
+    escrever_cabecalho_csv(arquivo);
+    int i = 0;
+    for(i; i < n; i++){
+        const Registro *base = &ds.itens[(long long)i * ds.total / n];
+        Registro r = *base;
+
+        if(ordem == ORDEM_IDS_EMBARALHADA){
+            r.id = (int)permutar_gerador(&permutacao, (unsigned long long)i) + 1;
+        }else if(ordem == ORDEM_IDS_AGRUPADA && i < grupos * tam_grupo){
+            r.id = (int)permutar_gerador(&permutacao, (unsigned long long)(i / tam_grupo)) * tam_grupo + i % tam_grupo + 1;
+        }else{
+            r.id = i + 1;
+        }
+
+        /* A produção e o valor total acompanham os fatores da área, do rendimento e do preço,
+        preservando as relações entre as colunas do registro modelo. */
+        double fator_area = fator_gerador();
+        double fator_rendimento = fator_gerador();
+        double fator_preco = fator_gerador();
+        r.area_plantada = arredondar_gerador(base->area_plantada, base->area_plantada * fator_area);
+        r.rendimento = arredondar_gerador(base->rendimento, base->rendimento * fator_rendimento);
+        r.preco_ton = arredondar_gerador(base->preco_ton, base->preco_ton * fator_preco);
+        r.producao = arredondar_gerador(base->producao, base->producao * fator_area * fator_rendimento);
+        r.valor_total = arredondar_gerador(base->valor_total, base->valor_total * fator_area * fator_rendimento * fator_preco);
+
+        escrever_registro_csv(arquivo, &r);
+    }
+
+    liberar_dataset(&ds);
+    if(fclose(arquivo) != 0){
+        printf("Erro ao gravar o arquivo %s\n", saida);
+        remove(saida);
+        return 0;
+    }
+    return n;
+}
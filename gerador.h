@@ -0,0 +1,28 @@
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <stdio.h>
+#include "dataset.h"
+
+#define ORDEM_IDS_CRESCENTE 1
+#define ORDEM_IDS_EMBARALHADA 2
+#define ORDEM_IDS_AGRUPADA 3
+
+#define TAM_GRUPO_PADRAO_GERADOR 1024
+#define DISPERSAO_GERADOR 0.15
+#define RODADAS_PERMUTACAO_GERADOR 4
+#define TAM_BUFFER_GERADOR (1 << 20)
+
+typedef struct{
+    unsigned long long chaves[RODADAS_PERMUTACAO_GERADOR];
+    unsigned long long mascara;
+    unsigned long long limite;
+    int bits_metade;
+} PermutacaoGerador;
+
+const char* nome_ordem_ids_gerador(int ordem);
+void iniciar_permutacao_gerador(PermutacaoGerador *p, unsigned long long n, unsigned long long semente);
+unsigned long long permutar_gerador(const PermutacaoGerador *p, unsigned long long x);
+int gerar_dataset_sintetico(const char *modelo, const char *saida, int n, int ordem, int tam_grupo, unsigned int semente);
+
+#endif
@@ -2,8 +2,8 @@
 ->hash.c
 Implementação de uma tabela hash simples para manipulação de amostras agrícolas.
 Este arquivo contém as funções para inserir, remover, buscar, filtrar, imprimir 
-e carregar dados em uma lista encadeada simples, além de funções auxiliares
-e do conjunto de nove funções para benchamark.
+e carregar dados em uma tabela hash, além de funções auxiliares e das primitivas
+usadas pelo modo benchmark (bench.c).
 */
 
 #include <stdio.h>
@@ -13,70 +13,161 @@ e do conjunto de nove funções para benchamark.
 #include <time.h>
 #include <windows.h>
 #include "hash.h"
+#include "memoria.h"
 
 /*
-Inicializa a tabela hash, definindo todos os ponteiros como NULL.
+Aloca um vetor de baldes vazios.
+Parâmetro: tamanho - número de baldes (potência de 2)
+Retorno: ponteiro para o vetor de baldes
+*/
+static ItemHash** alocar_baldes_hash(int tamanho){
+    ItemHash **baldes = (ItemHash**)alocar_zerada_memoria(MEMORIA_HASH, tamanho, sizeof(ItemHash*));
+    if(!baldes){
+        printf("Erro ao alocar memoria para a tabela hash\n");
+        exit(EXIT_FAILURE);
+    }
+    return baldes;
+}
+
+/*
+Inicializa a tabela hash vazia, com TAM_INICIAL_HASH baldes. A tabela cresce sozinha
+conforme os elementos são inseridos.
 Parâmetro: th - ponteiro para a tabela hash
 */
 void iniciar_hash(TabelaHash *th){
-    int i = 0;
-    for(i; i < TAM; i++){
-        th->tabela[i] = NULL;
-    }
+    th->tamanho = TAM_INICIAL_HASH;
+    th->tabela = alocar_baldes_hash(th->tamanho);
+    th->nova = NULL;
+    th->tamanho_nova = 0;
+    th->proximo_rehash = 0;
+    th->total = 0;
 }
+
 /*
-Calcula o índice da tabela hash a partir do ID.
-Parâmetro:id - identificador inteiro
+Calcula o índice do balde a partir do ID. Os bits do ID são misturados antes de aplicar a
+máscara, para que IDs com padrões regulares (múltiplos de potências de 2, por exemplo) se
+espalhem por todos os baldes.
+Parâmetros:
+    id - identificador inteiro
+    tamanho - número de baldes da tabela (potência de 2)
 Retorno: índice correspondente na tabela hash (inteiro)
 */
-int funcao_hash(int id){
-    return id % TAM;
+int funcao_hash(int id, int tamanho){
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x45d9f3bU;
+    x ^= x >> 16;
+    return (int)(x & (unsigned int)(tamanho - 1));
 }
 
 /*
-Insere um novo elemento na tabela hash.
+Migra para a tabela nova alguns baldes da tabela antiga. Quando todos os baldes foram
+migrados, a tabela nova passa a ser a tabela atual e o rehash termina.
 Parâmetros:
     tabela - ponteiro para a tabela hash
-    novo - estrutura com os dados a serem inseridos
+    baldes - número máximo de baldes a migrar
+*/
+static void passo_rehash_hash(TabelaHash *tabela, int baldes){
+    if(tabela->nova == NULL){
+        return;
+    }
+
+    while(baldes > 0 && tabela->proximo_rehash < tabela->tamanho){
+        ItemHash *atual = tabela->tabela[tabela->proximo_rehash];
+        while(atual != NULL){
+            ItemHash *proximo = atual->prox;
+            int indice = funcao_hash(atual->id, tabela->tamanho_nova);
+            atual->prox = tabela->nova[indice];
+            tabela->nova[indice] = atual;
+            atual = proximo;
+        }
+        tabela->tabela[tabela->proximo_rehash] = NULL;
+        tabela->proximo_rehash++;
+        baldes--;
+    }
+
+    if(tabela->proximo_rehash == tabela->tamanho){
+        liberar_memoria(MEMORIA_HASH, tabela->tabela);
+        tabela->tabela = tabela->nova;
+        tabela->tamanho = tabela->tamanho_nova;
+        tabela->nova = NULL;
+        tabela->tamanho_nova = 0;
+        tabela->proximo_rehash = 0;
+    }
+}
+
+/*
+Termina de uma vez um rehash em andamento. Deve ser chamada antes de percorrer todos os
+baldes da tabela, para que todos os elementos estejam em tabela->tabela.
+Parâmetro: tabela - ponteiro para a tabela hash
 */
-void inserir_tabela_hash(TabelaHash *tabela, ItemHash novo){
-    int indice = funcao_hash(novo.id);
+void concluir_rehash_hash(TabelaHash *tabela){
+    if(tabela->nova != NULL){
+        passo_rehash_hash(tabela, tabela->tamanho - tabela->proximo_rehash);
+    }
+}
 
-    ItemHash *elemento = (ItemHash*)malloc(sizeof(ItemHash));
+/*
+Inicia o crescimento da tabela quando o fator de carga passa de FATOR_CARGA_MAX_HASH.
+A tabela nova tem o dobro de baldes e os elementos são migrados aos poucos, alguns baldes
+por operação, de modo que nenhuma inserção pague sozinha o custo de redistribuir a tabela.
+Como cada inserção migra ao menos um balde, o rehash termina antes de a tabela nova atingir
+o limite de carga.
+Parâmetro: tabela - ponteiro para a tabela hash
+*/
+static void verificar_crescimento_hash(TabelaHash *tabela){
+    if(tabela->nova != NULL || tabela->total <= tabela->tamanho * FATOR_CARGA_MAX_HASH){
+        return;
+    }
+
+    tabela->tamanho_nova = tabela->tamanho * 2;
+    tabela->nova = alocar_baldes_hash(tabela->tamanho_nova);
+    tabela->proximo_rehash = 0;
+}
+
+/*
+Insere um novo elemento na tabela hash. O elemento guarda apenas o ID e o ponteiro para o
+registro, que pertence ao armazém de registros. Durante um rehash o elemento vai direto
+para a tabela nova.
+Parâmetros:
+    tabela - ponteiro para a tabela hash
+    registro - ponteiro para o registro a ser indexado
+*/
+void inserir_tabela_hash(TabelaHash *tabela, Registro *registro){
+    passo_rehash_hash(tabela, BALDES_POR_PASSO_HASH);
+
+    ItemHash *elemento = (ItemHash*)alocar_memoria(MEMORIA_HASH, sizeof(ItemHash));
     if(!elemento){
         printf("Erro ao alocar memoria\n");
         exit(EXIT_FAILURE);
     }
 
-    elemento->id = novo.id;
-    elemento->ano = novo.ano;
-    strncpy(elemento->estado, novo.estado, sizeof(elemento->estado));
-    elemento->estado[sizeof(elemento->estado) - 1] = '\0';
-    strncpy(elemento->cultura, novo.cultura, sizeof(elemento->cultura));
-    elemento->cultura[sizeof(elemento->cultura) - 1] = '\0';
-    strncpy(elemento->cultura, novo.cultura, sizeof(elemento->cultura));
-    elemento->cultura[sizeof(elemento->cultura) - 1] = '\0';
-    elemento->preco_ton = novo.preco_ton;
-    elemento->rendimento = novo.rendimento;
-    elemento->producao = novo.producao;
-    elemento->area_plantada = novo.area_plantada;
-    elemento->valor_total = novo.valor_total;
-
-    elemento->prox = tabela->tabela[indice];
-    tabela->tabela[indice] = elemento;  
+    elemento->id = registro->id;
+    elemento->registro = registro;
 
+    if(tabela->nova != NULL){
+        int indice = funcao_hash(registro->id, tabela->tamanho_nova);
+        elemento->prox = tabela->nova[indice];
+        tabela->nova[indice] = elemento;
+    }else{
+        int indice = funcao_hash(registro->id, tabela->tamanho);
+        elemento->prox = tabela->tabela[indice];
+        tabela->tabela[indice] = elemento;
+    }
+    tabela->total++;
+
+    verificar_crescimento_hash(tabela);
 }
 
 /*
-Busca um elemento pelo ID na tabela hash.
+Procura um ID em um balde.
 Parâmetros:
-    tabela - ponteiro para a tabela hash
+    balde - primeiro elemento do balde
     id - identificador a ser buscado
 Retorno: ponteiro para o item encontrado ou NULL
 */
-ItemHash* buscar_tabela_hash(TabelaHash *tabela, int id){
-    int indice = funcao_hash(id);
-    ItemHash *atual = tabela->tabela[indice];
+static ItemHash* buscar_balde_hash(ItemHash *balde, int id){
+    ItemHash *atual = balde;
     while (atual != NULL){
         if(atual->id == id){
             return atual;
@@ -87,25 +178,42 @@ ItemHash* buscar_tabela_hash(TabelaHash *tabela, int id){
 }
 
 /*
-Remove um elemento da tabela hash pelo ID.
+Busca um elemento pelo ID na tabela hash. Durante um rehash o elemento pode estar em
+qualquer uma das duas tabelas.
 Parâmetros:
     tabela - ponteiro para a tabela hash
+    id - identificador a ser buscado
+Retorno: ponteiro para o item encontrado ou NULL
+*/
+ItemHash* buscar_tabela_hash(TabelaHash *tabela, int id){
+    passo_rehash_hash(tabela, BALDES_POR_PASSO_HASH);
+
+    ItemHash *encontrado = buscar_balde_hash(tabela->tabela[funcao_hash(id, tabela->tamanho)], id);
+    if(encontrado == NULL && tabela->nova != NULL){
+        encontrado = buscar_balde_hash(tabela->nova[funcao_hash(id, tabela->tamanho_nova)], id);
+    }
+    return encontrado;
+}
+
+/*
+Remove um elemento de um balde pelo ID.
+Parâmetros:
+    balde - ponteiro para o primeiro elemento do balde
     id - identificador do item a ser removido
 Retorno: 1 se removido, 0 se não encontrado
 */
-int remover_tabela_hash(TabelaHash *tabela, int id){
-    int indice = funcao_hash(id);
-    ItemHash *atual = tabela->tabela[indice];
+static int remover_balde_hash(ItemHash **balde, int id){
+    ItemHash *atual = *balde;
     ItemHash *anterior = NULL;
 
     while(atual != NULL){
         if(atual->id == id){
             if(anterior == NULL){
-                tabela->tabela[indice] = atual->prox;
+                *balde = atual->prox;
             } else{
                 anterior->prox = atual->prox;
             }
-            free(atual);
+            liberar_memoria(MEMORIA_HASH, atual);
             return 1;
         }
         anterior = atual;
@@ -115,20 +223,46 @@ int remover_tabela_hash(TabelaHash *tabela, int id){
 }
 
 /*
-Libera toda a memória alocada pela tabela hash.
+Remove um elemento da tabela hash pelo ID.
+Parâmetros:
+    tabela - ponteiro para a tabela hash
+    id - identificador do item a ser removido
+Retorno: 1 se removido, 0 se não encontrado
+*/
+int remover_tabela_hash(TabelaHash *tabela, int id){
+    passo_rehash_hash(tabela, BALDES_POR_PASSO_HASH);
+
+    int removido = remover_balde_hash(&tabela->tabela[funcao_hash(id, tabela->tamanho)], id);
+    if(!removido && tabela->nova != NULL){
+        removido = remover_balde_hash(&tabela->nova[funcao_hash(id, tabela->tamanho_nova)], id);
+    }
+    if(removido){
+        tabela->total--;
+    }
+    return removido;
+}
+
+/*
+Libera toda a memória alocada pela tabela hash, inclusive os vetores de baldes. Para
+reutilizar a tabela é preciso chamar iniciar_hash novamente.
 Parâmetro: tabela - ponteiro para a tabela hash
 */
 void liberar_tabela_hash(TabelaHash *tabela){
+    concluir_rehash_hash(tabela);
+
     int i = 0;
-    for(i; i < TAM; i++){
+    for(i; i < tabela->tamanho; i++){
         ItemHash *atual = tabela->tabela[i];
         while(atual != NULL){
             ItemHash *proximo = atual->prox;
-            free(atual);
+            liberar_memoria(MEMORIA_HASH, atual);
             atual = proximo;
         }
-        tabela->tabela[i] = NULL;
     }
+    liberar_memoria(MEMORIA_HASH, tabela->tabela);
+    tabela->tabela = NULL;
+    tabela->tamanho = 0;
+    tabela->total = 0;
 }
 
 /*
@@ -136,16 +270,18 @@ Imprime todos os elementos da tabela hash.
 Parâmetro: tabela - ponteiro para a tabela hash
 */
 void imprimir_tabela_hash(TabelaHash *tabela){
+    concluir_rehash_hash(tabela);
     int i = 0;
-    for(i; i < TAM; i++){
+    for(i; i < tabela->tamanho; i++){
         ItemHash *atual = tabela->tabela[i];
         if(atual != NULL){
             printf("Indice %d:\n");
             while(atual != NULL){
+                const Registro *r = atual->registro;
                 printf("  ID: %d | Ano: %d | Estado: %s | Cultura: %s | Preço/Ton: %.2f | Rendimento: %.2f | Produção: %.2f | Área: %.2f | Valor Total: %.2f\n",
-                       atual->id, atual->ano, atual->estado, atual->cultura,
-                       atual->preco_ton, atual->rendimento, atual->producao,
-                       atual->area_plantada, atual->valor_total);
+                       r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura),
+                       r->preco_ton, r->rendimento, r->producao,
+                       r->area_plantada, r->valor_total);
                 atual = atual->prox;    
             }
         }
@@ -153,103 +289,45 @@ void imprimir_tabela_hash(TabelaHash *tabela){
 }
 
 /*
-Carrega o dataset e insere na tabela hash.
+Carrega o dataset e insere na tabela hash. Os registros passam a pertencer ao armazém.
 Parâmetros:
     tabela - ponteiro para a tabela hash
+    armazem - ponteiro para o armazém que recebe os registros
     nome_arquivo - nome do arquivo de entrada (dataset)
 */
-void carregar_dados_hash(TabelaHash *tabela, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo %s\n", nome_arquivo);
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    while (fgets(linha, sizeof(linha), arquivo)){
-        ItemHash novo;
-
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao,
-            &novo.area_plantada, &novo.valor_total);
-        novo.prox = NULL;
-        
-        inserir_tabela_hash(tabela, novo);
-    }
-
-    fclose(arquivo);
+void carregar_dados_hash(TabelaHash *tabela, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_hash(tabela, &ds);
+    adotar_dataset_armazem(armazem, &ds);
 }
 
 /*
-Salva todos os elementos da tabela hash em um arquivo (dataset).
+Indexa na tabela hash todos os registros de um dataset já carregado em memória. O vetor
+do dataset deve permanecer alocado (normalmente transferido para o armazém de registros).
 Parâmetros:
     tabela - ponteiro para a tabela hash
-    nome_arquivo - nome do arquivo de saída (dataset)
+    ds - ponteiro para o dataset com os registros
 */
-void salvar_dados_hash(TabelaHash *tabela, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "w");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(arquivo, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
-
+void carregar_registros_hash(TabelaHash *tabela, Dataset *ds){
     int i = 0;
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela->tabela[i];
-        while (atual != NULL){
-            fprintf(arquivo, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n", atual->id, atual->ano, atual->estado, 
-                atual->cultura, atual->preco_ton, atual->rendimento, atual->producao, atual->area_plantada, 
-                atual->valor_total);
-
-            atual = atual->prox;
-        }
+    for (i; i < ds->total; i++){
+        inserir_tabela_hash(tabela, &ds->itens[i]);
     }
-
-    fclose(arquivo);
 }
 
 /*
 Cria uma nova amostra a partir da entrada do usuário e insere na tabela hash.
-Parâmetro: tabela - ponteiro para a tabela hash
+Parâmetros:
+    tabela - ponteiro para a tabela hash
+    armazem - ponteiro para o armazém que recebe o novo registro
 */
-void criar_amostra_hash(TabelaHash *tabela){
-    ItemHash nova;
-
-    nova.id = proximo_id_hash(tabela);
-    
-    printf("\n===Insira os dados da nova amostra===\n");
-
-    printf("Ano: ");
-    scanf("%d", &nova.ano);
-
-    printf("Estado: ");
-    scanf("%9s", nova.estado);
-
-    printf("Cultura: ");
-    scanf(" %[^\n]", nova.cultura);
-
-    printf("Preco por tonelada: ");
-    scanf("%f", &nova.preco_ton);
+void criar_amostra_hash(TabelaHash *tabela, ArmazemRegistros *armazem){
+    Registro nova;
+    ler_registro_usuario(&nova, proximo_id_hash(tabela));
 
-    printf("Rendimento: ");
-    scanf("%f", &nova.rendimento);
-
-    printf("Producao: ");
-    scanf("%f", &nova.producao);
-
-    printf("Area plantada: ");
-    scanf("%f", &nova.area_plantada);
-
-    printf("Valor total: ");
-    scanf("%f", &nova.valor_total);
-
-    nova.prox = NULL;
-
-    inserir_tabela_hash(tabela, nova);
+    inserir_tabela_hash(tabela, adicionar_armazem(armazem, &nova));
 
     printf("Amostra inserida com sucesso!\n");
 }
@@ -263,7 +341,8 @@ int proximo_id_hash(TabelaHash *tabela){
     int maior = 0;
     int i = 0;
 
-    for (i; i < TAM; i++){
+    concluir_rehash_hash(tabela);
+    for (i; i < tabela->tamanho; i++){
         ItemHash *atual = tabela->tabela[i];
         while (atual != NULL){
             if (atual->id > maior){
@@ -276,38 +355,56 @@ int proximo_id_hash(TabelaHash *tabela){
 }
 
 /*
-Busca e imprime elementos que atendem aos filtros de ano, estado e cultura.
+Imprime uma linha do resultado de buscar_filtros_hash.
+Parâmetro: r - ponteiro para o registro
+*/
+static void imprimir_resultado_hash(const Registro *r){
+    printf("ID: %d | Ano: %d | Estado: %s | Cultura: %s | Preço/Ton: %.2f | Rendimento: %.2f | Produção: %.2f | Área: %.2f | Valor Total: %.2f\n",
+           r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura),
+           r->preco_ton, r->rendimento, r->producao,
+           r->area_plantada, r->valor_total);
+}
+
+/*
+Busca e imprime elementos que atendem aos filtros de ano, estado e cultura, percorrendo a
+tabela ou, quando há índice de bitmaps, consultando o índice.
 Parâmetros:
-  cabeca - ponteiro para a cabeça da lista
+  tabela - ponteiro para a tabela hash
   ano_min, ano_max - intervalo de anos
   cultura - filtro de cultura (string)
   estado - filtro de estado (string)
+  indice - índice de bitmaps sobre os mesmos registros, ou NULL para percorrer a tabela
 */
-void buscar_filtros_hash(TabelaHash *tabela, int ano_min, int ano_max, const char *estado, const char *cultura){
+void buscar_filtros_hash(TabelaHash *tabela, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice){
     int encontrados = 0;
     int i = 0;
 
     printf("\n===RESULTADOS DA BUSCA===\n");
 
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela->tabela[i];
-        while (atual != NULL){
-            int ano_certo = (atual->ano >= ano_min) && (atual->ano <= ano_max);
+    if (indice != NULL){
+        encontrados = imprimir_filtro_indice_bitmap(indice, ano_min, ano_max, estado, cultura, imprimir_resultado_hash);
+    } else{
+        int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+        int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
 
-            int estado_certo = (estado == NULL || strlen(estado) == 0 || strcasecmp(atual->estado, estado) == 0);
+        concluir_rehash_hash(tabela);
+        for (i; i < tabela->tamanho; i++){
+            ItemHash *atual = tabela->tabela[i];
+            while (atual != NULL){
+                const Registro *r = atual->registro;
+                int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
 
-            int cultura_certo = (cultura == NULL || strlen(cultura) == 0 || strcasecmp(atual->cultura, cultura) == 0);
+                int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, filtro_estado);
 
-            if (ano_certo && estado_certo && cultura_certo){
-                printf("ID: %d | Ano: %d | Estado: %s | Cultura: %s | Preço/Ton: %.2f | Rendimento: %.2f | Produção: %.2f | Área: %.2f | Valor Total: %.2f\n",
-                       atual->id, atual->ano, atual->estado, atual->cultura,
-                       atual->preco_ton, atual->rendimento, atual->producao,
-                       atual->area_plantada, atual->valor_total);
+                int cultura_certo = ACEITA_FILTRO(dicionario_culturas, r->cultura, filtro_cultura);
 
-                encontrados++;
-            }
+                if (ano_certo && estado_certo && cultura_certo){
+                    imprimir_resultado_hash(r);
+                    encontrados++;
+                }
 
-            atual = atual->prox;
+                atual = atual->prox;
+            }
         }
     }
 
@@ -319,489 +416,39 @@ void buscar_filtros_hash(TabelaHash *tabela, int ano_min, int ano_max, const cha
 }
 
 /*
-Mede o tempo de inserção de n elementos na tabela hash a partir de um arquivo (dataset).
+Procura um ID em um balde visitando no máximo os elementos que restam do limite.
 Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_insercao_hash(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-
-    fgets(linha, sizeof(linha), arquivo);
-
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-
-    int total = 0;
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    while (fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemHash novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao, 
-            &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_tabela_hash(&tabela, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    liberar_tabela_hash(&tabela);
-    fclose(arquivo);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de remoção de n elementos da tabela hash.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_remocao_hash(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    carregar_dados_hash(&tabela, nome_arquivo);
-
-    int *ids = (int*) malloc(n * sizeof(int));
-    if (!ids){
-        printf("Erro ao alocar memória para IDs\n");
-        liberar_tabela_hash(&tabela);
-        return -1;
-    }
-
-    int total_ids = 0;
-    int i = 0;
-
-    for (i; i < TAM && total_ids < n; i++){
-        ItemHash *atual = tabela.tabela[i];
-       
-        while (atual != NULL && total_ids < n){
-            ids[total_ids] = atual->id;
-            atual = atual->prox;
-            total_ids++;
-        }
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int j = 0;
-    for (j; j < total_ids; j++){
-        remover_tabela_hash(&tabela, ids[j]);
-    }
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    liberar_tabela_hash(&tabela);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos na tabela hash.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de buscas a serem realizadas
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_tempo_busca_hash(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    carregar_dados_hash(&tabela, nome_arquivo);
-
-    int *ids_existentes = malloc(30000 * sizeof(int));
-    if (!ids_existentes){
-        printf("Erro ao alocar memória para IDs\n");
-        liberar_tabela_hash(&tabela);
-        return -1;
-    }
-
-    int total_ids = 0;
-    int i = 0;
-
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela.tabela[i];
-        while (atual){
-            ids_existentes[total_ids] = atual->id;
-            atual = atual->prox;
-            total_ids++;
-        }
-    }
-
-    if (total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids_existentes);
-        liberar_tabela_hash(&tabela);
-        return 0;
-    }
-
-    int num_buscas = n;
-    if (n > total_ids){
-        num_buscas = total_ids;
-        printf("Aviso: número de buscas ajustado para %d (total de IDs carregados)\n", num_buscas);
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int j = 0;
-    for (j; j < num_buscas; j++){
-        int idx = rand() % total_ids; 
-        int id_buscado = ids_existentes[idx];
-        buscar_tabela_hash(&tabela, id_buscado);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    tempo = tempo/4;
-
-    free(ids_existentes);
-    liberar_tabela_hash(&tabela);
-
-    return tempo;
-}
-
-/*
-Mede o uso de memoria de n elementos do dataset na tabela hash.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: memória utilizada (bytes)
-*/
-size_t bench_uso_memoria_hash(const char *nome_arquivo, int n){
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-    int total = 0;
-
-    while (fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemHash novo;
-
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-            novo.prox = NULL;
-        inserir_tabela_hash(&tabela, novo);
-        total++;
-    }
-    fclose(arquivo);
-
-    int cont = 0;
-    int i = 0;
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela.tabela[i];
-        while (atual != NULL){
-            cont++;
-            atual = atual->prox;
-        }
-    }
-
-    size_t uso_memoria = cont * sizeof(ItemHash);
-    liberar_tabela_hash(&tabela);
-    return uso_memoria;
-}
-
-/*
-Mede o tempo de inserção com memória restrita de n elementos do dataset na tabela hash.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  lim_memoria - limite de memória a ser utilizada
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_mem_restrita_hash(const char *nome_arquivo, double lim_memoria_mb){
-    struct timespec inicio, fim;
-    size_t lim_bytes = (size_t)(lim_memoria_mb * 1024 * 1024);
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    size_t memoria_usada = 0;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while (fgets(linha, sizeof(linha), arquivo)){
-        if (memoria_usada + sizeof(ItemHash) > lim_bytes){
-            printf("\nLimite de memoria atingido apos %d elementos\n", total);
-            break;
-        }
-
-        ItemHash novo;
-        int campos = sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_tabela_hash(&tabela, novo);
-        memoria_usada += sizeof(ItemHash);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    fclose(arquivo);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    liberar_tabela_hash(&tabela);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de inserção com delay de n elementos do dataset na tabela hash.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  delay_ms - tempo em milisegundos a ser aplicado como delay
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_com_delay_hash(const char *nome_arquivo, int n, int delay_ms){
-    struct timespec inicio, fim;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while (fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemHash novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_tabela_hash(&tabela, novo);
-        Sleep(delay_ms);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    fclose(arquivo);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    liberar_tabela_hash(&tabela);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca com latência de n elementos do dataset na tabela hash.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_latencia_hash(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    carregar_dados_hash(&tabela, nome_arquivo);
-
-    int *ids_existentes = malloc(30000 * sizeof(int));
-    if (!ids_existentes){
-        printf("Erro ao alocar memória para IDs\n");
-        liberar_tabela_hash(&tabela);
-        return -1;
-    }
-
-    int total_ids = 0;
-    int i = 0;
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela.tabela[i];
-        while (atual) {
-            ids_existentes[total_ids++] = atual->id;
-            atual = atual->prox;
-        }
-    }
-
-    if (total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids_existentes);
-        liberar_tabela_hash(&tabela);
-        return 0;
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int j = 0;
-    for (j; j < n; j++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids_existentes[idx];
-        buscar_tabela_hash(&tabela, id_buscado);
-
-        int delay = 2 + rand() % 8;
-        Sleep(delay);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    free(ids_existentes);
-    liberar_tabela_hash(&tabela);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    return tempo;
-}
-
-/*
-Mede o tempo de isnerção de n elementos do dataset, com perda, na tabela hash.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
+    balde - primeiro elemento do balde
+    id - identificador a ser buscado
+    acessos - contador de elementos visitados (atualizado pela função)
+    lim - número máximo de elementos visitados
+Retorno: ponteiro para o item encontrado ou NULL
 */
-double bench_tempo_insercao_perda_hash(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-
-    int total = 0;
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while (fgets(linha, sizeof(linha), arquivo) && total < n){
-        if ((rand() % 100) < 20){
-            continue;
+static ItemHash* buscar_balde_lim_hash(ItemHash *balde, int id, int *acessos, int lim){
+    while(balde != NULL && *acessos < lim){
+        if(balde->id == id){
+            return balde;
         }
-
-        ItemHash novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_tabela_hash(&tabela, novo);
-        total++;
+        balde = balde->prox;
+        (*acessos)++;
     }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    fclose(arquivo);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    liberar_tabela_hash(&tabela);
-
-    return tempo;
+    return NULL;
 }
 
 /*
-Mede o tempo de busca de n elementos do dataset na tabela hash.
+Busca um ID visitando no máximo lim elementos. Durante um rehash o limite vale para os
+dois baldes somados.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-  lim - limite de acessos
-Retorno: tempo gasto em segundos (double)
+    tabela - ponteiro para a tabela hash
+    id - identificador a ser buscado
+    lim - número máximo de elementos visitados
+Retorno: ponteiro para o item encontrado ou NULL se o limite acabar antes
 */
-double bench_busca_lim_acessos_hash(const char *nome_arquivo, int n, int lim){
-    struct timespec inicio, fim;
-
-    TabelaHash tabela;
-    iniciar_hash(&tabela);
-    carregar_dados_hash(&tabela, nome_arquivo);
-
-    int *ids_existentes = malloc(30000 * sizeof(int)); 
-    if (!ids_existentes){
-        printf("Erro ao alocar memória para IDs\n");
-        liberar_tabela_hash(&tabela);
-        return -1;
-    }
-
-    int total_ids = 0;
-    int i = 0;
-    for (i; i < TAM; i++){
-        ItemHash *atual = tabela.tabela[i];
-        while (atual){
-            ids_existentes[total_ids++] = atual->id;
-            atual = atual->prox;
-        }
-    }
-
-    if (total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids_existentes);
-        liberar_tabela_hash(&tabela);
-        return 0;
+ItemHash* buscar_lim_acessos_hash(TabelaHash *tabela, int id, int lim){
+    int acessos = 0;
+    ItemHash *encontrado = buscar_balde_lim_hash(tabela->tabela[funcao_hash(id, tabela->tamanho)], id, &acessos, lim);
+    if(encontrado == NULL && tabela->nova != NULL){
+        encontrado = buscar_balde_lim_hash(tabela->nova[funcao_hash(id, tabela->tamanho_nova)], id, &acessos, lim);
     }
-
-    srand((unsigned int)time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int j = 0;
-    for (j; j < n; j++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids_existentes[idx];
-
-        int indice = funcao_hash(id_buscado);
-        ItemHash *ptr = tabela.tabela[indice];
-        int acessos = 0;
-        while (ptr != NULL && acessos < lim){
-            if (ptr->id == id_buscado) {
-                break;
-            }
-            ptr = ptr->prox;
-            acessos++;
-        }
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    free(ids_existentes);
-    liberar_tabela_hash(&tabela);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    return tempo;
+    return encontrado;
 }
@@ -3,49 +3,44 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "dataset.h"
+#include "registros.h"
+#include "indice_bitmap.h"
 
-#define TAM 2011
+#define TAM_INICIAL_HASH 16
+#define FATOR_CARGA_MAX_HASH 1
+#define BALDES_POR_PASSO_HASH 4
 
 struct ElementoHash{
     int id;
-    int ano;
-    char estado[10];
-    char cultura[50];
-    float preco_ton;
-    float rendimento;
-    float producao;
-    float area_plantada;
-    float valor_total;
+    Registro *registro;
     struct ElementoHash *prox;
 };
 
 typedef struct ElementoHash ItemHash;
 
 typedef struct {
-    ItemHash* tabela[TAM];
+    ItemHash **tabela;
+    int tamanho;
+    ItemHash **nova;
+    int tamanho_nova;
+    int proximo_rehash;
+    int total;
 } TabelaHash;
 
 void iniciar_hash(TabelaHash *th);
-int funcao_hash(int id);
-void inserir_tabela_hash(TabelaHash *tabela, ItemHash novo);
+int funcao_hash(int id, int tamanho);
+void concluir_rehash_hash(TabelaHash *tabela);
+void inserir_tabela_hash(TabelaHash *tabela, Registro *registro);
 ItemHash* buscar_tabela_hash(TabelaHash *tabela, int id);
 int remover_tabela_hash(TabelaHash *tabela, int id);
 void liberar_tabela_hash(TabelaHash *tabela);
 void imprimir_tabela_hash(TabelaHash *tabela);
-void carregar_dados_hash(TabelaHash *tabela, const char *nome_arquivo);
-void salvar_dados_hash(TabelaHash *tabela, const char *nome_arquivo);
-void criar_amostra_hash(TabelaHash *tabela);
+void buscar_filtros_hash(TabelaHash *tabela, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice);
+void carregar_dados_hash(TabelaHash *tabela, ArmazemRegistros *armazem, const char *nome_arquivo);
+void carregar_registros_hash(TabelaHash *tabela, Dataset *ds);
+void criar_amostra_hash(TabelaHash *tabela, ArmazemRegistros *armazem);
 int proximo_id_hash(TabelaHash *tabela);
-double bench_tempo_insercao_hash(const char *nome_arquivo, int n);
-double bench_tempo_remocao_hash(const char *nome_arquivo, int n);
-double bench_tempo_busca_hash(const char *nome_arquivo, int n);
-size_t bench_uso_memoria_hash(const char *nome_arquivo, int n);
-double bench_insercao_mem_restrita_hash(const char *nome_arquivo, double lim_memoria_mb);
-double bench_insercao_com_delay_hash(const char *nome_arquivo, int n, int delay_ms);
-double bench_busca_latencia_hash(const char *nome_arquivo, int n);
-double bench_tempo_insercao_perda_hash(const char *nome_arquivo, int n);
-double bench_busca_lim_acessos_hash(const char *nome_arquivo, int n, int lim);
-
-
+ItemHash* buscar_lim_acessos_hash(TabelaHash *tabela, int id, int lim);
 
 #endif
@@ -0,0 +1,365 @@
+/*
+->hash_aberto.c
+Implementação de uma tabela hash de endereçamento aberto para manipulação de amostras agrícolas,
+no estilo SwissTable. Cada posição tem um byte de controle, guardado em um vetor separado:
+vazio, apagado ou os 7 bits baixos do hash do ID. A busca compara 16 bytes de controle de uma vez
+(com SSE2, quando disponível) e só olha os IDs das posições cujo byte coincide. Os IDs e os
+ponteiros para os registros ficam em vetores separados (estrutura de vetores), de modo que uma
+busca percorre memória contígua em vez de seguir ponteiros de nós espalhados pelo heap.
+As remoções marcam a posição como apagada (tombstone), a menos que o grupo ainda tenha
+posições vazias. Este arquivo também contém as primitivas usadas pelo modo benchmark (bench.c),
+equivalentes às da tabela hash encadeada.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <windows.h>
+#include "hash_aberto.h"
+#include "memoria.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASH_ABERTO_SSE2
+#endif
+
+/*
+Mistura os bits do ID (finalizador do MurmurHash3). Os 7 bits baixos do resultado vão para o
+byte de controle e os demais escolhem o grupo inicial da sondagem.
+Parâmetro: id - identificador inteiro
+Retorno: hash de 32 bits
+*/
+static unsigned int misturar_id_aberto(int id){
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x85ebca6bU;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35U;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+Compara os 16 bytes de controle de um grupo com um valor.
+Parâmetros:
+    grupo - ponteiro para o primeiro byte de controle do grupo
+    valor - byte procurado
+Retorno: máscara com o bit i ligado quando grupo[i] == valor
+*/
+static unsigned int comparar_grupo(const signed char *grupo, signed char valor){
+#ifdef HASH_ABERTO_SSE2
+    __m128i bytes = _mm_loadu_si128((const __m128i*)grupo);
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(valor)));
+#else
+    unsigned int mascara = 0;
+    int i = 0;
+    for(i; i < TAM_GRUPO_HASH_ABERTO; i++){
+        if(grupo[i] == valor){
+            mascara |= 1U << i;
+        }
+    }
+    return mascara;
+#endif
+}
+
+/*
+Encontra as posições livres (vazias ou apagadas) de um grupo. Os dois valores especiais têm o
+bit mais alto ligado, enquanto os bytes de posições ocupadas vão de 0 a 127.
+Parâmetro: grupo - ponteiro para o primeiro byte de controle do grupo
+Retorno: máscara com o bit i ligado quando a posição i do grupo está livre
+*/
+static unsigned int livres_grupo(const signed char *grupo){
+#ifdef HASH_ABERTO_SSE2
+    __m128i bytes = _mm_loadu_si128((const __m128i*)grupo);
+    return (unsigned int)_mm_movemask_epi8(bytes);
+#else
+    unsigned int mascara = 0;
+    int i = 0;
+    for(i; i < TAM_GRUPO_HASH_ABERTO; i++){
+        if(grupo[i] < 0){
+            mascara |= 1U << i;
+        }
+    }
+    return mascara;
+#endif
+}
+
+/*
+Aloca os vetores da tabela com todas as posições vazias.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    capacidade - número de posições (potência de 2, múltiplo de TAM_GRUPO_HASH_ABERTO)
+*/
+static void alocar_vetores_hash_aberto(TabelaHashAberta *tabela, int capacidade){
+    tabela->controle = (signed char*)alocar_memoria(MEMORIA_HASH_ABERTO, capacidade);
+    tabela->ids = (int*)alocar_memoria(MEMORIA_HASH_ABERTO, capacidade * sizeof(int));
+    tabela->registros = (Registro**)alocar_memoria(MEMORIA_HASH_ABERTO, capacidade * sizeof(Registro*));
+    if(!tabela->controle || !tabela->ids || !tabela->registros){
+        printf("Erro ao alocar memoria para a tabela hash aberta\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(tabela->controle, CONTROLE_VAZIO, capacidade);
+    tabela->capacidade = capacidade;
+    tabela->total = 0;
+    tabela->apagados = 0;
+}
+
+/*
+Inicializa a tabela vazia, com TAM_INICIAL_HASH_ABERTO posições.
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void iniciar_hash_aberto(TabelaHashAberta *tabela){
+    alocar_vetores_hash_aberto(tabela, TAM_INICIAL_HASH_ABERTO);
+}
+
+/*
+Procura, a partir do grupo indicado pelo hash, a primeira posição livre. A sondagem avança
+de grupo em grupo com passos 1, 2, 3, ..., o que visita todos os grupos quando o número de
+grupos é uma potência de 2.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    hash - hash do ID
+Retorno: índice da posição livre
+*/
+static int posicao_livre_hash_aberto(const TabelaHashAberta *tabela, unsigned int hash){
+    int mascara_grupos = tabela->capacidade / TAM_GRUPO_HASH_ABERTO - 1;
+    int grupo = (int)(hash >> 7) & mascara_grupos;
+    int passo = 0;
+
+    while(1){
+        int base = grupo * TAM_GRUPO_HASH_ABERTO;
+        unsigned int livres = livres_grupo(&tabela->controle[base]);
+        if(livres != 0){
+            return base + __builtin_ctz(livres);
+        }
+        passo++;
+        grupo = (grupo + passo) & mascara_grupos;
+    }
+}
+
+/*
+Ocupa uma posição livre com um ID e o ponteiro para o seu registro.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    posicao - índice da posição livre
+    hash - hash do ID
+    id - identificador
+    registro - ponteiro para o registro
+*/
+static void ocupar_posicao_hash_aberto(TabelaHashAberta *tabela, int posicao, unsigned int hash, int id, Registro *registro){
+    if(tabela->controle[posicao] == CONTROLE_APAGADO){
+        tabela->apagados--;
+    }
+    tabela->controle[posicao] = (signed char)(hash & 0x7F);
+    tabela->ids[posicao] = id;
+    tabela->registros[posicao] = registro;
+    tabela->total++;
+}
+
+/*
+Reconstrói a tabela com outra capacidade, reinserindo todos os elementos e descartando as
+posições apagadas.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    capacidade - nova capacidade
+*/
+static void redimensionar_hash_aberto(TabelaHashAberta *tabela, int capacidade){
+    TabelaHashAberta antiga = *tabela;
+    alocar_vetores_hash_aberto(tabela, capacidade);
+
+    int i = 0;
+    for(i; i < antiga.capacidade; i++){
+        if(antiga.controle[i] >= 0){
+            unsigned int hash = misturar_id_aberto(antiga.ids[i]);
+            int posicao = posicao_livre_hash_aberto(tabela, hash);
+            ocupar_posicao_hash_aberto(tabela, posicao, hash, antiga.ids[i], antiga.registros[i]);
+        }
+    }
+
+    liberar_memoria(MEMORIA_HASH_ABERTO, antiga.controle);
+    liberar_memoria(MEMORIA_HASH_ABERTO, antiga.ids);
+    liberar_memoria(MEMORIA_HASH_ABERTO, antiga.registros);
+}
+
+/*
+Insere um novo elemento na tabela. Quando as posições ocupadas e apagadas passam de 7/8 da
+capacidade, a tabela é reconstruída: com o dobro do tamanho se ela estiver de fato cheia,
+ou com o mesmo tamanho se a maior parte das posições for de elementos apagados.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    registro - ponteiro para o registro a ser indexado
+*/
+void inserir_hash_aberto(TabelaHashAberta *tabela, Registro *registro){
+    if((tabela->total + tabela->apagados + 1) * 8 > tabela->capacidade * 7){
+        if((tabela->total + 1) * 2 > tabela->capacidade){
+            redimensionar_hash_aberto(tabela, tabela->capacidade * 2);
+        }else{
+            redimensionar_hash_aberto(tabela, tabela->capacidade);
+        }
+    }
+
+    unsigned int hash = misturar_id_aberto(registro->id);
+    int posicao = posicao_livre_hash_aberto(tabela, hash);
+    ocupar_posicao_hash_aberto(tabela, posicao, hash, registro->id, registro);
+}
+
+/*
+Localiza a posição de um ID. A sondagem termina no primeiro grupo que tenha alguma posição
+vazia, pois uma inserção nunca passaria desse grupo.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    id - identificador a ser buscado
+Retorno: índice da posição ou -1 se o ID não estiver na tabela
+*/
+static int localizar_hash_aberto(const TabelaHashAberta *tabela, int id){
+    unsigned int hash = misturar_id_aberto(id);
+    signed char h2 = (signed char)(hash & 0x7F);
+    int mascara_grupos = tabela->capacidade / TAM_GRUPO_HASH_ABERTO - 1;
+    int grupo = (int)(hash >> 7) & mascara_grupos;
+    int passo = 0;
+
+    while(1){
+        int base = grupo * TAM_GRUPO_HASH_ABERTO;
+        unsigned int candidatos = comparar_grupo(&tabela->controle[base], h2);
+        while(candidatos != 0){
+            int posicao = base + __builtin_ctz(candidatos);
+            if(tabela->ids[posicao] == id){
+                return posicao;
+            }
+            candidatos &= candidatos - 1;
+        }
+        if(comparar_grupo(&tabela->controle[base], CONTROLE_VAZIO) != 0){
+            return -1;
+        }
+        passo++;
+        grupo = (grupo + passo) & mascara_grupos;
+    }
+}
+
+/*
+Busca um elemento pelo ID na tabela.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    id - identificador a ser buscado
+Retorno: ponteiro para o registro encontrado ou NULL
+*/
+Registro* buscar_hash_aberto(const TabelaHashAberta *tabela, int id){
+    int posicao = localizar_hash_aberto(tabela, id);
+    return posicao < 0 ? NULL : tabela->registros[posicao];
+}
+
+/*
+Remove um elemento da tabela pelo ID. Se o grupo da posição ainda tem alguma posição vazia,
+nenhuma sondagem passou por ele, e a posição pode voltar a ser vazia; caso contrário é
+marcada como apagada para não interromper as sondagens que continuam além dela.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    id - identificador do item a ser removido
+Retorno: 1 se removido, 0 se não encontrado
+*/
+int remover_hash_aberto(TabelaHashAberta *tabela, int id){
+    int posicao = localizar_hash_aberto(tabela, id);
+    if(posicao < 0){
+        return 0;
+    }
+
+    int base = posicao - posicao % TAM_GRUPO_HASH_ABERTO;
+    if(comparar_grupo(&tabela->controle[base], CONTROLE_VAZIO) != 0){
+        tabela->controle[posicao] = CONTROLE_VAZIO;
+    }else{
+        tabela->controle[posicao] = CONTROLE_APAGADO;
+        tabela->apagados++;
+    }
+    tabela->total--;
+    return 1;
+}
+
+/*
+Libera toda a memória alocada pela tabela. Os registros pertencem ao armazém e não são
+liberados aqui.
+Parâmetro: tabela - ponteiro para a tabela
+*/
+void liberar_hash_aberto(TabelaHashAberta *tabela){
+    liberar_memoria(MEMORIA_HASH_ABERTO, tabela->controle);
+    liberar_memoria(MEMORIA_HASH_ABERTO, tabela->ids);
+    liberar_memoria(MEMORIA_HASH_ABERTO, tabela->registros);
+    tabela->controle = NULL;
+    tabela->ids = NULL;
+    tabela->registros = NULL;
+    tabela->capacidade = 0;
+    tabela->total = 0;
+    tabela->apagados = 0;
+}
+
+/*
+Retorna a memória ocupada pelos vetores da tabela.
+Parâmetro: tabela - ponteiro para a tabela
+Retorno: memória em bytes
+*/
+size_t memoria_hash_aberto(const TabelaHashAberta *tabela){
+    return (size_t)tabela->capacidade * (sizeof(signed char) + sizeof(int) + sizeof(Registro*));
+}
+
+/*
+Carrega o dataset e insere na tabela. Os registros passam a pertencer ao armazém.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    armazem - ponteiro para o armazém que recebe os registros
+    nome_arquivo - nome do arquivo de entrada (dataset)
+*/
+void carregar_dados_hash_aberto(TabelaHashAberta *tabela, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_hash_aberto(tabela, &ds);
+    adotar_dataset_armazem(armazem, &ds);
+}
+
+/*
+Indexa na tabela todos os registros de um dataset já carregado em memória. O vetor do
+dataset deve permanecer alocado (normalmente transferido para o armazém de registros).
+Parâmetros:
+    tabela - ponteiro para a tabela
+    ds - ponteiro para o dataset com os registros
+*/
+void carregar_registros_hash_aberto(TabelaHashAberta *tabela, Dataset *ds){
+    int i = 0;
+    for(i; i < ds->total; i++){
+        inserir_hash_aberto(tabela, &ds->itens[i]);
+    }
+}
+
+/*
+Busca um ID sondando no máximo lim grupos da tabela.
+Parâmetros:
+    tabela - ponteiro para a tabela
+    id - identificador a ser buscado
+    lim - número máximo de grupos sondados
+Retorno: ponteiro para o registro encontrado ou NULL se o limite acabar antes
+*/
+Registro* buscar_lim_acessos_hash_aberto(const TabelaHashAberta *tabela, int id, int lim){
+    unsigned int hash = misturar_id_aberto(id);
+    signed char h2 = (signed char)(hash & 0x7F);
+    int mascara_grupos = tabela->capacidade / TAM_GRUPO_HASH_ABERTO - 1;
+    int grupo = (int)(hash >> 7) & mascara_grupos;
+    int passo = 0;
+
+    while(passo < lim){
+        int base = grupo * TAM_GRUPO_HASH_ABERTO;
+        unsigned int candidatos = comparar_grupo(&tabela->controle[base], h2);
+        while(candidatos != 0){
+            int posicao = base + __builtin_ctz(candidatos);
+            if(tabela->ids[posicao] == id){
+                return tabela->registros[posicao];
+            }
+            candidatos &= candidatos - 1;
+        }
+        if(comparar_grupo(&tabela->controle[base], CONTROLE_VAZIO) != 0){
+            return NULL;
+        }
+        passo++;
+        grupo = (grupo + passo) & mascara_grupos;
+    }
+    return NULL;
+}
@@ -0,0 +1,33 @@
+#ifndef HASH_ABERTO_H
+#define HASH_ABERTO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dataset.h"
+#include "registros.h"
+
+#define TAM_GRUPO_HASH_ABERTO 16
+#define TAM_INICIAL_HASH_ABERTO 16
+#define CONTROLE_VAZIO ((signed char)-128)
+#define CONTROLE_APAGADO ((signed char)-2)
+
+typedef struct {
+    signed char *controle;
+    int *ids;
+    Registro **registros;
+    int capacidade;
+    int total;
+    int apagados;
+} TabelaHashAberta;
+
+void iniciar_hash_aberto(TabelaHashAberta *tabela);
+void inserir_hash_aberto(TabelaHashAberta *tabela, Registro *registro);
+Registro* buscar_hash_aberto(const TabelaHashAberta *tabela, int id);
+int remover_hash_aberto(TabelaHashAberta *tabela, int id);
+void liberar_hash_aberto(TabelaHashAberta *tabela);
+size_t memoria_hash_aberto(const TabelaHashAberta *tabela);
+void carregar_dados_hash_aberto(TabelaHashAberta *tabela, ArmazemRegistros *armazem, const char *nome_arquivo);
+void carregar_registros_hash_aberto(TabelaHashAberta *tabela, Dataset *ds);
+Registro* buscar_lim_acessos_hash_aberto(const TabelaHashAberta *tabela, int id, int lim);
+
+#endif
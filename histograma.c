@@ -0,0 +1,311 @@
+/*
+->histograma.c
+Implementação de um histograma de latências no estilo HDR, com baldes em escala logarítmica.
+Cada potência de dois é dividida em SUBFAIXAS_HISTOGRAMA faixas de mesma largura, de modo que
+o erro relativo de qualquer valor registrado fica abaixo de 1/SUBFAIXAS_HISTOGRAMA (cerca de 3%)
+tanto para buscas de dezenas de nanossegundos quanto para as de milissegundos, com um vetor
+de tamanho fixo e registro em tempo constante.
+O relógio usa o contador de ciclos do processador (rdtsc) quando disponível, calibrado contra
+o relógio monotônico, e desconta o custo medido de duas leituras seguidas do próprio relógio.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "histograma.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CONTADOR_CICLOS 1
+#define ler_contador_ciclos() __rdtsc()
+static int bit_mais_alto(unsigned long long x){
+    unsigned long indice;
+    _BitScanReverse64(&indice, x);
+    return (int)indice;
+}
+#else
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CONTADOR_CICLOS 1
+#define ler_contador_ciclos() __rdtsc()
+#endif
+#define bit_mais_alto(x) (63 - __builtin_clzll(x))
+#endif
+
+#define LEITURAS_CALIBRACAO_HISTOGRAMA 1000
+#define NS_CALIBRACAO_HISTOGRAMA 20000000LL
+
+static double ns_por_marca = 1.0;
+static unsigned long long custo_marca = 0;
+static int relogio_calibrado = 0;
+
+/*
+Lê o relógio monotônico em nanossegundos.
+*/
+static unsigned long long relogio_ns_histograma(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (unsigned long long)t.tv_sec * 1000000000ULL + (unsigned long long)t.tv_nsec;
+}
+
+/*
+Calibra o relógio das medições. Com o contador de ciclos, mede quantos nanossegundos vale cada
+ciclo comparando-o ao relógio monotônico durante NS_CALIBRACAO_HISTOGRAMA nanossegundos; em
+seguida mede o menor intervalo entre duas marcações seguidas, que é descontado de cada medição.
+É chamada automaticamente na primeira marcação, mas pode ser chamada antes para que a
+calibração não caia dentro de uma medição.
+*/
+void calibrar_relogio_histograma(void){
+#ifdef CONTADOR_CICLOS
+    unsigned long long ns_inicio = relogio_ns_histograma();
+    unsigned long long ciclos_inicio = ler_contador_ciclos();
+    unsigned long long ns_fim = ns_inicio;
+    while(ns_fim - ns_inicio < (unsigned long long)NS_CALIBRACAO_HISTOGRAMA){
+        ns_fim = relogio_ns_histograma();
+    }
+    unsigned long long ciclos_fim = ler_contador_ciclos();
+    if(ciclos_fim > ciclos_inicio){
+        ns_por_marca = (double)(ns_fim - ns_inicio) / (double)(ciclos_fim - ciclos_inicio);
+    }
+#endif
+    relogio_calibrado = 1;
+
+    unsigned long long menor = ~0ULL;
+    int i = 0;
+    for(i; i < LEITURAS_CALIBRACAO_HISTOGRAMA; i++){
+        unsigned long long a = marcar_relogio_histograma();
+        unsigned long long b = marcar_relogio_histograma();
+        if(b - a < menor){
+            menor = b - a;
+        }
+    }
+    custo_marca = menor;
+}
+
+/*
+Marca o instante atual, em ciclos ou em nanossegundos conforme o relógio disponível.
+Retorno: marcação, a ser convertida por nanossegundos_histograma
+*/
+unsigned long long marcar_relogio_histograma(void){
+    if(!relogio_calibrado){
+        calibrar_relogio_histograma();
+    }
+#ifdef CONTADOR_CICLOS
+    return ler_contador_ciclos();
+#else
+    return relogio_ns_histograma();
+#endif
+}
+
+/*
+Converte o intervalo entre duas marcações em nanossegundos, descontando o custo do relógio.
+Parâmetros:
+    inicio - marcação inicial
+    fim - marcação final
+Retorno: duração em nanossegundos
+*/
+unsigned long long nanossegundos_histograma(unsigned long long inicio, unsigned long long fim){
+    if(fim <= inicio + custo_marca){
+        return 0;
+    }
+    return (unsigned long long)((double)(fim - inicio - custo_marca) * ns_por_marca);
+}
+
+/*
+Calcula o balde de um valor. Valores menores que SUBFAIXAS_HISTOGRAMA têm um balde cada; os
+demais ficam no grupo da sua potência de dois, na subfaixa dada pelos bits seguintes ao mais
+alto.
+*/
+static int balde_histograma(unsigned long long valor){
+    if(valor < SUBFAIXAS_HISTOGRAMA){
+        return (int)valor;
+    }
+    int alto = bit_mais_alto(valor);
+    int subfaixa = (int)((valor >> (alto - BITS_SUBFAIXA_HISTOGRAMA)) & (SUBFAIXAS_HISTOGRAMA - 1));
+    return (alto - BITS_SUBFAIXA_HISTOGRAMA + 1) * SUBFAIXAS_HISTOGRAMA + subfaixa;
+}
+
+/*
+Retorna o menor valor que cai em um balde.
+*/
+static unsigned long long limite_inferior_histograma(int balde){
+    int grupo = balde >> BITS_SUBFAIXA_HISTOGRAMA;
+    int subfaixa = balde & (SUBFAIXAS_HISTOGRAMA - 1);
+    if(grupo == 0){
+        return (unsigned long long)subfaixa;
+    }
+    int alto = grupo + BITS_SUBFAIXA_HISTOGRAMA - 1;
+    return (1ULL << alto) + ((unsigned long long)subfaixa << (alto - BITS_SUBFAIXA_HISTOGRAMA));
+}
+
+/*
+Retorna a largura de um balde.
+*/
+static unsigned long long largura_histograma(int balde){
+    int grupo = balde >> BITS_SUBFAIXA_HISTOGRAMA;
+    return grupo == 0 ? 1ULL : 1ULL << (grupo - 1);
+}
+
+/*
+Inicializa um histograma vazio.
+Parâmetro: h - ponteiro para o histograma
+*/
+void iniciar_histograma(Histograma *h){
+    memset(h, 0, sizeof(Histograma));
+    h->minimo = ~0ULL;
+}
+
+/*
+Registra um valor no histograma.
+Parâmetros:
+    h - ponteiro para o histograma
+    valor - valor a ser registrado (em nanossegundos nas medições de latência)
+*/
+void registrar_histograma(Histograma *h, unsigned long long valor){
+    h->contagem[balde_histograma(valor)]++;
+    h->total++;
+    h->soma += (double)valor;
+    if(valor < h->minimo){
+        h->minimo = valor;
+    }
+    if(valor > h->maximo){
+        h->maximo = valor;
+    }
+}
+
+/*
+Soma os registros de um histograma em outro.
+Parâmetros:
+    destino - histograma que recebe os registros
+    origem - histograma a ser somado
+*/
+void mesclar_histograma(Histograma *destino, const Histograma *origem){
+    int i = 0;
+    for(i; i < BALDES_HISTOGRAMA; i++){
+        destino->contagem[i] += origem->contagem[i];
+    }
+    destino->total += origem->total;
+    destino->soma += origem->soma;
+    if(origem->minimo < destino->minimo){
+        destino->minimo = origem->minimo;
+    }
+    if(origem->maximo > destino->maximo){
+        destino->maximo = origem->maximo;
+    }
+}
+
+/*
+Calcula um percentil. O resultado é o maior valor do balde onde o percentil cai, limitado ao
+máximo registrado, de modo que o percentil nunca é subestimado.
+Parâmetros:
+    h - ponteiro para o histograma
+    p - percentil entre 0 e 100
+Retorno: valor do percentil (0 se o histograma estiver vazio)
+*/
+unsigned long long percentil_histograma(const Histograma *h, double p){
+    if(h->total == 0){
+        return 0;
+    }
+    unsigned long long alvo = (unsigned long long)(p / 100.0 * (double)h->total + 0.5);
+    if(alvo < 1){
+        alvo = 1;
+    }
+    if(alvo > h->total){
+        alvo = h->total;
+    }
+
+    unsigned long long acumulado = 0;
+    int i = 0;
+    for(i; i < BALDES_HISTOGRAMA; i++){
+        acumulado += h->contagem[i];
+        if(acumulado >= alvo){
+            unsigned long long maior = limite_inferior_histograma(i) + largura_histograma(i) - 1;
+            return maior < h->maximo ? maior : h->maximo;
+        }
+    }
+    return h->maximo;
+}
+
+/*
+Retorna a média dos valores registrados.
+Parâmetro: h - ponteiro para o histograma
+Retorno: média (0 se o histograma estiver vazio)
+*/
+double media_histograma(const Histograma *h){
+    return h->total > 0 ? h->soma / (double)h->total : 0;
+}
+
+/*
+Exibe os percentis do histograma e a distribuição dos valores agrupada por potência de dois,
+com uma barra proporcional à contagem de cada faixa.
+Parâmetros:
+    h - ponteiro para o histograma
+    titulo - texto exibido antes dos percentis
+*/
+void imprimir_histograma(const Histograma *h, const char *titulo){
+    if(h->total == 0){
+        printf("%s: nenhuma medicao\n", titulo);
+        return;
+    }
+
+    printf("%s: %llu medicoes | min %llu | p50 %llu | p90 %llu | p99 %llu | p99.9 %llu | max %llu | media %.1f (ns)\n",
+        titulo, h->total, h->minimo, percentil_histograma(h, 50), percentil_histograma(h, 90),
+        percentil_histograma(h, 99), percentil_histograma(h, 99.9), h->maximo, media_histograma(h));
+
+    unsigned long long por_grupo[GRUPOS_HISTOGRAMA];
+    unsigned long long maior = 0;
+    int g = 0;
+    for(g; g < GRUPOS_HISTOGRAMA; g++){
+        por_grupo[g] = 0;
+        int s = 0;
+        for(s; s < SUBFAIXAS_HISTOGRAMA; s++){
+            por_grupo[g] += h->contagem[g * SUBFAIXAS_HISTOGRAMA + s];
+        }
+        if(por_grupo[g] > maior){
+            maior = por_grupo[g];
+        }
+    }
+
+    for(g = 0; g < GRUPOS_HISTOGRAMA; g++){
+        if(por_grupo[g] == 0){
+            continue;
+        }
+        int primeiro = g * SUBFAIXAS_HISTOGRAMA;
+        int ultimo = primeiro + SUBFAIXAS_HISTOGRAMA - 1;
+        unsigned long long de = limite_inferior_histograma(primeiro);
+        unsigned long long ate = limite_inferior_histograma(ultimo) + largura_histograma(ultimo) - 1;
+        int largura = (int)(por_grupo[g] * LARGURA_BARRA_HISTOGRAMA / maior);
+
+        printf("  %12llu - %-12llu %10llu |", de, ate, por_grupo[g]);
+        int i = 0;
+        for(i; i < largura; i++){
+            printf("#");
+        }
+        printf("\n");
+    }
+}
+
+/*
+Escreve os baldes não vazios do histograma em CSV, uma linha por balde, com a contagem e o
+percentual acumulado até o fim do balde. O cabeçalho é responsabilidade de quem chama:
+estrutura,cenario,limite_inferior_ns,limite_superior_ns,contagem,percentual_acumulado
+Parâmetros:
+    h - ponteiro para o histograma
+    arquivo - arquivo de saída aberto para escrita
+    estrutura - nome da estrutura medida
+    cenario - nome do cenário medido
+*/
+void escrever_csv_histograma(const Histograma *h, FILE *arquivo, const char *estrutura, const char *cenario){
+    unsigned long long acumulado = 0;
+    int i = 0;
+    for(i; i < BALDES_HISTOGRAMA; i++){
+        if(h->contagem[i] == 0){
+            continue;
+        }
+        acumulado += h->contagem[i];
+        fprintf(arquivo, "%s,%s,%llu,%llu,%llu,%.6f\n", estrutura, cenario, limite_inferior_histograma(i),
+            limite_inferior_histograma(i) + largura_histograma(i) - 1, h->contagem[i],
+            100.0 * (double)acumulado / (double)h->total);
+    }
+}
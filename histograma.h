@@ -0,0 +1,31 @@
+#ifndef HISTOGRAMA_H
+#define HISTOGRAMA_H
+
+#include <stdio.h>
+
+#define BITS_SUBFAIXA_HISTOGRAMA 5
+#define SUBFAIXAS_HISTOGRAMA (1 << BITS_SUBFAIXA_HISTOGRAMA)
+#define GRUPOS_HISTOGRAMA (64 - BITS_SUBFAIXA_HISTOGRAMA + 1)
+#define BALDES_HISTOGRAMA (GRUPOS_HISTOGRAMA * SUBFAIXAS_HISTOGRAMA)
+#define LARGURA_BARRA_HISTOGRAMA 40
+
+typedef struct{
+    unsigned long long contagem[BALDES_HISTOGRAMA];
+    unsigned long long total;
+    unsigned long long minimo;
+    unsigned long long maximo;
+    double soma;
+} Histograma;
+
+void calibrar_relogio_histograma(void);
+unsigned long long marcar_relogio_histograma(void);
+unsigned long long nanossegundos_histograma(unsigned long long inicio, unsigned long long fim);
+void iniciar_histograma(Histograma *h);
+void registrar_histograma(Histograma *h, unsigned long long valor);
+void mesclar_histograma(Histograma *destino, const Histograma *origem);
+unsigned long long percentil_histograma(const Histograma *h, double p);
+double media_histograma(const Histograma *h);
+void imprimir_histograma(const Histograma *h, const char *titulo);
+void escrever_csv_histograma(const Histograma *h, FILE *arquivo, const char *estrutura, const char *cenario);
+
+#endif
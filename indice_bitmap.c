@@ -0,0 +1,370 @@
+/*
+->indice_bitmap.c
+Implementação do índice secundário de bitmaps sobre o armazém de registros.
+Cada código de estado, cada código de cultura e cada ano tem um bitmap compactado com as
+posições (no armazém) dos registros que têm aquele valor. Um filtro por ano, estado e cultura
+é respondido sem percorrer as amostras: os bitmaps dos códigos que passam em cada filtro são
+unidos (OR) e os três conjuntos resultantes são intersectados (AND).
+O índice é mantido junto com as demais estruturas: cada inserção e remoção no armazém deve
+ser acompanhada de indexar_bitmap e desindexar_bitmap.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "indice_bitmap.h"
+#include "memoria.h"
+
+/*
+Inicializa um índice vazio sobre um armazém.
+Parâmetros:
+    indice - ponteiro para o índice
+    armazem - ponteiro para o armazém cujas posições serão indexadas
+*/
+void iniciar_indice_bitmap(IndiceBitmap *indice, const ArmazemRegistros *armazem){
+    indice->armazem = armazem;
+    indice->estados = NULL;
+    indice->n_estados = 0;
+    indice->culturas = NULL;
+    indice->n_culturas = 0;
+    indice->anos = NULL;
+    indice->n_anos = 0;
+    indice->cap_anos = 0;
+}
+
+/*
+Garante que o vetor de bitmaps de um dicionário tenha uma posição para o código dado.
+Parâmetros:
+    bitmaps - ponteiro para o vetor de bitmaps (indexado pelo código)
+    total - ponteiro para o número de bitmaps do vetor
+    codigo - código que precisa ter bitmap
+*/
+static void garantir_codigo(Bitmap **bitmaps, int *total, int codigo){
+    if(codigo < *total){
+        return;
+    }
+    int novo_total = *total == 0 ? 32 : *total;
+    while(novo_total <= codigo){
+        novo_total *= 2;
+    }
+    Bitmap *novos = (Bitmap*)realocar_memoria(MEMORIA_BITMAP, *bitmaps, novo_total * sizeof(Bitmap));
+    if(!novos){
+        printf("Erro ao alocar memoria para o indice de bitmaps\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = *total;
+    for(i; i < novo_total; i++){
+        iniciar_bitmap(&novos[i]);
+    }
+    *bitmaps = novos;
+    *total = novo_total;
+}
+
+/*
+Procura o bitmap de um ano (busca binária no vetor ordenado de anos).
+Parâmetros:
+    indice - ponteiro para o índice
+    ano - ano procurado
+Retorno: posição do ano no vetor, ou onde ele deveria ser inserido
+*/
+static int posicao_ano(const IndiceBitmap *indice, int ano){
+    int inicio = 0;
+    int fim = indice->n_anos;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if(indice->anos[meio].ano < ano){
+            inicio = meio + 1;
+        }else{
+            fim = meio;
+        }
+    }
+    return inicio;
+}
+
+/*
+Acrescenta um registro do armazém ao índice.
+Parâmetros:
+    indice - ponteiro para o índice
+    r - ponteiro para o registro (pertencente ao armazém do índice)
+*/
+void indexar_bitmap(IndiceBitmap *indice, const Registro *r){
+    int posicao = posicao_armazem(indice->armazem, r);
+    if(posicao < 0){
+        return;
+    }
+
+    garantir_codigo(&indice->estados, &indice->n_estados, r->estado);
+    adicionar_bitmap(&indice->estados[r->estado], (unsigned int)posicao);
+    garantir_codigo(&indice->culturas, &indice->n_culturas, r->cultura);
+    adicionar_bitmap(&indice->culturas[r->cultura], (unsigned int)posicao);
+
+    int i = posicao_ano(indice, r->ano);
+    if(i == indice->n_anos || indice->anos[i].ano != r->ano){
+        if(indice->n_anos == indice->cap_anos){
+            int nova_capacidade = indice->cap_anos == 0 ? 16 : indice->cap_anos * 2;
+            BitmapAno *anos = (BitmapAno*)realocar_memoria(MEMORIA_BITMAP, indice->anos, nova_capacidade * sizeof(BitmapAno));
+            if(!anos){
+                printf("Erro ao alocar memoria para o indice de bitmaps\n");
+                exit(EXIT_FAILURE);
+            }
+            indice->anos = anos;
+            indice->cap_anos = nova_capacidade;
+        }
+        memmove(&indice->anos[i + 1], &indice->anos[i], (indice->n_anos - i) * sizeof(BitmapAno));
+        indice->anos[i].ano = r->ano;
+        iniciar_bitmap(&indice->anos[i].posicoes);
+        indice->n_anos++;
+    }
+    adicionar_bitmap(&indice->anos[i].posicoes, (unsigned int)posicao);
+}
+
+/*
+Retira um registro do índice. Deve ser chamada antes de o registro ser removido do armazém.
+Parâmetros:
+    indice - ponteiro para o índice
+    r - ponteiro para o registro (pertencente ao armazém do índice)
+*/
+void desindexar_bitmap(IndiceBitmap *indice, const Registro *r){
+    int posicao = posicao_armazem(indice->armazem, r);
+    if(posicao < 0){
+        return;
+    }
+
+    if(r->estado < indice->n_estados){
+        remover_bitmap(&indice->estados[r->estado], (unsigned int)posicao);
+    }
+    if(r->cultura < indice->n_culturas){
+        remover_bitmap(&indice->culturas[r->cultura], (unsigned int)posicao);
+    }
+    int i = posicao_ano(indice, r->ano);
+    if(i < indice->n_anos && indice->anos[i].ano == r->ano){
+        remover_bitmap(&indice->anos[i].posicoes, (unsigned int)posicao);
+    }
+}
+
+/*
+Reconstrói o índice com todos os registros do armazém, ignorando as posições livres.
+Parâmetros:
+    indice - ponteiro para o índice
+    armazem - ponteiro para o armazém
+*/
+void carregar_indice_bitmap(IndiceBitmap *indice, const ArmazemRegistros *armazem){
+    liberar_indice_bitmap(indice);
+    iniciar_indice_bitmap(indice, armazem);
+
+    Bitmap livres;
+    iniciar_bitmap(&livres);
+    int i = 0;
+    for(i; i < armazem->n_livres; i++){
+        adicionar_bitmap(&livres, (unsigned int)posicao_armazem(armazem, armazem->livres[i]));
+    }
+
+    int b = 0;
+    for(b; b < armazem->n_blocos; b++){
+        const BlocoRegistros *bloco = &armazem->blocos[b];
+        int j = 0;
+        for(j; j < bloco->usados; j++){
+            if(livres.total == 0 || !contem_bitmap(&livres, (unsigned int)(bloco->inicio + j))){
+                indexar_bitmap(indice, &bloco->itens[j]);
+            }
+        }
+    }
+    liberar_bitmap(&livres);
+}
+
+/*
+Acumula em um bitmap a união dele com outro.
+Parâmetros:
+    acumulado - ponteiro para o bitmap que recebe a união
+    b - ponteiro para o bitmap a ser unido
+*/
+static void unir_acumulado(Bitmap *acumulado, const Bitmap *b){
+    Bitmap uniao;
+    iniciar_bitmap(&uniao);
+    unir_bitmap(acumulado, b, &uniao);
+    liberar_bitmap(acumulado);
+    *acumulado = uniao;
+}
+
+/*
+Une os bitmaps de todos os códigos de um dicionário que pertencem a uma classe.
+Parâmetros:
+    bitmaps - vetor de bitmaps indexado pelo código
+    total - número de bitmaps do vetor
+    dicionario - ponteiro para o dicionário dos códigos
+    classe - classe obtida com filtro_dicionario
+    saida - ponteiro para o bitmap que recebe a união (iniciado e vazio)
+*/
+static void unir_classe(const Bitmap *bitmaps, int total, const Dicionario *dicionario, int classe, Bitmap *saida){
+    int limite = (int)dicionario->total < total ? (int)dicionario->total : total;
+    int i = 0;
+    for(i; i < limite; i++){
+        if(dicionario->classes[i] == classe && bitmaps[i].total > 0){
+            unir_acumulado(saida, &bitmaps[i]);
+        }
+    }
+}
+
+/*
+Seleciona os registros que atendem aos filtros de ano, estado e cultura. Os resultados vêm na
+ordem das posições no armazém.
+Parâmetros:
+    indice - ponteiro para o índice
+    ano_min, ano_max - intervalo de anos
+    estado - filtro de estado (string, vazio para ignorar)
+    cultura - filtro de cultura (string, vazio para ignorar)
+    resultado - recebe um vetor alocado com os registros selecionados (liberar com
+        liberar_memoria(MEMORIA_BITMAP, ...))
+Retorno: número de registros selecionados
+*/
+int filtrar_indice_bitmap(const IndiceBitmap *indice, int ano_min, int ano_max, const char *estado, const char *cultura, Registro ***resultado){
+    int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+    int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+    *resultado = NULL;
+    if(filtro_estado == FILTRO_NENHUM || filtro_cultura == FILTRO_NENHUM || ano_min > ano_max){
+        return 0;
+    }
+
+    Bitmap conjuntos[3];
+    int n_conjuntos = 0;
+
+    if(filtro_estado != FILTRO_QUALQUER){
+        iniciar_bitmap(&conjuntos[n_conjuntos]);
+        unir_classe(indice->estados, indice->n_estados, &dicionario_estados, filtro_estado, &conjuntos[n_conjuntos]);
+        n_conjuntos++;
+    }
+    if(filtro_cultura != FILTRO_QUALQUER){
+        iniciar_bitmap(&conjuntos[n_conjuntos]);
+        unir_classe(indice->culturas, indice->n_culturas, &dicionario_culturas, filtro_cultura, &conjuntos[n_conjuntos]);
+        n_conjuntos++;
+    }
+
+    /* Um intervalo que cobre todos os anos não restringe nada; só é usado quando não há
+       outro filtro, para obter o conjunto de todos os registros. */
+    int cobre_todos = indice->n_anos == 0 || (ano_min <= indice->anos[0].ano && ano_max >= indice->anos[indice->n_anos - 1].ano);
+    if(!cobre_todos || n_conjuntos == 0){
+        iniciar_bitmap(&conjuntos[n_conjuntos]);
+        int i = posicao_ano(indice, ano_min);
+        for(i; i < indice->n_anos && indice->anos[i].ano <= ano_max; i++){
+            unir_acumulado(&conjuntos[n_conjuntos], &indice->anos[i].posicoes);
+        }
+        n_conjuntos++;
+    }
+
+    /* Intersecta começando pelo menor conjunto, que limita o tamanho dos intermediários. */
+    int menor = 0;
+    int k = 1;
+    for(k; k < n_conjuntos; k++){
+        if(cardinalidade_bitmap(&conjuntos[k]) < cardinalidade_bitmap(&conjuntos[menor])){
+            menor = k;
+        }
+    }
+    Bitmap selecionados = conjuntos[menor];
+    for(k = 0; k < n_conjuntos; k++){
+        if(k == menor){
+            continue;
+        }
+        Bitmap intersecao;
+        iniciar_bitmap(&intersecao);
+        intersectar_bitmap(&selecionados, &conjuntos[k], &intersecao);
+        liberar_bitmap(&selecionados);
+        liberar_bitmap(&conjuntos[k]);
+        selecionados = intersecao;
+    }
+
+    int total = (int)cardinalidade_bitmap(&selecionados);
+    if(total > 0){
+        unsigned int *posicoes = (unsigned int*)alocar_memoria(MEMORIA_BITMAP, total * sizeof(unsigned int));
+        Registro **registros = (Registro**)alocar_memoria(MEMORIA_BITMAP, total * sizeof(Registro*));
+        if(!posicoes || !registros){
+            printf("Erro ao alocar memoria para o resultado do filtro\n");
+            exit(EXIT_FAILURE);
+        }
+        listar_bitmap(&selecionados, posicoes);
+        int i = 0;
+        for(i; i < total; i++){
+            registros[i] = registro_posicao_armazem(indice->armazem, (int)posicoes[i]);
+        }
+        liberar_memoria(MEMORIA_BITMAP, posicoes);
+        *resultado = registros;
+    }
+    liberar_bitmap(&selecionados);
+    return total;
+}
+
+/*
+Retorna a memória ocupada pelo índice.
+Parâmetro: indice - ponteiro para o índice
+Retorno: memória em bytes
+*/
+size_t memoria_indice_bitmap(const IndiceBitmap *indice){
+    size_t memoria = sizeof(IndiceBitmap);
+    int i = 0;
+    for(i; i < indice->n_estados; i++){
+        memoria += memoria_bitmap(&indice->estados[i]);
+    }
+    for(i = 0; i < indice->n_culturas; i++){
+        memoria += memoria_bitmap(&indice->culturas[i]);
+    }
+    for(i = 0; i < indice->n_anos; i++){
+        memoria += memoria_bitmap(&indice->anos[i].posicoes);
+    }
+    memoria += (size_t)(indice->cap_anos - indice->n_anos) * sizeof(BitmapAno);
+    return memoria;
+}
+
+/*
+Libera toda a memória do índice, deixando-o vazio (ainda associado ao mesmo armazém).
+Parâmetro: indice - ponteiro para o índice
+*/
+void liberar_indice_bitmap(IndiceBitmap *indice){
+    int i = 0;
+    for(i; i < indice->n_estados; i++){
+        liberar_bitmap(&indice->estados[i]);
+    }
+    for(i = 0; i < indice->n_culturas; i++){
+        liberar_bitmap(&indice->culturas[i]);
+    }
+    for(i = 0; i < indice->n_anos; i++){
+        liberar_bitmap(&indice->anos[i].posicoes);
+    }
+    liberar_memoria(MEMORIA_BITMAP, indice->estados);
+    liberar_memoria(MEMORIA_BITMAP, indice->culturas);
+    liberar_memoria(MEMORIA_BITMAP, indice->anos);
+    iniciar_indice_bitmap(indice, indice->armazem);
+}
+
+/*
+Compara dois ponteiros para registros pelo ID, para uso com qsort.
+*/
+static int comparar_registros_id_bitmap(const void *a, const void *b){
+    const Registro *ra = *(const Registro* const*)a;
+    const Registro *rb = *(const Registro* const*)b;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+/*
+Responde pelo índice a busca por filtros das estruturas e imprime os registros encontrados.
+O índice devolve os registros na ordem das posições no armazém, que deixa de ser a ordem de ID
+quando uma posição livre é reaproveitada; por isso eles são ordenados por ID antes de impressos.
+Parâmetros:
+    indice - ponteiro para o índice
+    ano_min, ano_max - intervalo de anos
+    estado - filtro de estado (string, vazio para ignorar)
+    cultura - filtro de cultura (string, vazio para ignorar)
+    imprimir - imprime uma linha do resultado, no formato da estrutura que fez a busca
+Retorno: número de registros encontrados
+*/
+int imprimir_filtro_indice_bitmap(const IndiceBitmap *indice, int ano_min, int ano_max, const char *estado, const char *cultura, void (*imprimir)(const Registro *r)){
+    Registro **selecionados;
+    int encontrados = filtrar_indice_bitmap(indice, ano_min, ano_max, estado, cultura, &selecionados);
+    if(encontrados > 1){
+        qsort(selecionados, encontrados, sizeof(Registro*), comparar_registros_id_bitmap);
+    }
+    int i = 0;
+    for(i; i < encontrados; i++){
+        imprimir(selecionados[i]);
+    }
+    liberar_memoria(MEMORIA_BITMAP, selecionados);
+    return encontrados;
+}
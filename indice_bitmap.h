@@ -0,0 +1,34 @@
+#ifndef INDICE_BITMAP_H
+#define INDICE_BITMAP_H
+
+#include <stdio.h>
+#include "dataset.h"
+#include "registros.h"
+#include "bitmap.h"
+
+typedef struct{
+    int ano;
+    Bitmap posicoes;
+} BitmapAno;
+
+typedef struct{
+    const ArmazemRegistros *armazem;
+    Bitmap *estados;
+    int n_estados;
+    Bitmap *culturas;
+    int n_culturas;
+    BitmapAno *anos;
+    int n_anos;
+    int cap_anos;
+} IndiceBitmap;
+
+void iniciar_indice_bitmap(IndiceBitmap *indice, const ArmazemRegistros *armazem);
+void indexar_bitmap(IndiceBitmap *indice, const Registro *r);
+void desindexar_bitmap(IndiceBitmap *indice, const Registro *r);
+void carregar_indice_bitmap(IndiceBitmap *indice, const ArmazemRegistros *armazem);
+int filtrar_indice_bitmap(const IndiceBitmap *indice, int ano_min, int ano_max, const char *estado, const char *cultura, Registro ***resultado);
+int imprimir_filtro_indice_bitmap(const IndiceBitmap *indice, int ano_min, int ano_max, const char *estado, const char *cultura, void (*imprimir)(const Registro *r));
+size_t memoria_indice_bitmap(const IndiceBitmap *indice);
+void liberar_indice_bitmap(IndiceBitmap *indice);
+
+#endif
@@ -2,8 +2,8 @@
 ->lista_encadeada.c
 Implementação de uma lista encadeada para manipulação de amostras agrícolas.
 Este arquivo contém as funções para inserir, remover, buscar, filtrar, imprimir 
-e carregar dados em uma lista encadeada simples, além de funções auxiliares 
-e do conjunto de nove funções para benchamark.
+e carregar dados em uma lista encadeada simples, além de funções auxiliares e das primitivas
+usadas pelo modo benchmark (bench.c).
 */
 
 #include <stdio.h>
@@ -12,17 +12,20 @@ e do conjunto de nove funções para benchamark.
 #include <time.h>
 #include <windows.h>
 #include "lista_encadeada.h"
+#include "memoria.h"
 
 /*
-Insere um novo elemento no início da lista encadeada.
+Insere um novo elemento no início da lista encadeada. O nó guarda apenas o ID e o ponteiro
+para o registro, que pertence ao armazém de registros.
 Parâmetros:
     cabeca - ponteiro para a cabeça da lista
-    novo - estrutura com os dados a serem inseridos
+    registro - ponteiro para o registro a ser indexado
 */
-void inserir_LE(ItemListaEncadeada **cabeca, ItemListaEncadeada novo){
-    ItemListaEncadeada *novo_item = malloc(sizeof(ItemListaEncadeada));
+void inserir_LE(ItemListaEncadeada **cabeca, Registro *registro){
+    ItemListaEncadeada *novo_item = alocar_memoria(MEMORIA_LISTA_ENCADEADA, sizeof(ItemListaEncadeada));
 
-    *novo_item = novo;
+    novo_item->id = registro->id;
+    novo_item->registro = registro;
     novo_item->prox = *cabeca;
     *cabeca = novo_item;
 }
@@ -46,51 +49,15 @@ int criar_id_LE(ItemListaEncadeada *cabeca){
 
 /*
 Cria uma nova amostra a partir da entrada do usuário e insere na lista.
-Parâmetro: cabeca - ponteiro para o ponteiro da cabeça da lista
+Parâmetros:
+    cabeca - ponteiro para o ponteiro da cabeça da lista
+    armazem - ponteiro para o armazém que recebe o novo registro
 */
-void criar_amostra_LE(ItemListaEncadeada **cabeca){
-    ItemListaEncadeada novo;
-    char entrada[50];
-
-    novo.id = criar_id_LE(*cabeca);
-
-    printf("\n===Insira os dados da nova amostra===\n");
-
-    printf("Ano: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%d", &novo.ano);
-
-    printf("Estado: ");
-    fgets(novo.estado, sizeof(novo.estado), stdin);
-    novo.estado[strcspn(novo.estado, "\n")] = '\0';
-
-    printf("Cultura: ");
-    fgets(novo.cultura, sizeof(novo.cultura), stdin);
-    novo.cultura[strcspn(novo.cultura, "\n")] = '\0';
-
-    printf("Preco por tonelada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.preco_ton);
+void criar_amostra_LE(ItemListaEncadeada **cabeca, ArmazemRegistros *armazem){
+    Registro novo;
+    ler_registro_usuario(&novo, criar_id_LE(*cabeca));
 
-    printf("Rendimento: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.rendimento);
-
-    printf("Producao: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.producao);
-
-    printf("Area plantada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.area_plantada);
-
-    printf("Valor total: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.valor_total);
-
-    novo.prox = NULL;
-
-    inserir_LE(cabeca, novo);
+    inserir_LE(cabeca, adicionar_armazem(armazem, &novo));
 
     printf("\nAmostra inserida com sucesso\n");
 }
@@ -114,33 +81,41 @@ ItemListaEncadeada* buscar_LE(ItemListaEncadeada *cabeca, int id){
 }
 
 /*
-Busca e imprime elementos que atendem aos filtros de ano, estado e cultura.
+Busca e imprime elementos que atendem aos filtros de ano, estado e cultura, percorrendo a
+lista ou, quando há índice de bitmaps, consultando o índice.
 Parâmetros:
   cabeca - ponteiro para a cabeça da lista
   ano_min, ano_max - intervalo de anos
   cultura - filtro de cultura (string)
   estado - filtro de estado (string)
+  indice - índice de bitmaps sobre os mesmos registros, ou NULL para percorrer a lista
 */
-void buscar_filtros_LE(ItemListaEncadeada *cabeca, int ano_min, int ano_max, const char *estado, const char *cultura){
+void buscar_filtros_LE(ItemListaEncadeada *cabeca, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice){
     ItemListaEncadeada *atual = cabeca;
     int encontrados = 0;
 
     printf("\n===RESULTADOS DA BUSCA===\n");
 
-    while(atual != NULL){
-        int ano_certo = (atual->ano >= ano_min) && (atual->ano <= ano_max);
+    if(indice != NULL){
+        encontrados = imprimir_filtro_indice_bitmap(indice, ano_min, ano_max, estado, cultura, imprimir_registro);
+    }else{
+        int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+        int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
 
-        int estado_certo = (estado == NULL || strlen(estado) == 0 || strcasecmp(atual->estado, estado) == 0);
+        while(atual != NULL){
+            const Registro *r = atual->registro;
+            int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
 
-        int cultura_certa = (cultura == NULL || strlen(cultura) == 0 || strcasecmp(atual->cultura, cultura) == 0);
+            int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, filtro_estado);
 
-        if(ano_certo && estado_certo && cultura_certa){
-            printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-                atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton,
-                atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
-            encontrados++;
+            int cultura_certa = ACEITA_FILTRO(dicionario_culturas, r->cultura, filtro_cultura);
+
+            if(ano_certo && estado_certo && cultura_certa){
+                imprimir_registro(r);
+                encontrados++;
+            }
+            atual = atual->prox;
         }
-        atual = atual->prox;
     }
 
     if(encontrados == 0){
@@ -172,7 +147,7 @@ int remover_LE(ItemListaEncadeada **cabeca, int id){
             }else{
                 anterior->prox = atual->prox;
             }
-            free(atual);
+            liberar_memoria(MEMORIA_LISTA_ENCADEADA, atual);
             return 1;
         }
         anterior = atual;
@@ -187,9 +162,10 @@ Parâmetro: cabeca - ponteiro para a cabeça da lista
 */
 void imprime_LE(ItemListaEncadeada *cabeca){
     while(cabeca != NULL){
+        const Registro *r = cabeca->registro;
         printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n", 
-            cabeca->id, cabeca->ano, cabeca->estado, cabeca->cultura, cabeca->preco_ton, 
-            cabeca->rendimento, cabeca->producao, cabeca->area_plantada, cabeca->valor_total);
+            r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton, 
+            r->rendimento, r->producao, r->area_plantada, r->valor_total);
 
         cabeca = cabeca->prox;
     }
@@ -206,520 +182,56 @@ void libera_LE(ItemListaEncadeada *cabeca){
         temp = cabeca;
         cabeca = cabeca->prox;
 
-        free(temp);
+        liberar_memoria(MEMORIA_LISTA_ENCADEADA, temp);
     }
 }
 
 /*
-Carrega as amostras do dataset e insere na lista encadeada.
+Carrega as amostras do dataset e insere na lista encadeada. Os registros passam a pertencer
+ao armazém.
 Parâmetros:
   cabeca - ponteiro para o ponteiro da cabeça da lista
+  armazem - ponteiro para o armazém que recebe os registros
   nome_arquivo - nome do arquivo de entrada (dataset)
 */
-void carregar_dados_LE(ItemListaEncadeada **cabeca, const char *nome_arquivo){
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arq);
-
-    while(fgets(linha, sizeof(linha), arq)){
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        inserir_LE(cabeca, novo);
-    }
-
-    fclose(arq);
-}
-
-/*
-Salva todos os elementos da lista no dataset.
-Parâmetros:
-  cabeca - ponteiro para a cabeça da lista
-  nome_arquivo - nome do arquivo de saída (dataset)
-*/
-void salvar_dados_LE(ItemListaEncadeada *cabeca, const char *nome_arquivo){
-    FILE *arq = fopen(nome_arquivo, "w");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(arq, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
-    ItemListaEncadeada *atual = cabeca;
-
-    while(atual != NULL){
-        fprintf(arq, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n", atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton, 
-            atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
-        atual = atual->prox;
-    }
-
-    fclose(arq);
-}
-
-/*
-Mede o tempo de inserção de n elementos do dataset na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_insercao_LE(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemListaEncadeada *cabeca = NULL;
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        return;
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arq);
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int i = 0;
-    while(fgets(linha, sizeof(linha), arq) && i < n){
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d,%d,%49[^,],%49[^,],%f,%f,%f,%f,%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        inserir_LE(&cabeca, novo);
-        i++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    
-    libera_LE(cabeca);
-    fclose(arq);
-    return tempo;
-}
-
-/*
-Mede o tempo de remoção de n elementos do dataset na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_remocao_LE(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    
-    ItemListaEncadeada *cabeca = NULL;
-    carregar_dados_LE(&cabeca, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Falha ao alocar memoria\n");
-        libera_LE(cabeca);
-        exit(EXIT_FAILURE);
-    }
-
-    ItemListaEncadeada *atual = cabeca;
-    int total_ids = 0;
-
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->prox;
-        total_ids++;
-    }
-
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int k = 0;
-    for(k = 0; k < total_ids; k++){
-        remover_LE(&cabeca, ids[k]);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_LE(cabeca);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos do dataset na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_busca_LE(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-    ItemListaEncadeada *cabeca = NULL;
-    carregar_dados_LE(&cabeca, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Falha ao alocar memoria\n");
-        libera_LE(cabeca);
-        exit(EXIT_FAILURE);
-    }
-
-    ItemListaEncadeada *atual = cabeca;
-    int total_ids = 0;
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->prox;
-        total_ids++;
-    }
-
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int k = 0;
-    for(k = 0; k < total_ids; k++){
-        buscar_LE(cabeca, ids[k]);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_LE(cabeca);
-
-    return tempo;
-}
-
-/*
-Mede a memória utilizada por n elementos do dataset quando inseridos na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: Memória utilizada (bytes)
-*/
-size_t bench_uso_memoria_LE(const char *nome_arquivo, int n){
-    ItemListaEncadeada *cabeca = NULL;
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    int total = 0;
-
-    fgets(linha, sizeof(linha), arq);
-
-    while(fgets(linha, sizeof(linha), arq) && total < n){
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d,%d,%49[^,],%49[^,],%f,%f,%f,%f,%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        inserir_LE(&cabeca, novo);
-        total++;
-    }
-
-    fclose(arq);
-
-    size_t cont = 0;
-    ItemListaEncadeada *atual = cabeca;
-    while(atual != NULL){
-        cont++;
-        atual = atual->prox;
-    }
-
-    size_t uso_memoria = cont * sizeof(ItemListaEncadeada);
-    libera_LE(cabeca);
-    return uso_memoria;
-}
-
-/*
-Mede o tempo de inserção de n elementos do dataset na lista encadeada com restrição de memória.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  lim_memoria_mb - limite de memória a ser utilizada
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_mem_restrita_LE(const char *nome_arquivo, double lim_memoria_mb){
-    struct timespec inicio, fim;
-
-    size_t lim_bytes = (size_t)(lim_memoria_mb * 1024 * 1024);
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arq);
-
-    ItemListaEncadeada *cabeca = NULL;
-    size_t memoria_usada = 0;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arq)){
-        if(memoria_usada + sizeof(ItemListaEncadeada) > lim_bytes){
-            printf("\nLimite de memoria atingido apos %d elementos\n", total);
-            break;
-        }
-
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d,%d,%49[^,],%49[^,],%f,%f,%f,%f,%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_LE(&cabeca, novo);
-        memoria_usada += sizeof(ItemListaEncadeada);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LE(cabeca);
-    fclose(arq);
-
-    return tempo;
-}
-
-/*
-Mede o tempo de inserção com delay de n elementos do dataset na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-  delay_ms - tempo em milisegundos a ser aplicado como delay
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_com_delay_LE(const char *nome_arquivo, int n, int delay_ms){
-    struct timespec inicio, fim;
-
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arq);
-
-    ItemListaEncadeada *cabeca = NULL;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arq) && total < n){
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d,%d,%49[^,],%49[^,],%f,%f,%f,%f,%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_LE(&cabeca, novo);
-        Sleep(delay_ms);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LE(cabeca);
-    fclose(arq);
-    return tempo;
+void carregar_dados_LE(ItemListaEncadeada **cabeca, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_LE(cabeca, &ds);
+    adotar_dataset_armazem(armazem, &ds);
 }
 
 /*
-Mede o tempo de busca com latencia de n elementos do dataset na lista encadeada.
+Indexa na lista encadeada todos os registros de um dataset já carregado em memória. O vetor
+do dataset deve permanecer alocado (normalmente transferido para o armazém de registros).
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-Retorno: tempo gasto em segundos (double)
+  cabeca - ponteiro para o ponteiro da cabeça da lista
+  ds - ponteiro para o dataset com os registros
 */
-double bench_busca_latencia_LE(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemListaEncadeada *cabeca = NULL;
-    carregar_dados_LE(&cabeca, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Erro ao alocar memoria para ids\n");
-        libera_LE(cabeca);
-        return -1;
-    }
-
-    ItemListaEncadeada *atual = cabeca;
-    int total_ids = 0;
-    while(atual != NULL && total_ids < n){
-        ids[total_ids++] = atual->id;
-        atual = atual->prox;
-    }
-
-    if(total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids);
-        libera_LE(cabeca);
-        return 0;
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
+void carregar_registros_LE(ItemListaEncadeada **cabeca, Dataset *ds){
     int i = 0;
-    for(i; i < n; i++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids[idx];
-        buscar_LE(cabeca, id_buscado);
-
-        int delay = 2 + rand() % 8;
-        Sleep(delay);
+    for(i; i < ds->total; i++){
+        inserir_LE(cabeca, &ds->itens[i]);
     }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_LE(cabeca);
-
-    return tempo;
 }
 
 /*
-Mede o tempo de inserção, com perda, de n elementos do dataset na lista encadeada.
+Busca um ID visitando no máximo lim nós da lista.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_insercao_perda_LE(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    FILE *arq = fopen(nome_arquivo, "r");
-    if(!arq){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arq);
-
-    ItemListaEncadeada *cabeca = NULL;
-    int total = 0;
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arq) && total < n){
-        if((rand() % 100) < 20){
-            continue;
-        }
-
-        ItemListaEncadeada novo;
-        sscanf(linha, "%d,%d,%49[^,],%49[^,],%f,%f,%f,%f,%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        novo.prox = NULL;
-        inserir_LE(&cabeca, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LE(cabeca);
-    fclose(arq);
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos, com limite de acessos, do dataset na lista encadeada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-  lim - limite de acessos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_lim_acessos_LE(const char *nome_arquivo, int n, int lim){
-    struct timespec inicio, fim;
-
-    ItemListaEncadeada *cabeca = NULL;
-    carregar_dados_LE(&cabeca, nome_arquivo);
-
-    int *ids = (int*)malloc(n * sizeof(int));
-    if(!ids){
-        printf("Falha ao alocar memoria para ids\n");
-        libera_LE(cabeca);
-        return -1;
-    }
-
-    ItemListaEncadeada *atual = cabeca;
-    int total_ids = 0;
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->prox;
-        total_ids++;
-    }
-
-    if(total_ids == 0){
-        printf("Nenhum id carregado!\n");
-        free(ids);
-        libera_LE(cabeca);
-        return 0;
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int i = 0;
-    for(i; i < n; i++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids[idx];
-
-        ItemListaEncadeada *ptr = cabeca;
-        int acessos = 0;
-        while(ptr != NULL && acessos < lim){
-            if(ptr->id == id_buscado){
-                break;
-            }
-            ptr = ptr->prox;
-            acessos++;
+    cabeca - ponteiro para o início da lista
+    id - identificador a ser buscado
+    lim - número máximo de nós visitados
+Retorno: ponteiro para o item encontrado ou NULL se o limite acabar antes
+*/
+ItemListaEncadeada* buscar_lim_acessos_LE(ItemListaEncadeada *cabeca, int id, int lim){
+    int acessos = 0;
+    while(cabeca != NULL && acessos < lim){
+        if(cabeca->id == id){
+            return cabeca;
         }
+        cabeca = cabeca->prox;
+        acessos++;
     }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_LE(cabeca);
-
-    return tempo;
+    return NULL;
 }
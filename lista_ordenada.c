@@ -2,8 +2,8 @@
 ->lista_ordenada.c
 Implementação de uma lista encadeada ordenada por ID para manipulação de amostras agrícolas.
 Este arquivo contém as funções para inserir, remover, buscar, filtrar, imprimir 
-e carregar dados em uma lista encadeada simples, além de funções auxiliares
-e do conjunto de nove funções para benchamark.
+e carregar dados em uma lista ordenada, além de funções auxiliares e das primitivas
+usadas pelo modo benchmark (bench.c).
 */
 
 #include <stdio.h>
@@ -12,22 +12,39 @@ e do conjunto de nove funções para benchamark.
 #include <strings.h>
 #include <time.h>
 #include "lista_ordenada.h"
+#include "memoria.h"
 #include <windows.h>
 
 /*
-Insere um novo elemento na lista ordenada por ID.
+Cria um novo nó da lista ordenada que aponta para o registro fornecido.
+Parâmetro: registro - ponteiro para o registro a ser indexado
+Retorno: ponteiro para o novo nó
+*/
+static ItemLista* novo_item_LO(Registro *registro){
+    ItemLista *item = (ItemLista*)alocar_memoria(MEMORIA_LISTA_ORDENADA, sizeof(ItemLista));
+    if(!item){
+        printf("Erro ao alocar memoria\n");
+        exit(EXIT_FAILURE);
+    }
+    item->id = registro->id;
+    item->registro = registro;
+    item->prox = NULL;
+    return item;
+}
+
+/*
+Insere um novo elemento na lista ordenada por ID. O nó guarda apenas o ID e o ponteiro para
+o registro, que pertence ao armazém de registros.
 Parâmetros:
     cabeca - ponteiro para a cabeça da lista
-    novo - estrutura com os dados a serem inseridos
+    registro - ponteiro para o registro a ser indexado
 */
-void insereOrdenadoID_LO(ItemLista **cabeca, ItemLista novo){
-    ItemLista *auxiliar = (ItemLista*)malloc(sizeof(ItemLista));
-    *auxiliar = novo;
-    auxiliar->prox = NULL;
+void insereOrdenadoID_LO(ItemLista **cabeca, Registro *registro){
+    ItemLista *auxiliar = novo_item_LO(registro);
 
 
     if(*cabeca==NULL || (*cabeca)->id > auxiliar->id){
-        auxiliar->prox = NULL;
+        auxiliar->prox = *cabeca;
         *cabeca = auxiliar;
     }
 
@@ -42,6 +59,61 @@ void insereOrdenadoID_LO(ItemLista **cabeca, ItemLista novo){
     }
 }
 
+/*
+Compara dois ponteiros de registro pelo ID, para uso com qsort.
+*/
+static int comparar_ponteiros_id_LO(const void *a, const void *b){
+    const Registro *ra = *(const Registro* const*)a;
+    const Registro *rb = *(const Registro* const*)b;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+/*
+Insere um lote de registros na lista ordenada de uma só vez. O lote é ordenado por ID (a
+ordenação é pulada se ele já vier em ordem) e depois intercalado com a lista em uma única
+passada, sem voltar ao início da lista para cada elemento. Quando a lista existente acaba,
+o restante do lote é apenas encadeado no final, sem comparações; é o que acontece ao carregar
+o arquivo, cujos IDs são crescentes. O custo total é O(n + m log m) em vez de O(n * m).
+Parâmetros:
+    cabeca - ponteiro para a cabeça da lista
+    registros - vetor de ponteiros para os registros do lote (pode ser reordenado)
+    n - número de registros do lote
+*/
+void inserir_lote_LO(ItemLista **cabeca, Registro **registros, int n){
+    int ordenado = 1;
+    int i = 1;
+    for(i; i < n && ordenado; i++){
+        if(registros[i]->id < registros[i - 1]->id){
+            ordenado = 0;
+        }
+    }
+    if(!ordenado){
+        qsort(registros, n, sizeof(Registro*), comparar_ponteiros_id_LO);
+    }
+
+    ItemLista **ligacao = cabeca;
+    int j = 0;
+    for(j; j < n; j++){
+        while(*ligacao != NULL && (*ligacao)->id < registros[j]->id){
+            ligacao = &(*ligacao)->prox;
+        }
+        if(*ligacao == NULL){
+            break;
+        }
+
+        ItemLista *item = novo_item_LO(registros[j]);
+        item->prox = *ligacao;
+        *ligacao = item;
+        ligacao = &item->prox;
+    }
+
+    for(j; j < n; j++){
+        ItemLista *item = novo_item_LO(registros[j]);
+        *ligacao = item;
+        ligacao = &item->prox;
+    }
+}
+
 /*
 Imprime todos os elementos na lista ordenada por ID.
 Parâmetros:
@@ -51,9 +123,10 @@ void imprime_LO(ItemLista *cabeca){
     ItemLista *atual = cabeca;
     int i = 0;
     while(atual!=NULL){
+        const Registro *r = atual->registro;
         printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-             atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton,
-              atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
+             r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+              r->rendimento, r->producao, r->area_plantada, r->valor_total);
         i++;
         atual = atual->prox;
     }
@@ -72,69 +145,100 @@ void libera_LO(ItemLista *cabeca){
     while(atual!=NULL){
         liberado = atual;
         atual = atual->prox;
-        free(liberado);
+        liberar_memoria(MEMORIA_LISTA_ORDENADA, liberado);
     }
 }
 
 /*
-Carrega as informações do dataset para a lista ordenada.
+Carrega as informações do dataset para a lista ordenada. Os registros passam a pertencer
+ao armazém.
 Parâmetros:
     cabeca - ponteiro para a cabeça da lista
+    armazem - ponteiro para o armazém que recebe os registros
     nome_arquivo - nome do arquivo de entrada (dataset)
 */
-void carregar_dados_LO(ItemLista **cabeca, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo");
-        exit(EXIT_FAILURE);
-    }
+void carregar_dados_LO(ItemLista **cabeca, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_LO(cabeca, &ds);
+    adotar_dataset_armazem(armazem, &ds);
+}
 
-    char linha[256];
-    
-    fgets(linha, sizeof(linha), arquivo);
-    
-    while(fgets(linha, sizeof(linha), arquivo)){
-        ItemLista novo;
+/*
+Indexa na lista ordenada todos os registros de um dataset já carregado em memória, como um
+único lote (ver inserir_lote_LO). O vetor do dataset deve permanecer alocado (normalmente
+transferido para o armazém de registros).
+Parâmetros:
+    cabeca - ponteiro para a cabeça da lista
+    ds - ponteiro para o dataset com os registros
+*/
+void carregar_registros_LO(ItemLista **cabeca, Dataset *ds){
+    if(ds->total == 0){
+        return;
+    }
 
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
+    Registro **registros = (Registro**)alocar_memoria(MEMORIA_LISTA_ORDENADA, ds->total * sizeof(Registro*));
+    if(!registros){
+        printf("Erro ao alocar memoria\n");
+        exit(EXIT_FAILURE);
+    }
 
-        insereOrdenadoID_LO(cabeca, novo);
+    int i = 0;
+    for(i; i < ds->total; i++){
+        registros[i] = &ds->itens[i];
     }
+    inserir_lote_LO(cabeca, registros, ds->total);
 
-    fclose(arquivo);
+    liberar_memoria(MEMORIA_LISTA_ORDENADA, registros);
+}
+
+/*
+Imprime uma linha do resultado de buscarFiltros_LO.
+Parâmetro: r - ponteiro para o registro
+*/
+static void imprimir_resultado_LO(const Registro *r){
+    printf("%d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
+     r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton, 
+     r->rendimento, r->producao, r->area_plantada, r->valor_total);
 }
 
 /*
-Busca e imprime elementos que atendem aos filtros de ano, estado e cultura.
+Busca e imprime elementos que atendem aos filtros de ano, estado e cultura, percorrendo a
+lista ou, quando há índice de bitmaps, consultando o índice.
 Parâmetros:
   cabeca - ponteiro para a cabeça da lista
   ano_min, ano_max - intervalo de anos
   cultura - filtro de cultura (string)
   estado - filtro de estado (string)
+  indice - índice de bitmaps sobre os mesmos registros, ou NULL para percorrer a lista
 */
-void buscarFiltros_LO(ItemLista *cabeca, int ano_min, int ano_max, const char *estado, const char *cultura){
+void buscarFiltros_LO(ItemLista *cabeca, int ano_min, int ano_max, const char *estado, const char *cultura, const IndiceBitmap *indice){
     ItemLista *atual = cabeca;
     int encontrados = 0;
 
     printf("\n===RESULTADOS DA BUSCA===\n");
 
-    while (atual != NULL){
-        int ano_certo = (atual->ano >= ano_min) && (atual->ano <= ano_max);
+    if(indice != NULL){
+        encontrados = imprimir_filtro_indice_bitmap(indice, ano_min, ano_max, estado, cultura, imprimir_resultado_LO);
+    }else{
+        int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+        int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
 
-        int estado_certo = (estado == NULL || strcasecmp(atual->estado, estado) == 0);
+        while (atual != NULL){
+            const Registro *r = atual->registro;
+            int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
 
-        int cultura_certa = (cultura == NULL || strcasecmp(atual->cultura, cultura) == 0);
+            int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, filtro_estado);
 
-        if(ano_certo && estado_certo && cultura_certa){
-            printf("%d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-             atual->ano, atual->estado, atual->cultura, atual->preco_ton, 
-             atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
-             
-             encontrados++;
+            int cultura_certa = ACEITA_FILTRO(dicionario_culturas, r->cultura, filtro_cultura);
+
+            if(ano_certo && estado_certo && cultura_certa){
+                imprimir_resultado_LO(r);
+                encontrados++;
+            }
+            atual = atual->prox;
         }
-        atual = atual->prox;
     }
 
     if(encontrados == 0){
@@ -147,82 +251,19 @@ void buscarFiltros_LO(ItemLista *cabeca, int ano_min, int ano_max, const char *e
 
 /*
 Cria uma nova amostra a partir da entrada do usuário e insere na lista ordenada.
-Parâmetro: cabeca - ponteiro para o ponteiro da cabeça da lista
+Parâmetros:
+    cabeca - ponteiro para o ponteiro da cabeça da lista
+    armazem - ponteiro para o armazém que recebe o novo registro
 */
-void criar_amostra_LO(ItemLista **cabeca){
-    ItemLista novo;
-    char entrada[50];
-
-    printf("\n===Insira os dados da nova amostra===\n");
-
-    novo.id = criar_id_LO(*cabeca);
-
-    printf("Ano: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%d", &novo.ano);
-
-    printf("Estado: ");
-    fgets(novo.estado, sizeof(novo.estado), stdin);
-    novo.estado[strcspn(novo.estado, "\n")] = '\0';
-
-    printf("Cultura: ");
-    fgets(novo.cultura, sizeof(novo.cultura), stdin);
-    novo.cultura[strcspn(novo.cultura, "\n")] = '\0';
-
-    printf("Preco por tonelada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.preco_ton);
-
-    printf("Rendimento: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.rendimento);
-
-    printf("Produção: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.producao);
-
-    printf("Area plantada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.area_plantada);
-
-    printf("Valor total: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &novo.valor_total);
+void criar_amostra_LO(ItemLista **cabeca, ArmazemRegistros *armazem){
+    Registro novo;
+    ler_registro_usuario(&novo, criar_id_LO(*cabeca) + 1);
 
-    novo.prox = NULL;
-
-    insereOrdenadoID_LO(cabeca, novo);
+    insereOrdenadoID_LO(cabeca, adicionar_armazem(armazem, &novo));
 
     printf("\nAmostra inserida com sucesso\n");
 }
 
-/*
-Salva todos os elementos da lista ordenada no dataset.
-Parâmetros:
-  cabeca - ponteiro para a cabeça da lista
-  nome_arquivo - nome do arquivo de saída (dataset)
-*/
-void salvar_dados_LO(ItemLista *cabeca, const char *nome_arquivo){
-    FILE *arquivo = fopen(nome_arquivo, "w");
-    
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(arquivo, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
-    ItemLista *atual = cabeca;
-    while(atual != NULL){
-        fprintf(arquivo, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n",
-                atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton, 
-                atual->rendimento, atual->producao, atual->area_plantada, 
-                atual->valor_total);
-            
-            atual = atual->prox;
-    }
-    fclose(arquivo);
-}
-
 /*
 Função auxiliar para a criação de amostras. Retorna o maior ID presente na lista ordenada.
 Parâmetro: cabeca - ponteiro para a cabeça da lista
@@ -274,7 +315,7 @@ void remover_LO(ItemLista **cabeca, int id){
 
     if(atual->id == id){
         *cabeca = atual->prox;
-        free(atual);
+        liberar_memoria(MEMORIA_LISTA_ORDENADA, atual);
         return;
     }
 
@@ -289,420 +330,25 @@ void remover_LO(ItemLista **cabeca, int id){
     }
 
     anterior->prox  = atual->prox;
-    free(atual);
-}
-
-/*
-Mede o tempo de inserção de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_insercao_LO(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemLista *cabeca = NULL;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemLista novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-        novo.prox = NULL;
-        insereOrdenadoID_LO(&cabeca, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LO(cabeca);
-    fclose(arquivo);
-    return tempo;
-}
-
-/*
-Mede o tempo de remoção de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_remocao_LO(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemLista *cabeca = NULL;
-    carregar_dados_LO(&cabeca, nome_arquivo);
-
-    int *ids = (int *)(malloc(n*sizeof(int)));
-    if(!ids){
-        printf("Falha ao alocar memoria\n");
-        libera_LO(cabeca);
-        exit(EXIT_FAILURE);
-    }
-
-    ItemLista *atual = cabeca;
-    int total_ids = 0;
-
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->prox;
-        total_ids++;
-    }
-
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int k = 0;
-    for(k; k<total_ids; k++){
-        remover_LO(&cabeca, ids[k]);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_LO(cabeca);
-
-    return tempo;
-
-}
-
-/*
-Mede o tempo de busca de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_busca_LO(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemLista *cabeca = NULL;
-    carregar_dados_LO(&cabeca, nome_arquivo);
-
-    int maior_id = 0;
-    ItemLista *atual = cabeca;
-
-    while(atual != NULL){
-        if(atual->id > maior_id){
-            maior_id = atual->id;
-        }
-        atual = atual->prox;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    int i = 0;
-    for(i; i<n; i++){
-        int id_buscado = rand() % maior_id + 1;
-        buscarId_LO(cabeca, id_buscado);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    libera_LO(cabeca);
-    return tempo;
-}
-
-/*
-Mede o uso de memoria de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: memória utilizada (bytes)
-*/
-size_t bench_uso_memoria_LO(const char *nome_arquivo, int n){
-    ItemLista *cabeca = NULL;
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    int total = 0;
-
-    fgets(linha, sizeof(linha), arquivo);
-    
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemLista novo;
-
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-
-        insereOrdenadoID_LO(&cabeca, novo);
-    }
-
-    fclose(arquivo);
-
-    size_t cont = 0;
-    ItemLista *atual = cabeca;
-    while(atual != NULL){
-        cont++;
-        atual = atual->prox;
-    }
-
-    size_t uso_memoria = cont * sizeof(ItemLista);
-    libera_LO(cabeca);
-    return uso_memoria;
+    liberar_memoria(MEMORIA_LISTA_ORDENADA, atual);
 }
 
 /*
-Mede o tempo de inserção com memória restrita de n elementos do dataset na lista ordenada.
+Busca um ID visitando no máximo lim nós da lista.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  lim_memoria - limite de memória a ser utilizada
-Retorno: tempo gasto em segundos (double)
+    cabeca - ponteiro para o início da lista
+    id - identificador a ser buscado
+    lim - número máximo de nós visitados
+Retorno: ponteiro para o item encontrado ou NULL se o limite acabar antes
 */
-double bench_insercao_mem_restrita_LO(const char *nome_arquivo, double lim_memoria){
-    struct timespec inicio, fim;
-
-    size_t lim_bytes = (size_t)(lim_memoria * 1024 * 1024);
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemLista *cabeca = NULL;
-    int total = 0;
-    size_t memoria_usada = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo)){
-        if(memoria_usada + sizeof(ItemLista) > lim_bytes){
-            printf("\nLimite de memoria atingido apos %d elementos\n", total);
-            break;
+ItemLista *buscar_lim_acessos_LO(ItemLista *cabeca, int id, int lim){
+    int acessos = 0;
+    while(cabeca != NULL && acessos < lim){
+        if(cabeca->id == id){
+            return cabeca;
         }
-        ItemLista novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-        novo.prox = NULL;
-        insereOrdenadoID_LO(&cabeca, novo);
-        memoria_usada += sizeof(ItemLista);  
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LO(cabeca);
-    fclose(arquivo);
-    return tempo;
-
-}
-
-/*
-Mede o tempo de inserção com delay de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  delay_ms - tempo em milisegundos a ser aplicado como delay
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_com_delay_LO(const char *nome_arquivo, int n, int delay_ms){
-    struct timespec inicio, fim;
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemLista *cabeca = NULL;
-    int total = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ItemLista novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-        novo.prox = NULL;
-        insereOrdenadoID_LO(&cabeca, novo);
-        Sleep(delay_ms);
-        total++;
+        cabeca = cabeca->prox;
+        acessos++;
     }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LO(cabeca);
-    fclose(arquivo);
-    return tempo;
-}
-
-/*
-Mede o tempo de busca com latência de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_latencia_LO(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    ItemLista *cabeca = NULL;
-    carregar_dados_LO(&cabeca, nome_arquivo);
-    int maior_id = 0;
-    ItemLista *atual = cabeca;
-    while(atual != NULL){
-        if(atual->id > maior_id){
-            maior_id = atual->id;
-        }
-        atual = atual->prox;
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    int i = 0;
-    for(i; i < n; i++){
-        int id_buscado = rand() % maior_id + 1;
-        buscarId_LO(cabeca, id_buscado);
-        int delay = 2 + rand() % 8;
-        Sleep(delay);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    libera_LO(cabeca);
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    return tempo;
-}
-
-/*
-Mede o tempo de isnerção de n elementos do dataset, com perda, na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_temp_insercao_perda_LO(const char *nome_arquivo, int n){
-    struct timespec inicio, fim;
-
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    ItemLista *cabeca = NULL;
-    int total = 0;
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        if((rand() % 100) < 20){
-            continue;
-        }
-        
-        ItemLista novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f", 
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, 
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-        novo.prox = NULL;
-        insereOrdenadoID_LO(&cabeca, novo);
-        total++;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    libera_LO(cabeca);
-    fclose(arquivo);
-    return tempo;
-}
-
-/*
-Mede o tempo de busca de n elementos do dataset na lista ordenada.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-  lim - limite de acessos
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_busca_lim_acessos_LO(const char *nome_arquivo, int n, int lim){
-    struct timespec inicio, fim;
-    
-    ItemLista *cabeca = NULL;
-    carregar_dados_LO(&cabeca, nome_arquivo);
-
-    int maior_id = 0;
-    ItemLista *atual = cabeca;
-    
-    while(atual != NULL){
-        if(atual->id > maior_id){
-            maior_id = atual->id;
-            atual = atual->prox;
-        }
-    }
-
-    srand(time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    int i = 0;
-    for(i; i < n; i++){
-        int id_buscado = rand() % maior_id + 1;
-
-        ItemLista *ptr = cabeca;
-        int acessos = 0;
-
-        while(ptr != NULL && acessos < lim){
-            if(ptr->id == id_buscado){
-                break;
-            }
-            ptr = ptr->prox;
-            acessos++;
-        }
-    }
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    libera_LO(cabeca);
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    return tempo;
+    return NULL;
 }
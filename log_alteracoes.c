@@ -0,0 +1,202 @@
+/*
+->log_alteracoes.c
+Implementação do log de alterações do dataset de amostras agrícolas.
+Inserções e remoções feitas pelo CRUD são acrescentadas ao final de um arquivo de log
+(ex: Dados.csv.log) em vez de regravar o CSV inteiro a cada alteração. Na inicialização o log
+é reaplicado sobre o dataset carregado, e a compactação incorpora o log ao CSV (e ao snapshot),
+esvaziando-o.
+Formato das linhas do log:
+    I;id;ano;estado;cultura;preco;rendimento;producao;area;valor  (inserção)
+    R;id                                                          (remoção)
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include <io.h>
+#include "log_alteracoes.h"
+#include "snapshot.h"
+
+/*
+Monta o nome do arquivo de log correspondente ao dataset (ex: Dados.csv.log).
+Parâmetros:
+    nome_arquivo - nome do arquivo do dataset
+    destino - vetor que recebe o nome do log
+    tamanho - tamanho do vetor de destino
+*/
+void nome_log(const char *nome_arquivo, char *destino, int tamanho){
+    snprintf(destino, tamanho, "%s%s", nome_arquivo, EXTENSAO_LOG);
+}
+
+/*
+Abre o log para acrescentar uma entrada. Encerra o programa se o arquivo não puder ser aberto.
+Parâmetro: nome_arquivo - nome do arquivo do dataset
+Retorno: ponteiro para o arquivo de log aberto
+*/
+static FILE* abrir_log(const char *nome_arquivo){
+    char nome[300];
+    nome_log(nome_arquivo, nome, sizeof(nome));
+
+    FILE *arquivo = fopen(nome, "a");
+    if(!arquivo){
+        printf("Erro ao abrir o arquivo %s\n", nome);
+        exit(EXIT_FAILURE);
+    }
+    return arquivo;
+}
+
+/*
+Leva a entrada recém-escrita ao disco e fecha o log. A alteração já foi aplicada às
+estruturas em memória, então ela só é confirmada ao usuário depois de gravada; se a gravação
+falhar, o programa é encerrado.
+Parâmetros:
+    arquivo - log aberto por abrir_log
+    nome_arquivo - nome do arquivo do dataset
+*/
+static void fechar_log(FILE *arquivo, const char *nome_arquivo){
+    int falhou = fflush(arquivo) != 0 || _commit(_fileno(arquivo)) != 0;
+    if(fclose(arquivo) != 0 || falhou){
+        char nome[300];
+        nome_log(nome_arquivo, nome, sizeof(nome));
+        printf("Erro ao gravar o arquivo %s\n", nome);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+Acrescenta ao log a inserção de uma amostra.
+Parâmetros:
+    nome_arquivo - nome do arquivo do dataset
+    r - ponteiro para o registro inserido
+*/
+void registrar_insercao_log(const char *nome_arquivo, const Registro *r){
+    FILE *arquivo = abrir_log(nome_arquivo);
+    fputs("I;", arquivo);
+    escrever_registro_csv(arquivo, r);
+    fechar_log(arquivo, nome_arquivo);
+}
+
+/*
+Acrescenta ao log a remoção de uma amostra.
+Parâmetros:
+    nome_arquivo - nome do arquivo do dataset
+    id - identificador da amostra removida
+*/
+void registrar_remocao_log(const char *nome_arquivo, int id){
+    FILE *arquivo = abrir_log(nome_arquivo);
+    fprintf(arquivo, "R;%d\n", id);
+    fechar_log(arquivo, nome_arquivo);
+}
+
+/*
+Reaplica sobre o dataset as alterações registradas no log, na ordem em que foram feitas.
+Linhas incompletas (sem quebra de linha, por exemplo após uma queda durante a gravação)
+são ignoradas. Reaplicar uma entrada já incorporada ao CSV não altera o resultado.
+Parâmetros:
+    ds - ponteiro para o dataset (ordenado por ID)
+    nome_arquivo - nome do arquivo do dataset
+Retorno: número de entradas lidas do log
+*/
+int aplicar_log(Dataset *ds, const char *nome_arquivo){
+    char nome[300];
+    nome_log(nome_arquivo, nome, sizeof(nome));
+
+    ArquivoMapeado am;
+    if(!mapear_arquivo(&am, nome)){
+        return 0;
+    }
+
+    const char *cursor = am.dados;
+    const char *fim = am.dados + am.tamanho;
+    int entradas = 0;
+
+    while(cursor != NULL && cursor < fim){
+        const char *quebra = (const char*)memchr(cursor, '\n', fim - cursor);
+        if(quebra == NULL){
+            break;
+        }
+
+        if(quebra - cursor > 2 && cursor[1] == ';'){
+            if(cursor[0] == 'I'){
+                const char *linha = cursor + 2;
+                Registro novo;
+                if(ler_linha_csv(&linha, quebra + 1, &novo)){
+                    inserir_ordenado_dataset(ds, novo);
+                    entradas++;
+                }
+            }else if(cursor[0] == 'R'){
+                const char *p = cursor + 2;
+                int id = 0;
+                int digitos = 0;
+                while(p < quebra && *p >= '0' && *p <= '9'){
+                    id = id * 10 + (*p - '0');
+                    digitos++;
+                    p++;
+                }
+                if(digitos > 0){
+                    remover_dataset(ds, id);
+                    entradas++;
+                }
+            }
+        }
+
+        cursor = quebra + 1;
+    }
+
+    desmapear_arquivo(&am);
+    return entradas;
+}
+
+/*
+Incorpora ao arquivo base um dataset que já contém as alterações do log: regrava o CSV,
+atualiza o snapshot e só então esvazia o log.
+Parâmetros:
+    ds - ponteiro para o dataset com o log já aplicado
+    nome_arquivo - nome do arquivo do dataset
+*/
+void compactar_dataset(const Dataset *ds, const char *nome_arquivo){
+    salvar_dataset_csv(ds, nome_arquivo);
+    salvar_snapshot(ds, nome_arquivo);
+
+    char nome[300];
+    nome_log(nome_arquivo, nome, sizeof(nome));
+    remove(nome);
+}
+
+/*
+Compara dois registros pelo ID, para uso com qsort.
+*/
+static int comparar_registros_id_log(const void *a, const void *b){
+    const Registro *ra = (const Registro*)a;
+    const Registro *rb = (const Registro*)b;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+/*
+Compacta o log sob demanda. O armazém em memória já contém o arquivo base com todas as
+alterações do log aplicadas, então os seus registros são copiados em ordem de ID e
+incorporados ao CSV, sem reler o arquivo base, e o log é esvaziado.
+Parâmetros:
+    armazem - ponteiro para o armazém com os registros atuais
+    nome_arquivo - nome do arquivo do dataset
+*/
+void compactar_log(const ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    int i = 0;
+    for(i; i < armazem->n_blocos; i++){
+        const BlocoRegistros *bloco = &armazem->blocos[i];
+        int j = 0;
+        for(j; j < bloco->usados; j++){
+            if(bloco->itens[j].id != ID_LIVRE_ARMAZEM){
+                adicionar_dataset(&ds, bloco->itens[j]);
+            }
+        }
+    }
+    if(!dataset_ordenado(&ds)){
+        qsort(ds.itens, ds.total, sizeof(Registro), comparar_registros_id_log);
+    }
+    compactar_dataset(&ds, nome_arquivo);
+    liberar_dataset(&ds);
+}
@@ -0,0 +1,18 @@
+#ifndef LOG_ALTERACOES_H
+#define LOG_ALTERACOES_H
+
+#include <stdio.h>
+#include "dataset.h"
+#include "registros.h"
+
+#define EXTENSAO_LOG ".log"
+#define LIMITE_ENTRADAS_LOG 1000
+
+void nome_log(const char *nome_arquivo, char *destino, int tamanho);
+void registrar_insercao_log(const char *nome_arquivo, const Registro *r);
+void registrar_remocao_log(const char *nome_arquivo, int id);
+int aplicar_log(Dataset *ds, const char *nome_arquivo);
+void compactar_dataset(const Dataset *ds, const char *nome_arquivo);
+void compactar_log(const ArmazemRegistros *armazem, const char *nome_arquivo);
+
+#endif
@@ -0,0 +1,298 @@
+/*
+->memoria.c
+Implementação da contabilidade de memória do programa. Todos os módulos alocam e liberam por
+estas funções, informando a categoria (estrutura ou módulo) dona do bloco, e cada categoria
+acumula os bytes vivos, o pico de bytes vivos e o número de alocações e liberações.
+Os bytes contados são o tamanho real de cada bloco no heap, obtido do próprio alocador
+(malloc_usable_size na glibc, _msize no Windows) mais o cabeçalho que o alocador guarda antes
+do bloco, e não o tamanho pedido; assim o arredondamento, o alinhamento e o cabeçalho de cada
+nó entram na conta. Os contadores são atualizados com operações atômicas, pois a leitura
+paralela, a agregação e a skiplist concorrente alocam a partir de várias threads.
+O total contado pode ser comparado ao RSS do processo (/proc/self/status no Linux,
+GetProcessMemoryInfo no Windows), que inclui também a fragmentação do heap, a pilha e o código.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+#include "memoria.h"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#include <psapi.h>
+#define tamanho_usavel(p) _msize(p)
+#define CABECALHO_BLOCO_MEMORIA 16
+#define ALINHAMENTO_BLOCO_MEMORIA 16
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#define tamanho_usavel(p) malloc_usable_size(p)
+#define CABECALHO_BLOCO_MEMORIA sizeof(size_t)
+#define ALINHAMENTO_BLOCO_MEMORIA 1
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define tamanho_usavel(p) malloc_size(p)
+#define CABECALHO_BLOCO_MEMORIA 0
+#define ALINHAMENTO_BLOCO_MEMORIA 1
+#else
+#define tamanho_usavel(p) 0
+#define CABECALHO_BLOCO_MEMORIA 0
+#define ALINHAMENTO_BLOCO_MEMORIA 1
+#endif
+
+static const char *nomes_categorias_memoria[TOTAL_CATEGORIAS_MEMORIA] = {
+    "Geral", "Dataset", "Armazem de registros", "Dicionarios", "Lista Encadeada",
+    "Lista Ordenada", "Arvore AVL", "Hash", "Hash aberto", "Skiplist", "Trie",
+    "Indice de bitmaps", "Tabela colunar", "Agregacao", "Series", "Snapshot"
+};
+
+static ContadorMemoria contadores_memoria[TOTAL_CATEGORIAS_MEMORIA];
+static ContadorMemoria total_memoria;
+
+/*
+Retorna quanto um bloco ocupa no heap: o tamanho utilizável informado pelo alocador,
+arredondado ao alinhamento do heap, mais o cabeçalho do bloco. Em plataformas sem consulta
+ao alocador o bloco não é contado.
+*/
+static long long tamanho_bloco_memoria(void *p){
+    size_t usavel = tamanho_usavel(p);
+    if(usavel == 0){
+        return 0;
+    }
+    usavel = (usavel + ALINHAMENTO_BLOCO_MEMORIA - 1) / ALINHAMENTO_BLOCO_MEMORIA * ALINHAMENTO_BLOCO_MEMORIA;
+    return (long long)(usavel + CABECALHO_BLOCO_MEMORIA);
+}
+
+/*
+Eleva o pico de um contador até vivos, se vivos for maior. Usa comparação e troca porque
+outra thread pode estar atualizando o mesmo pico.
+*/
+static void atualizar_pico_memoria(ContadorMemoria *contador, long long vivos){
+    long long atual = contador->pico;
+    while(vivos > atual){
+        long long anterior = InterlockedCompareExchange64(&contador->pico, vivos, atual);
+        if(anterior == atual){
+            return;
+        }
+        atual = anterior;
+    }
+}
+
+/*
+Soma uma variação de bytes vivos a uma categoria e ao total.
+*/
+static void somar_memoria(int categoria, long long bytes){
+    ContadorMemoria *contador = &contadores_memoria[categoria];
+    long long vivos = InterlockedExchangeAdd64(&contador->vivos, bytes) + bytes;
+    long long total = InterlockedExchangeAdd64(&total_memoria.vivos, bytes) + bytes;
+    if(bytes > 0){
+        atualizar_pico_memoria(contador, vivos);
+        atualizar_pico_memoria(&total_memoria, total);
+    }
+}
+
+/*
+Registra um bloco recém-alocado.
+*/
+static void registrar_alocacao_memoria(int categoria, void *p){
+    InterlockedExchangeAdd64(&contadores_memoria[categoria].alocacoes, 1);
+    InterlockedExchangeAdd64(&total_memoria.alocacoes, 1);
+    somar_memoria(categoria, tamanho_bloco_memoria(p));
+}
+
+/*
+Aloca um bloco de memória em nome de uma categoria, como malloc.
+Parâmetros:
+    categoria - dona do bloco (MEMORIA_*)
+    tamanho - número de bytes
+Retorno: ponteiro para o bloco ou NULL em caso de falha
+*/
+void* alocar_memoria(int categoria, size_t tamanho){
+    void *p = malloc(tamanho);
+    if(p != NULL){
+        registrar_alocacao_memoria(categoria, p);
+    }
+    return p;
+}
+
+/*
+Aloca um bloco zerado em nome de uma categoria, como calloc.
+Parâmetros:
+    categoria - dona do bloco (MEMORIA_*)
+    quantidade - número de elementos
+    tamanho - tamanho de cada elemento
+Retorno: ponteiro para o bloco ou NULL em caso de falha
+*/
+void* alocar_zerada_memoria(int categoria, size_t quantidade, size_t tamanho){
+    void *p = calloc(quantidade, tamanho);
+    if(p != NULL){
+        registrar_alocacao_memoria(categoria, p);
+    }
+    return p;
+}
+
+/*
+Redimensiona um bloco da categoria, como realloc. Se a realocação falhar, o bloco antigo
+continua válido e contado.
+Parâmetros:
+    categoria - dona do bloco (MEMORIA_*)
+    p - bloco atual (pode ser NULL)
+    tamanho - novo tamanho em bytes
+Retorno: ponteiro para o bloco redimensionado ou NULL em caso de falha
+*/
+void* realocar_memoria(int categoria, void *p, size_t tamanho){
+    if(p == NULL){
+        return alocar_memoria(categoria, tamanho);
+    }
+    long long antigo = tamanho_bloco_memoria(p);
+    void *novo = realloc(p, tamanho);
+    if(novo == NULL){
+        return NULL;
+    }
+    somar_memoria(categoria, tamanho_bloco_memoria(novo) - antigo);
+    return novo;
+}
+
+/*
+Libera um bloco da categoria, como free.
+Parâmetros:
+    categoria - dona do bloco (a mesma informada na alocação)
+    p - bloco a ser liberado (pode ser NULL)
+*/
+void liberar_memoria(int categoria, void *p){
+    if(p == NULL){
+        return;
+    }
+    InterlockedExchangeAdd64(&contadores_memoria[categoria].liberacoes, 1);
+    InterlockedExchangeAdd64(&total_memoria.liberacoes, 1);
+    somar_memoria(categoria, -tamanho_bloco_memoria(p));
+    free(p);
+}
+
+/*
+Passa a conta de um bloco de uma categoria para outra, quando um módulo adota memória alocada
+por outro (por exemplo, o armazém adotando o vetor de um dataset).
+Parâmetros:
+    origem - categoria que alocou o bloco
+    destino - categoria que passa a ser dona do bloco
+    p - bloco transferido
+*/
+void transferir_memoria(int origem, int destino, void *p){
+    if(p == NULL || origem == destino){
+        return;
+    }
+    long long tamanho = tamanho_bloco_memoria(p);
+    InterlockedExchangeAdd64(&contadores_memoria[origem].liberacoes, 1);
+    InterlockedExchangeAdd64(&contadores_memoria[origem].vivos, -tamanho);
+    InterlockedExchangeAdd64(&contadores_memoria[destino].alocacoes, 1);
+    long long vivos = InterlockedExchangeAdd64(&contadores_memoria[destino].vivos, tamanho) + tamanho;
+    atualizar_pico_memoria(&contadores_memoria[destino], vivos);
+}
+
+/*
+Retorna o nome de uma categoria.
+Parâmetro: categoria - número da categoria (MEMORIA_*)
+Retorno: nome da categoria ou "desconhecida"
+*/
+const char* nome_categoria_memoria(int categoria){
+    if(categoria < 0 || categoria >= TOTAL_CATEGORIAS_MEMORIA){
+        return "desconhecida";
+    }
+    return nomes_categorias_memoria[categoria];
+}
+
+/*
+Copia os contadores de uma categoria.
+Parâmetros:
+    categoria - número da categoria (MEMORIA_*)
+    contador - recebe a cópia
+*/
+void consultar_memoria(int categoria, ContadorMemoria *contador){
+    *contador = contadores_memoria[categoria];
+}
+
+/*
+Copia os contadores somados de todas as categorias. O pico total é o maior total de bytes
+vivos já observado, que pode ser menor que a soma dos picos das categorias.
+Parâmetro: contador - recebe a cópia
+*/
+void consultar_total_memoria(ContadorMemoria *contador){
+    *contador = total_memoria;
+}
+
+/*
+Retorna os bytes vivos de uma categoria.
+Parâmetro: categoria - número da categoria (MEMORIA_*)
+Retorno: bytes vivos
+*/
+long long memoria_viva(int categoria){
+    return contadores_memoria[categoria].vivos;
+}
+
+/*
+Lê a memória residente (RSS) do processo e o seu pico.
+Parâmetros:
+    atual - recebe o RSS atual em bytes
+    pico - recebe o maior RSS do processo em bytes
+Retorno: 1 se a informação estiver disponível, 0 caso contrário
+*/
+int rss_processo_memoria(size_t *atual, size_t *pico){
+    *atual = 0;
+    *pico = 0;
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS contadores;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))){
+        return 0;
+    }
+    *atual = contadores.WorkingSetSize;
+    *pico = contadores.PeakWorkingSetSize;
+    return 1;
+#else
+    FILE *arquivo = fopen("/proc/self/status", "r");
+    if(!arquivo){
+        return 0;
+    }
+    char linha[256];
+    unsigned long long kb;
+    int encontrados = 0;
+    while(fgets(linha, sizeof(linha), arquivo)){
+        if(sscanf(linha, "VmRSS: %llu kB", &kb) == 1){
+            *atual = (size_t)kb * 1024;
+            encontrados++;
+        }else if(sscanf(linha, "VmHWM: %llu kB", &kb) == 1){
+            *pico = (size_t)kb * 1024;
+            encontrados++;
+        }
+    }
+    fclose(arquivo);
+    return encontrados == 2;
+#endif
+}
+
+/*
+Exibe os contadores de cada categoria com memória viva ou alocações, o total contado e a
+comparação com o RSS do processo.
+*/
+void imprimir_memoria(void){
+    printf("\n%-22s %14s %14s %12s %12s\n", "Categoria", "Vivos (bytes)", "Pico (bytes)", "Alocacoes", "Liberacoes");
+    int i = 0;
+    for(i; i < TOTAL_CATEGORIAS_MEMORIA; i++){
+        const ContadorMemoria *c = &contadores_memoria[i];
+        if(c->alocacoes == 0 && c->vivos == 0){
+            continue;
+        }
+        printf("%-22s %14lld %14lld %12lld %12lld\n", nomes_categorias_memoria[i], c->vivos, c->pico, c->alocacoes, c->liberacoes);
+    }
+    printf("%-22s %14lld %14lld %12lld %12lld\n", "Total", total_memoria.vivos, total_memoria.pico, total_memoria.alocacoes, total_memoria.liberacoes);
+
+    size_t rss = 0;
+    size_t rss_pico = 0;
+    if(rss_processo_memoria(&rss, &rss_pico)){
+        printf("\nRSS do processo: %zu bytes (pico %zu bytes)\n", rss, rss_pico);
+        if(rss > 0){
+            printf("Heap contado / RSS: %.1f%% (o restante e codigo, pilha, arquivos mapeados e fragmentacao)\n",
+                100.0 * (double)total_memoria.vivos / (double)rss);
+        }
+    }else{
+        printf("\nRSS do processo indisponivel nesta plataforma\n");
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MEMORIA_GERAL 0
+#define MEMORIA_DATASET 1
+#define MEMORIA_REGISTROS 2
+#define MEMORIA_DICIONARIO 3
+#define MEMORIA_LISTA_ENCADEADA 4
+#define MEMORIA_LISTA_ORDENADA 5
+#define MEMORIA_AVL 6
+#define MEMORIA_HASH 7
+#define MEMORIA_HASH_ABERTO 8
+#define MEMORIA_SKIPLIST 9
+#define MEMORIA_TRIE 10
+#define MEMORIA_BITMAP 11
+#define MEMORIA_COLUNAS 12
+#define MEMORIA_AGREGACAO 13
+#define MEMORIA_SERIES 14
+#define MEMORIA_SNAPSHOT 15
+#define TOTAL_CATEGORIAS_MEMORIA 16
+
+typedef struct{
+    volatile long long vivos;
+    volatile long long pico;
+    volatile long long alocacoes;
+    volatile long long liberacoes;
+} ContadorMemoria;
+
+void* alocar_memoria(int categoria, size_t tamanho);
+void* alocar_zerada_memoria(int categoria, size_t quantidade, size_t tamanho);
+void* realocar_memoria(int categoria, void *p, size_t tamanho);
+void liberar_memoria(int categoria, void *p);
+void transferir_memoria(int origem, int destino, void *p);
+const char* nome_categoria_memoria(int categoria);
+void consultar_memoria(int categoria, ContadorMemoria *contador);
+void consultar_total_memoria(ContadorMemoria *contador);
+long long memoria_viva(int categoria);
+int rss_processo_memoria(size_t *atual, size_t *pico);
+void imprimir_memoria(void);
+
+#endif
@@ -11,12 +11,24 @@ garantindo que os dados estejam sempre atualizados entre as diferentes represent
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "lista_ordenada.h"
 #include "hash.h"
+#include "hash_aberto.h"
 #include "skiplist.h"
 #include "arvore_avl.h"
 #include "trie.h"
 #include "lista_encadeada.h"
+#include "dataset.h"
+#include "snapshot.h"
+#include "log_alteracoes.h"
+#include "indice_bitmap.h"
+#include "colunas.h"
+#include "agregacao.h"
+#include "series.h"
+#include "bench.h"
+#include "memoria.h"
+#include "gerador.h"
 
 TabelaHash tabela;
 ItemLista *cabeca = NULL;
@@ -24,10 +36,96 @@ Skiplist* skiplist = NULL;
 ItemAVL *raiz = NULL;
 Trie *trie_estado = NULL;
 Trie *trie_cultura = NULL;
+ArmazemRegistros armazem;
+IndiceBitmap indice;
+IndiceSeries series;
 
 
 char nome_arquivo[256];
 
+/* Parâmetros das medições avulsas do menu de benchmark (opções 10 a 14), repassados a
+medir_repetido_bench */
+typedef struct{
+    const char *arquivo;
+    int repeticoes;
+    int n_threads;
+} MedicaoLeituraMenu;
+
+typedef struct{
+    const char *arquivo;
+    int n;
+    int n_threads;
+    double *escritora;
+    int medidas;
+} MedicaoSkiplistMenu;
+
+typedef struct{
+    const char *arquivo;
+    int repeticoes;
+    int ano_min;
+    int ano_max;
+    const char *estado;
+    const char *cultura;
+    int modo;
+    int encontrados;
+} MedicaoFiltroMenu;
+
+typedef struct{
+    const char *arquivo;
+    int agrupar;
+    int largura_ano;
+    int n_threads;
+    int repeticoes;
+} MedicaoAgregacaoMenu;
+
+typedef struct{
+    const char *arquivo;
+    int consultas;
+    int por_varredura;
+} MedicaoSeriesMenu;
+
+/*
+Funções de medição das opções 10 a 14: cada uma executa a operação uma vez com os parâmetros
+do contexto e retorna a medição. As que não sorteiam nada ignoram a semente.
+*/
+static double medir_leitura_csv_menu(void *contexto, unsigned int semente){
+    MedicaoLeituraMenu *m = (MedicaoLeituraMenu*)contexto;
+    return bench_vazao_leitura_csv(m->arquivo, m->repeticoes);
+}
+
+static double medir_leitura_paralela_menu(void *contexto, unsigned int semente){
+    MedicaoLeituraMenu *m = (MedicaoLeituraMenu*)contexto;
+    return bench_vazao_leitura_paralela(m->arquivo, m->repeticoes, m->n_threads);
+}
+
+static double medir_leitura_sscanf_menu(void *contexto, unsigned int semente){
+    MedicaoLeituraMenu *m = (MedicaoLeituraMenu*)contexto;
+    return bench_vazao_leitura_sscanf(m->arquivo, m->repeticoes);
+}
+
+static double medir_skiplist_concorrente_menu(void *contexto, unsigned int semente){
+    MedicaoSkiplistMenu *m = (MedicaoSkiplistMenu*)contexto;
+    double escritora = 0;
+    double buscas = bench_vazao_busca_skiplist_concorrente(m->arquivo, m->n, m->n_threads, semente, &escritora);
+    m->escritora[m->medidas++] = escritora;
+    return buscas;
+}
+
+static double medir_filtro_menu(void *contexto, unsigned int semente){
+    MedicaoFiltroMenu *m = (MedicaoFiltroMenu*)contexto;
+    return bench_tempo_filtro_colunar(m->arquivo, m->repeticoes, m->ano_min, m->ano_max, m->estado, m->cultura, m->modo, &m->encontrados);
+}
+
+static double medir_agregacao_menu(void *contexto, unsigned int semente){
+    MedicaoAgregacaoMenu *m = (MedicaoAgregacaoMenu*)contexto;
+    return bench_tempo_agregacao(m->arquivo, m->agrupar, m->largura_ano, m->n_threads, m->repeticoes);
+}
+
+static double medir_series_menu(void *contexto, unsigned int semente){
+    MedicaoSeriesMenu *m = (MedicaoSeriesMenu*)contexto;
+    return bench_tempo_consulta_series(m->arquivo, m->consultas, m->por_varredura, semente);
+}
+
 /*
 Exibe o menu de benchmarks, permitindo ao usuário escolher qual métrica deseja avaliar
 (tempo de inserção, remoção, busca, uso de memória, inserção com restrição, etc.). 
@@ -36,8 +134,14 @@ Executa os benchmarks e exibe os resultados.
 void menu_benchmark(){
     int opcao;
     int n;
+    RelatorioBench relatorio;
+    ConfiguracaoBench configuracao;
+    char arquivo_bench[256];
+    iniciar_relatorio_bench(&relatorio);
+    iniciar_configuracao_bench(&configuracao);
+    snprintf(arquivo_bench, sizeof(arquivo_bench), "%s", nome_arquivo);
     do{
-        printf("\n=== MENU BENCHMARK ===\n");
+        printf("\n=== MENU BENCHMARK (%s) ===\n", arquivo_bench);
         printf("1 - Tempo de insercao\n");
         printf("2 - Tempo de remocao\n");
         printf("3 - Tempo de busca\n");
@@ -47,6 +151,16 @@ void menu_benchmark(){
         printf("7 - Busca com latencia\n");
         printf("8 - Insercao com perda\n");
         printf("9 - Busca com limite de acessos\n");
+        printf("10 - Vazao de leitura do arquivo\n");
+        printf("11 - Vazao de busca concorrente (Skiplist)\n");
+        printf("12 - Filtro completo por linhas x colunas (SIMD)\n");
+        printf("13 - Agregacao por estado, cultura e ano (GROUP BY)\n");
+        printf("14 - Totais por estado/cultura em intervalos de anos (Series)\n");
+        printf("15 - Salvar resultados das opcoes 1 a 9 (CSV e JSON)\n");
+        printf("16 - Configurar repeticoes (aquecimento: %d, repeticoes: %d, semente: %u, latencia por busca: %s)\n",
+            configuracao.aquecimento, configuracao.repeticoes, configuracao.semente, configuracao.latencias ? "sim" : "nao");
+        printf("17 - Memoria alocada por estrutura e RSS do processo\n");
+        printf("18 - Gerar dataset sintetico a partir de %s\n", nome_arquivo);
         printf("0 - Voltar\n");
         printf("Escolha uma opcao: ");
         scanf("%d", &opcao);
@@ -54,6 +168,177 @@ void menu_benchmark(){
 
         if(opcao == 0) break;
 
+        if(opcao == 10){
+            int repeticoes = 0;
+            printf("\nDigite o numero de leituras do arquivo: ");
+            scanf("%d", &repeticoes);
+            getchar();
+
+            int n_threads = 0;
+            printf("Digite o numero de threads para a leitura paralela: ");
+            scanf("%d", &n_threads);
+            getchar();
+            if(n_threads < 1 || n_threads > MAX_THREADS_LEITURA){
+                n_threads = MAX_THREADS_LEITURA;
+            }
+
+            MedicaoLeituraMenu leitura = {arquivo_bench, repeticoes, n_threads};
+            char titulo[100];
+            printf("\n");
+            medir_repetido_bench(&configuracao, "Vazao de leitura (mapeamento + parser)", "MB/s", medir_leitura_csv_menu, &leitura, NULL);
+            snprintf(titulo, sizeof(titulo), "Vazao de leitura (paralela, %d threads)", n_threads);
+            medir_repetido_bench(&configuracao, titulo, "MB/s", medir_leitura_paralela_menu, &leitura, NULL);
+            medir_repetido_bench(&configuracao, "Vazao de leitura (fgets + sscanf)", "MB/s", medir_leitura_sscanf_menu, &leitura, NULL);
+            continue;
+        }
+
+        if(opcao == 12){
+            int repeticoes = 0;
+            int ano_min, ano_max;
+            char estado[50];
+            char cultura[50];
+            printf("\nDigite o numero de varreduras: ");
+            scanf("%d", &repeticoes);
+            getchar();
+
+            printf("Digite o ano minimo e o ano maximo: ");
+            scanf("%d %d", &ano_min, &ano_max);
+            getchar();
+
+            printf("Digite o estado (deixe vazio para ignorar): ");
+            fgets(estado, sizeof(estado), stdin);
+            estado[strcspn(estado, "\n")] = '\0';
+
+            printf("Digite a cultura (deixe vazio para ignorar): ");
+            fgets(cultura, sizeof(cultura), stdin);
+            cultura[strcspn(cultura, "\n")] = '\0';
+
+            MedicaoFiltroMenu filtro = {arquivo_bench, repeticoes, ano_min, ano_max, estado, cultura, MODO_FILTRO_LINHAS, 0};
+            char titulo[100];
+            printf("\n");
+            medir_repetido_bench(&configuracao, "Tempo por varredura (linhas por ponteiro)", "s", medir_filtro_menu, &filtro, NULL);
+            filtro.modo = MODO_FILTRO_ESCALAR;
+            medir_repetido_bench(&configuracao, "Tempo por varredura (colunas, escalar)", "s", medir_filtro_menu, &filtro, NULL);
+            filtro.modo = MODO_FILTRO_AVX2;
+            snprintf(titulo, sizeof(titulo), "Tempo por varredura (colunas, %s)", avx2_disponivel_colunar() ? "AVX2" : "AVX2 indisponivel, escalar");
+            medir_repetido_bench(&configuracao, titulo, "s", medir_filtro_menu, &filtro, NULL);
+            printf("Linhas aprovadas por varredura: %d\n", filtro.encontrados);
+            continue;
+        }
+
+        if(opcao == 13){
+            int repeticoes = 0;
+            printf("\nDigite o numero de agregacoes: ");
+            scanf("%d", &repeticoes);
+            getchar();
+
+            MedicaoAgregacaoMenu agregacao = {arquivo_bench, AGRUPAR_ESTADO | AGRUPAR_CULTURA | AGRUPAR_ANO, 1, 1, repeticoes};
+            printf("\n");
+            medir_repetido_bench(&configuracao, "Tempo por agregacao (estado, cultura e ano, 1 thread)", "s", medir_agregacao_menu, &agregacao, NULL);
+            agregacao.n_threads = 0;
+            medir_repetido_bench(&configuracao, "Tempo por agregacao (estado, cultura e ano, threads automaticas)", "s", medir_agregacao_menu, &agregacao, NULL);
+            agregacao.agrupar = AGRUPAR_ESTADO | AGRUPAR_ANO;
+            agregacao.largura_ano = 10;
+            medir_repetido_bench(&configuracao, "Tempo por agregacao (estado e decada, threads automaticas)", "s", medir_agregacao_menu, &agregacao, NULL);
+            continue;
+        }
+
+        if(opcao == 14){
+            int consultas = 0;
+            printf("\nDigite o numero de consultas: ");
+            scanf("%d", &consultas);
+            getchar();
+
+            MedicaoSeriesMenu consulta = {arquivo_bench, consultas, 1};
+            char titulo[100];
+            printf("\n");
+            snprintf(titulo, sizeof(titulo), "Tempo de %d consultas (varredura dos registros)", consultas);
+            medir_repetido_bench(&configuracao, titulo, "s", medir_series_menu, &consulta, NULL);
+            consulta.por_varredura = 0;
+            snprintf(titulo, sizeof(titulo), "Tempo de %d consultas (prefixos das series)", consultas);
+            medir_repetido_bench(&configuracao, titulo, "s", medir_series_menu, &consulta, NULL);
+            continue;
+        }
+
+        if(opcao == 15){
+            char base[200];
+            char caminho[256];
+            printf("\nDigite o nome base dos arquivos de resultados: ");
+            fgets(base, sizeof(base), stdin);
+            base[strcspn(base, "\n")] = '\0';
+
+            snprintf(caminho, sizeof(caminho), "%s.csv", base);
+            salvar_csv_bench(&relatorio, caminho);
+            snprintf(caminho, sizeof(caminho), "%s.json", base);
+            salvar_json_bench(&relatorio, caminho);
+            printf("%d resultados salvos em %s.csv e %s.json\n", relatorio.total, base, base);
+            snprintf(caminho, sizeof(caminho), "%s_latencias.csv", base);
+            int histogramas = salvar_latencias_bench(&relatorio, caminho);
+            if(histogramas > 0){
+                printf("%d histogramas de latencia salvos em %s\n", histogramas, caminho);
+            }
+            continue;
+        }
+
+        if(opcao == 16){
+            printf("\nDigite o numero de execucoes de aquecimento: ");
+            scanf("%d", &configuracao.aquecimento);
+            printf("Digite o numero de repeticoes medidas: ");
+            scanf("%d", &configuracao.repeticoes);
+            printf("Digite a semente dos sorteios: ");
+            scanf("%u", &configuracao.semente);
+            printf("Medir a latencia de cada busca nas opcoes 3, 7 e 9? (1 - sim, 0 - nao): ");
+            scanf("%d", &configuracao.latencias);
+            getchar();
+            if(configuracao.aquecimento < 0){
+                configuracao.aquecimento = 0;
+            }
+            if(configuracao.repeticoes < 1){
+                configuracao.repeticoes = 1;
+            }
+            continue;
+        }
+
+        if(opcao == 17){
+            imprimir_memoria();
+            continue;
+        }
+
+        if(opcao == 18){
+            char saida[256];
+            int linhas = 0;
+            int ordem = ORDEM_IDS_CRESCENTE;
+            int tam_grupo = TAM_GRUPO_PADRAO_GERADOR;
+            int usar = 0;
+            printf("\nDigite o nome do arquivo a ser gerado: ");
+            fgets(saida, sizeof(saida), stdin);
+            saida[strcspn(saida, "\n")] = '\0';
+            printf("Digite o numero de registros: ");
+            scanf("%d", &linhas);
+            printf("Ordem dos IDs (1 - crescente, 2 - embaralhada, 3 - agrupada): ");
+            scanf("%d", &ordem);
+            if(ordem == ORDEM_IDS_AGRUPADA){
+                printf("Digite o numero de IDs consecutivos por grupo: ");
+                scanf("%d", &tam_grupo);
+            }
+            getchar();
+            if(ordem < ORDEM_IDS_CRESCENTE || ordem > ORDEM_IDS_AGRUPADA){
+                ordem = ORDEM_IDS_CRESCENTE;
+            }
+
+            int gerados = gerar_dataset_sintetico(nome_arquivo, saida, linhas, ordem, tam_grupo, configuracao.semente);
+            if(gerados > 0){
+                printf("%d registros gerados em %s (IDs em ordem %s, semente %u)\n", gerados, saida, nome_ordem_ids_gerador(ordem), configuracao.semente);
+                printf("Usar %s nas proximas opcoes do benchmark? (1 - sim, 0 - nao): ", saida);
+                scanf("%d", &usar);
+                getchar();
+                if(usar == 1){
+                    snprintf(arquivo_bench, sizeof(arquivo_bench), "%s", saida);
+                }
+            }
+            continue;
+        }
+
         printf("\nDigite o numero de amostras para o benchmark: ");
         scanf("%d", &n);
         getchar();
@@ -65,103 +350,84 @@ void menu_benchmark(){
                 printf("Retornando ao menu principal\n");
                 break;
             }
-            case 1:{
-                printf("Tempo de isercao (Lista Encadeada): %.8f segundos\n", bench_temp_insercao_LE(nome_arquivo, n));
-                printf("Tempo de isercao (Lista Ordenada): %.8f segundos\n", bench_temp_insercao_LO(nome_arquivo, n));
-                printf("Tempo de isercao (Arvore AVL): %.8f segundos\n", bench_tempo_insercao_avl(nome_arquivo, n));
-                printf("Tempo de isercao (Hash): %.8f segundos\n", bench_tempo_insercao_hash(nome_arquivo, n));
-                printf("Tempo de isercao (Skiplist): %.8f segundos\n", bench_temp_insercao_skiplist(nome_arquivo, n));
-                break;
-            }
-            case 2:{
-                printf("Tempo de remocao (Lista Encadeada): %.8f segundos\n", bench_temp_remocao_LE(nome_arquivo, n));
-                printf("Tempo de remocao (Lista Ordenada): %.8f segundos\n", bench_temp_remocao_LO(nome_arquivo, n));
-                printf("Tempo de remocao (Arvore AVL): %.8f segundos\n", bench_tempo_remocao_avl(nome_arquivo, n));
-                printf("Tempo de remocao (Hash): %.8f segundos\n", bench_tempo_remocao_hash(nome_arquivo, n));
-                printf("Tempo de remocao (Skiplist): %.8f segundos\n", bench_temp_remocao_skiplist(nome_arquivo, n));
-                break;
-            }
-            case 3:{
-                printf("Tempo de busca por ID (Lista Encadeada): %.8f segundos\n", bench_temp_busca_LE(nome_arquivo, n));
-                printf("Tempo de busca por ID (Lista Ordenada): %.8f segundos\n", bench_temp_busca_LO(nome_arquivo, n));
-                printf("Tempo de busca por ID (Arvore AVL): %.8f segundos\n", bench_tempo_busca_avl(nome_arquivo, n));
-                printf("Tempo de busca por ID (Hash): %.8f segundos\n", bench_tempo_busca_hash(nome_arquivo, n));
-                printf("Tempo de busca por ID (Skiplist): %.8f segundos\n", bench_temp_busca_skiplist(nome_arquivo, n));
-                break;
-            }
-            case 4:{
-                printf("Uso de memoria (Lista Encadeada): %zu bytes\n", bench_uso_memoria_LE(nome_arquivo, n));
-                printf("Uso de memoria (Lista Ordenada): %zu bytes\n", bench_uso_memoria_LO(nome_arquivo, n));
-                printf("Uso de memoria (Arvore AVL): %zu bytes\n", bench_uso_memoria_avl(nome_arquivo, n));
-                printf("Uso de memoria (Hash): %zu bytes\n", bench_uso_memoria_hash(nome_arquivo, n));
-                printf("Uso de memoria (Skiplist): %zu bytes\n", bench_uso_memoria_skiplist(nome_arquivo, n));
-                break;
-            }
-            case 5:{
-                int lim_memoria = 0;
-                printf("Digite o limite de memoria em MB para o benchmark: ");
-                scanf("%d", &lim_memoria);
-                getchar();
+            case CENARIO_INSERCAO:
+            case CENARIO_REMOCAO:
+            case CENARIO_BUSCA:
+            case CENARIO_USO_MEMORIA:
+            case CENARIO_MEM_RESTRITA:
+            case CENARIO_INSERCAO_DELAY:
+            case CENARIO_BUSCA_LATENCIA:
+            case CENARIO_INSERCAO_PERDA:
+            case CENARIO_BUSCA_LIM_ACESSOS:{
+                double parametro = 0;
+                if(opcao == CENARIO_MEM_RESTRITA){
+                    printf("Digite o limite de memoria em MB para o benchmark: ");
+                    scanf("%lf", &parametro);
+                    getchar();
+                }else if(opcao == CENARIO_INSERCAO_DELAY){
+                    printf("Digite o delay em MS para o benchmark: ");
+                    scanf("%lf", &parametro);
+                    getchar();
+                }else if(opcao == CENARIO_BUSCA_LIM_ACESSOS){
+                    printf("Digite o limite de acessos para o benchmark: ");
+                    scanf("%lf", &parametro);
+                    getchar();
+                }
 
-                printf("\nTempo de insercao com memoria restrita (Lista Encadeada): %.8f segundos\n", bench_insercao_mem_restrita_LE(nome_arquivo, lim_memoria));
-                printf("Tempo de insercao com memoria restrita (Lista Ordenada): %.8f segundos\n", bench_insercao_mem_restrita_LO(nome_arquivo, lim_memoria));
-                printf("Tempo de insercao com memoria restrita (Arvore AVL): %.8f segundos\n", bench_insercao_mem_restrita_avl(nome_arquivo, lim_memoria));
-                printf("Tempo de insercao com memoria restrita (Hash): %.8f segundos\n", bench_insercao_mem_restrita_hash(nome_arquivo, lim_memoria));
-                printf("Tempo de insercao com memoria restrita (Skiplist): %.8f segundos\n", bench_insercao_mem_restrita_skiplist(nome_arquivo, lim_memoria));
-                break;
-            }            
-            case 6:{
-                int delay = 0;
-                printf("Digite o delay em MS para o benchmark: ");
-                scanf("%d", &delay);
-                getchar();
+                executar_bench(&relatorio, &configuracao, opcao, arquivo_bench, n, parametro);
 
-                printf("\nTempo de insercao com delay (Lista Encadeada): %.8f segundos\n", bench_insercao_com_delay_LE(nome_arquivo, n, delay));
-                printf("Tempo de insercao com delay (Lista Ordenada): %.8f segundos\n", bench_insercao_com_delay_LO(nome_arquivo, n, delay));
-                printf("Tempo de insercao com delay (Arvore AVL): %.8f segundos\n", bench_insercao_com_delay_avl(nome_arquivo, n, delay));
-                printf("Tempo de insercao com delay (Hash): %.8f segundos\n", bench_insercao_com_delay_hash(nome_arquivo, n, delay));
-                printf("Tempo de insercao com delay (Skiplist): %.8f segundos\n", bench_insercao_com_delay_hash(nome_arquivo, n, delay));
-                break;
-            }
-            case 7:{
-                printf("Tempo de busca com latencia (Lista Encadeada): %.8f segundos\n", bench_busca_latencia_LE(nome_arquivo, n));
-                printf("Tempo de busca com latencia (Lista Ordenada): %.8f segundos\n", bench_busca_latencia_LO(nome_arquivo, n));
-                printf("Tempo de busca com latencia (Arvore AVL): %.8f segundos\n", bench_busca_latencia_hash(nome_arquivo, n));
-                printf("Tempo de busca com latencia (Hash): %.8f segundos\n", bench_busca_latencia_hash(nome_arquivo, n));
-                printf("Tempo de busca com latencia (Skiplist): %.8f segundos\n", bench_busca_latencia_skiplist(nome_arquivo, n));
-                break;
-            }
-            case 8:{
-                printf("Tempo de insercao com perda (Lista Encadeada): %.8f segundos\n", bench_temp_insercao_perda_LE(nome_arquivo, n));
-                printf("Tempo de insercao com perda (Lista Ordenada): %.8f segundos\n", bench_temp_insercao_perda_LO(nome_arquivo, n));
-                printf("Tempo de insercao com perda (Arvore AVL): %.8f segundos\n", bench_tempo_insercao_perda_avl(nome_arquivo, n));
-                printf("Tempo de insercao com perda (Hash): %.8f segundos\n", bench_tempo_insercao_perda_hash(nome_arquivo, n));
-                printf("Tempo de insercao com perda (Skiplist): %.8f segundos\n", bench_temp_insercao_perda_skiplist(nome_arquivo, n));
+                if(opcao == CENARIO_USO_MEMORIA){
+                    int nos_trie = 0;
+                    size_t memoria_trie_estado = bench_uso_memoria_trie(arquivo_bench, n, 2, &nos_trie);
+                    printf("Uso de memoria (Trie de estados): %zu bytes, %d nos\n", memoria_trie_estado, nos_trie);
+                    size_t memoria_trie_cultura = bench_uso_memoria_trie(arquivo_bench, n, 3, &nos_trie);
+                    printf("Uso de memoria (Trie de culturas): %zu bytes, %d nos\n", memoria_trie_cultura, nos_trie);
+                }
                 break;
             }
-            case 9:{
-                int lim = 0;
-                printf("Digite o limite de acessos para o benchmark: ");
-                scanf("%d", &lim);
+            case 11:{
+                int n_threads = 0;
+                printf("Digite o numero de threads leitoras: ");
+                scanf("%d", &n_threads);
                 getchar();
+                if(n_threads < 1 || n_threads > MAX_THREADS_SKIPLIST - 2){
+                    n_threads = MAX_THREADS_SKIPLIST - 2;
+                }
 
-                printf("Tempo de busca com limite de acessos (Lista Encadeada): %.8f segundos\n", bench_busca_lim_acessos_LE(nome_arquivo, n, lim));
-                printf("Tempo de busca com limite de acessos (Lista Ordenada): %.8f segundos\n", bench_busca_lim_acessos_LO(nome_arquivo, n, lim));
-                printf("Tempo de busca com limite de acessos (Arvore AVL): %.8f segundos\n", bench_busca_lim_acessos_avl(nome_arquivo, n, lim));
-                printf("Tempo de busca com limite de acessos (Hash): %.8f segundos\n", bench_busca_lim_acessos_hash(nome_arquivo, n, lim));
-                printf("Tempo de busca com limite de acessos (Skiplist): %.8f segundos\n", bench_busca_lim_acessos_skiplist(nome_arquivo, n, lim));
+                int medidas = configuracao.aquecimento + (configuracao.repeticoes > 0 ? configuracao.repeticoes : 1);
+                MedicaoSkiplistMenu concorrente = {arquivo_bench, n, n_threads, NULL, 0};
+                concorrente.escritora = (double*)alocar_memoria(MEMORIA_GERAL, medidas * sizeof(double));
+                if(!concorrente.escritora){
+                    printf("Erro ao alocar memoria para o benchmark\n");
+                    exit(EXIT_FAILURE);
+                }
+                char titulo[100];
+                snprintf(titulo, sizeof(titulo), "Vazao de busca concorrente (Skiplist, %d threads + 1 escritora)", n_threads);
+                medir_repetido_bench(&configuracao, titulo, "buscas/s", medir_skiplist_concorrente_menu, &concorrente, NULL);
+
+                /* A vazão da escritora é resumida só nas repetições medidas, sem o aquecimento */
+                EstatisticaBench escritora;
+                calcular_estatistica_bench(&concorrente.escritora[configuracao.aquecimento], medidas - configuracao.aquecimento, &escritora);
+                printf("Escritora: mediana %.0f insercoes/remocoes por segundo | desvio %.0f\n", escritora.mediana, escritora.desvio);
+                liberar_memoria(MEMORIA_GERAL, concorrente.escritora);
                 break;
             }
             default:
                 printf("Opcao invalida!\n");
         }
     }while(opcao != 0);
+
+    liberar_relatorio_bench(&relatorio);
 }
 
 /*
-Sincroniza todas as estruturas de dados (Skiplist, Hash, Lista Ordenada, AVL, Trie) 
+Sincroniza todas as estruturas de dados (Skiplist, Hash, Lista Ordenada, AVL, Trie e índices de bitmaps e de séries)
 com o conteúdo do arquivo informado, garantindo que todas estejam atualizadas 
-com os mesmos dados após qualquer alteração.
+com os mesmos dados após qualquer alteração. O arquivo é lido uma única vez para
+um vetor de registros, a partir do qual todas as estruturas são construídas; o vetor passa
+a fazer parte do armazém de registros e as estruturas apontam para ele. Quando existe
+um snapshot binário em dia com o arquivo, ele é usado no lugar do CSV. Em seguida o log de
+alterações é reaplicado e, se estiver grande, incorporado ao arquivo.
 Parâmetros:
     skiplist - ponteiro para a skiplist
     tabela - ponteiro para a tabela hash
@@ -169,42 +435,113 @@ Parâmetros:
     raiz_avl - ponteiro para a árvore AVL
     trie_estado - ponteiro para a trie de estados
     trie_cultura - ponteiro para a trie de culturas
+    indice - ponteiro para o índice de bitmaps (estado, cultura e ano)
+    series - ponteiro para o índice de séries por (estado, cultura)
+    armazem - ponteiro para o armazém que guarda os registros
     nome_arquivo - nome do arquivo de dados (dataset)
 */
-void sincronizar_estruturas(Skiplist **skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie **trie_estado, Trie **trie_cultura, const char *nome_arquivo){
-    
+void sincronizar_estruturas(Skiplist **skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie **trie_estado, Trie **trie_cultura, IndiceBitmap *indice, IndiceSeries *series, ArmazemRegistros *armazem, const char *nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset_inicial(&ds, nome_arquivo);
+    if(aplicar_log(&ds, nome_arquivo) > LIMITE_ENTRADAS_LOG){
+        compactar_dataset(&ds, nome_arquivo);
+    }
+
     if(*skiplist != NULL){
         libera_skiplist(*skiplist);
         *skiplist = iniciar_skiplist();
-        carregar_dados_skiplist(*skiplist, nome_arquivo);
+        carregar_registros_skiplist(*skiplist, &ds);
     }
 
     liberar_tabela_hash(tabela);
     iniciar_hash(tabela);
-    carregar_dados_hash(tabela, nome_arquivo);
+    carregar_registros_hash(tabela, &ds);
 
     libera_LO(*cabeca);
     *cabeca = NULL;
-    carregar_dados_LO(cabeca, nome_arquivo);
+    carregar_registros_LO(cabeca, &ds);
 
     if(*raiz_avl != NULL){
         liberar_avl(*raiz_avl);
         *raiz_avl = NULL;
     }
-    carregar_dados_avl(raiz_avl, nome_arquivo);
+    carregar_registros_avl(raiz_avl, &ds);
 
     if(*trie_estado != NULL){
-            liberar_trie(*trie_estado);
-        }
-        *trie_estado = criar_trie();
-        carregar_dados_trie(*trie_estado, nome_arquivo, 2);
+        liberar_trie(*trie_estado);
+    }
+    *trie_estado = criar_trie();
+    carregar_registros_trie(*trie_estado, &ds, 2);
 
-        if(*trie_cultura != NULL){
-            liberar_trie(*trie_cultura);
-        }
-        *trie_cultura = criar_trie();
-        carregar_dados_trie(*trie_cultura, nome_arquivo, 3);
+    if(*trie_cultura != NULL){
+        liberar_trie(*trie_cultura);
+    }
+    *trie_cultura = criar_trie();
+    carregar_registros_trie(*trie_cultura, &ds, 3);
+
+    liberar_indice_series(series);
+    carregar_registros_series(series, &ds);
+
+    liberar_armazem(armazem);
+    adotar_dataset_armazem(armazem, &ds);
+    carregar_indice_bitmap(indice, armazem);
+}
 
+/*
+Insere uma nova amostra diretamente em todas as estruturas já carregadas em memória
+(Skiplist, Hash, Lista Ordenada, AVL, Tries e índices de bitmaps e de séries), sem reler o arquivo.
+Parâmetros:
+    skiplist - ponteiro para a skiplist
+    tabela - ponteiro para a tabela hash
+    cabeca - ponteiro para a lista ordenada
+    raiz_avl - ponteiro para a árvore AVL
+    trie_estado - ponteiro para a trie de estados
+    trie_cultura - ponteiro para a trie de culturas
+    indice - ponteiro para o índice de bitmaps (estado, cultura e ano)
+    series - ponteiro para o índice de séries por (estado, cultura)
+    armazem - ponteiro para o armazém que guarda os registros
+    novo - ponteiro para o registro a ser inserido
+Retorno: ponteiro para a cópia do registro guardada no armazém
+*/
+Registro* inserir_estruturas(Skiplist *skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie *trie_estado, Trie *trie_cultura, IndiceBitmap *indice, IndiceSeries *series, ArmazemRegistros *armazem, const Registro *novo){
+    Registro *registro = adicionar_armazem(armazem, novo);
+    inserir_skiplist(skiplist, registro);
+    inserir_tabela_hash(tabela, registro);
+    insereOrdenadoID_LO(cabeca, registro);
+    *raiz_avl = inserir_avl(*raiz_avl, registro);
+    inserir_trie(trie_estado, nome_estado(registro->estado), registro);
+    inserir_trie(trie_cultura, nome_cultura(registro->cultura), registro);
+    indexar_bitmap(indice, registro);
+    inserir_series(series, registro);
+    return registro;
+}
+
+/*
+Remove uma amostra diretamente de todas as estruturas já carregadas em memória
+(Skiplist, Hash, Lista Ordenada, AVL, Tries e índices de bitmaps e de séries), sem reler o arquivo.
+Parâmetros:
+    skiplist - ponteiro para a skiplist
+    tabela - ponteiro para a tabela hash
+    cabeca - ponteiro para a lista ordenada
+    raiz_avl - ponteiro para a árvore AVL
+    trie_estado - ponteiro para a trie de estados
+    trie_cultura - ponteiro para a trie de culturas
+    indice - ponteiro para o índice de bitmaps (estado, cultura e ano)
+    series - ponteiro para o índice de séries por (estado, cultura)
+    armazem - ponteiro para o armazém que guarda os registros
+    removido - ponteiro para o registro a ser removido (pertencente ao armazém)
+*/
+void remover_estruturas(Skiplist *skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie *trie_estado, Trie *trie_cultura, IndiceBitmap *indice, IndiceSeries *series, ArmazemRegistros *armazem, Registro *removido){
+    remover_trie(trie_estado, nome_estado(removido->estado), removido->id);
+    remover_trie(trie_cultura, nome_cultura(removido->cultura), removido->id);
+    remover_skiplist(skiplist, removido->id);
+    remover_tabela_hash(tabela, removido->id);
+    remover_LO(cabeca, removido->id);
+    *raiz_avl = remover_avl(*raiz_avl, removido->id);
+    desindexar_bitmap(indice, removido);
+    remover_series(series, removido);
+    remover_armazem(armazem, removido);
 }
 
 /*
@@ -217,15 +554,17 @@ Parâmetros:
     raiz_avl - ponteiro para a árvore AVL
     trie_estado - ponteiro para a trie de estados
     trie_cultura - ponteiro para a trie de culturas
+    indice - ponteiro para o índice de bitmaps (estado, cultura e ano)
+    series - ponteiro para o índice de séries por (estado, cultura)
+    armazem - ponteiro para o armazém que guarda os registros
 */
-void liberar_estruturas(Skiplist **skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie **trie_estado, Trie **trie_cultura) {
+void liberar_estruturas(Skiplist **skiplist, TabelaHash *tabela, ItemLista **cabeca, ItemAVL **raiz_avl, Trie **trie_estado, Trie **trie_cultura, IndiceBitmap *indice, IndiceSeries *series, ArmazemRegistros *armazem) {
     if(*skiplist != NULL){
         libera_skiplist(*skiplist);
         *skiplist = NULL;
     }
 
     liberar_tabela_hash(tabela);
-    iniciar_hash(tabela);
 
     if(*cabeca != NULL){
         libera_LO(*cabeca);
@@ -246,12 +585,19 @@ void liberar_estruturas(Skiplist **skiplist, TabelaHash *tabela, ItemLista **cab
         *trie_cultura = NULL;
     }
 
+    liberar_indice_bitmap(indice);
+    liberar_indice_series(series);
+    liberar_armazem(armazem);
 }
 
 /*
 Exibe o menu de operações CRUD, permitindo inserir uma nova amostra, buscar por ID,
-buscar estado/cultura por prefixo, remover uma amostra ou listar todas as amostras ordenadas.
-Chama as funções correspondentes para cada operação.
+buscar estado/cultura por prefixo, remover uma amostra, listar todas as amostras ordenadas,
+filtrar as amostras por ano, estado e cultura, agregá-las (GROUP BY) ou consultar os totais
+de um estado/cultura em um intervalo de anos.
+Chama as funções correspondentes para cada operação. As estruturas são carregadas uma única
+vez no início do programa; inserções e remoções são aplicadas diretamente nelas e as consultas
+não releem o arquivo.
 */
 void menu_crud(){
     int opcao;
@@ -259,9 +605,13 @@ void menu_crud(){
         printf("\n===MENU CRUD===\n");
         printf("1 - Inserir nova amostra (Arvore AVL)\n");
         printf("2 - Buscar amostra por id (Hash)\n");
-        printf("3 - Busca estado/cultura por prefixo (Trie e Hash)\n");
+        printf("3 - Busca estado/cultura por prefixo (Trie)\n");
         printf("4 - Remover uma amostra (Skiplist)\n");
         printf("5 - Listar todas as amostras ordenadas (Lista Ordenada)\n");
+        printf("6 - Compactar log de alteracoes no arquivo CSV\n");
+        printf("7 - Filtrar por ano, estado e cultura (Indice de bitmaps)\n");
+        printf("8 - Agregar por estado, cultura e ano (GROUP BY)\n");
+        printf("9 - Totais de um estado/cultura em um intervalo de anos (Series)\n");
         printf("0 - Voltar ao menu principal\n");
         printf("Escolha uma opcao\n");
         scanf("%d", &opcao);
@@ -269,37 +619,36 @@ void menu_crud(){
 
         switch(opcao){
             case 0:{
-                liberar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura);
                 printf("Retornando ao menu principal...\n");
                 break;
             }
 
             case 1:{
-                carregar_dados_avl(&raiz, nome_arquivo);
+                Registro novo;
+                ler_registro_usuario(&novo, proximo_id_avl(raiz));
 
-                criar_amostra_avl(&raiz);
+                inserir_estruturas(skiplist, &tabela, &cabeca, &raiz, trie_estado, trie_cultura, &indice, &series, &armazem, &novo);
 
-                salvar_dados_avl(raiz, nome_arquivo);
-
-                sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
+                registrar_insercao_log(nome_arquivo, &novo);
 
+                printf("\nAmostra inserida com sucesso! ID: %d\n", novo.id);
                 printf("Alteracoes salvas\n");
 
                 break;
             }
 
             case 2:{
-                sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
                 int id;
                 printf("Digite o ID a ser buscado: ");
                 scanf("%d", &id);
                 getchar();
                 ItemHash *buscado = buscar_tabela_hash(&tabela, id);
                 if (buscado){
+                    const Registro *r = buscado->registro;
                     printf("  ID: %d | Ano: %d | Estado: %s | Cultura: %s | Preco/Ton: %.2f | Rendimento: %.2f | Producao: %.2f | Area: %.2f | Valor Total: %.2f\n",
-                       buscado->id, buscado->ano, buscado->estado, buscado->cultura,
-                       buscado->preco_ton, buscado->rendimento, buscado->producao,
-                       buscado->area_plantada, buscado->valor_total);
+                       r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura),
+                       r->preco_ton, r->rendimento, r->producao,
+                       r->area_plantada, r->valor_total);
                 }else{
                     printf("Amostra nao encontrada.\n");
                 }
@@ -307,14 +656,6 @@ void menu_crud(){
             }
 
             case 3:{
-                sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
-
-                Trie *trie_estado = criar_trie();
-                Trie *trie_cultura = criar_trie();
-
-                carregar_dados_trie(trie_estado, nome_arquivo, 2); 
-                carregar_dados_trie(trie_cultura, nome_arquivo, 3); 
-
                 char estado[50];
                 char cultura[50];
 
@@ -326,116 +667,54 @@ void menu_crud(){
                 fgets(cultura, sizeof(cultura), stdin);
                 cultura[strcspn(cultura, "\n")] = '\0';
 
-                char estados_encontrados[100][50];
-                int total_estados = 0;
-                char culturas_encontradas[100][50];
-                int total_culturas = 0;
+                /* Cada filtro vira a união das listas de postagens das palavras com o prefixo;
+                   com os dois filtros, o resultado é a interseção das duas listas. */
+                ListaPostagens por_estado, por_cultura, resultado;
+                iniciar_postagens(&por_estado);
+                iniciar_postagens(&por_cultura);
+                iniciar_postagens(&resultado);
 
                 if(strlen(estado) > 0){
-                    NoTrie *no_estado = trie_estado->raiz;
-                    int len = strlen(estado);
-                    int i = 0;
-                    for(i; i < len; i++){
-                        char c = estado[i];
-
-                        if(c >= 'A' && c <= 'Z'){
-                            c = c - 'A' + 'a';
-                        }
-
-                        int idx = indice_trie(c);
-
-                        if(idx == -1){
-                            continue;
-                        }
-
-                        if(no_estado->filhos[idx] == NULL){
-                            break;
-                        }
-
-                        no_estado = no_estado->filhos[idx];
-                    }
-
-                    if(i == len){
-                        char buffer[50];
-                        strcpy(buffer, estado);
-                        coletar_palavras_trie(no_estado, buffer, strlen(estado), estados_encontrados, &total_estados);
-                    }
+                    coletar_postagens_trie(trie_estado, localizar_prefixo_trie(trie_estado, estado), &por_estado);
                 }
-
                 if(strlen(cultura) > 0){
-                    NoTrie *no_cultura = trie_cultura->raiz;
-                    int len = strlen(cultura);
-                    int j = 0;
-                    for(j; j < len; j++){
-                        char c = cultura[j];
-                        if(c >= 'A' && c <= 'Z'){
-                            c = c - 'A' + 'a';
-                        }
-                        int idx = indice_trie(c);
-                        if(idx == -1){
-                            continue;
-                        }
-                        if(no_cultura->filhos[idx] == NULL){
-                            break;
-                        }
-                        no_cultura = no_cultura->filhos[idx];
-                    }
-                    if(j == len){
-                        char buffer[50];
-                        strcpy(buffer, cultura);
-                        coletar_palavras_trie(no_cultura, buffer, strlen(cultura), culturas_encontradas, &total_culturas);
-                    }
+                    coletar_postagens_trie(trie_cultura, localizar_prefixo_trie(trie_cultura, cultura), &por_cultura);
+                }
+
+                const ListaPostagens *selecionados = &resultado;
+                if(strlen(estado) > 0 && strlen(cultura) > 0){
+                    intersectar_postagens(&por_estado, &por_cultura, &resultado);
+                }else if(strlen(estado) > 0){
+                    selecionados = &por_estado;
+                }else if(strlen(cultura) > 0){
+                    selecionados = &por_cultura;
+                }else{
+                    coletar_postagens_trie(trie_estado, localizar_prefixo_trie(trie_estado, ""), &resultado);
                 }
 
                 int encontrados = 0;
                 int k = 0;
-                for(k; k < TAM; k++){
-                    ItemHash *atual = tabela.tabela[k];
-                    while(atual != NULL){
-                        int estado_ok = 1, cultura_ok = 1;
-                        if(strlen(estado) > 0){
-                            estado_ok = 0;
-                            int l = 0;
-                            for(l; l < total_estados; l++){
-                                if(strcasecmp(atual->estado, estados_encontrados[l]) == 0){
-                                    estado_ok = 1;
-                                    break;
-                                }
-                            }
-                        }
-                        if(strlen(cultura) > 0){
-                            cultura_ok = 0;
-                            int n = 0;
-                            for(n; n < total_culturas; n++){
-                                if(strcasecmp(atual->cultura, culturas_encontradas[n]) == 0){
-                                    cultura_ok = 1;
-                                    break;
-                                }
-                            }
-                        }
-                        if(estado_ok && cultura_ok){
-                            printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-                                atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton,
-                                atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
-                            encontrados++;
-                        }
-                        atual = atual->prox;
-                    }
+                for(k; k < selecionados->total; k++){
+                    const Registro *r = selecionados->itens[k].registro;
+                    printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
+                        r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+                        r->rendimento, r->producao, r->area_plantada, r->valor_total);
+                    encontrados++;
                 }
 
+                liberar_postagens(&por_estado);
+                liberar_postagens(&por_cultura);
+                liberar_postagens(&resultado);
+
                 if(encontrados == 0){
                     printf("Nenhum resultado encontrado.\n");
                 }else{
                     printf("Total de resultados: %d\n", encontrados);
                 }
-
-                liberar_trie(trie_estado);
-                liberar_trie(trie_cultura);
                 break;
             }
 
             case 4:{
-                sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
                 int id;
                 printf("Digite o ID a ser removido: ");
                 scanf("%d", &id);
@@ -444,13 +723,12 @@ void menu_crud(){
                 ElementoSkiplist* encontrado = buscar_skiplist(skiplist, id);
 
                 if(encontrado){
-                    ElementoSkiplist temp;
-                    temp = *encontrado;
+                    Registro *registro = encontrado->registro;
 
                     printf("\nAmostra encontrada:\n");
                     printf("ID: %d | Ano: %d | Estado: %s | Cultura: %s | Preco/Ton: %.2f | Rendimento: %.2f | Producao: %.2f | Area: %.2f | Valor Total: %.2f\n",
-                        temp.id, temp.ano, temp.estado, temp.cultura, temp.preco_ton, temp.rendimento,
-                        temp.producao, temp.area_plantada, temp.valor_total);
+                        registro->id, registro->ano, nome_estado(registro->estado), nome_cultura(registro->cultura), registro->preco_ton, registro->rendimento,
+                        registro->producao, registro->area_plantada, registro->valor_total);
 
                     char resposta;
                     printf("\nTem certeza que deseja remover esta amostra e salvar as alteracoes? (s/n): ");
@@ -458,14 +736,11 @@ void menu_crud(){
                     getchar();
 
                     if(resposta == 's' || resposta == 'S'){
-                        remover_skiplist(skiplist, id);
-                        remover_tabela_hash(&tabela, id);
-                        remover_LO(&cabeca, id);
-
-                        salvar_dados_skiplist(skiplist, nome_arquivo);
-                        salvar_dados_hash(&tabela, nome_arquivo);
-                        salvar_dados_LO(cabeca, nome_arquivo);
-                        printf("Amostra removida e alteracoes salvas no arquivo CSV!\n");
+                        registrar_remocao_log(nome_arquivo, registro->id);
+
+                        remover_estruturas(skiplist, &tabela, &cabeca, &raiz, trie_estado, trie_cultura, &indice, &series, &armazem, registro);
+
+                        printf("Amostra removida e alteracoes salvas!\n");
                     }else{
                         printf("Remocao cancelada. Nenhuma alteracao foi feita.\n");
                     }
@@ -476,11 +751,102 @@ void menu_crud(){
             }
 
             case 5:{
-                sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
                 imprime_LO(cabeca);
                 break;
                 }
 
+            case 6:{
+                compactar_log(&armazem, nome_arquivo);
+                printf("Log de alteracoes incorporado ao arquivo %s\n", nome_arquivo);
+                break;
+            }
+
+            case 7:{
+                int ano_min, ano_max;
+                char estado[50];
+                char cultura[50];
+
+                printf("Digite o ano minimo e o ano maximo: ");
+                scanf("%d %d", &ano_min, &ano_max);
+                getchar();
+
+                printf("Digite o estado (deixe vazio para ignorar): ");
+                fgets(estado, sizeof(estado), stdin);
+                estado[strcspn(estado, "\n")] = '\0';
+
+                printf("Digite a cultura (deixe vazio para ignorar): ");
+                fgets(cultura, sizeof(cultura), stdin);
+                cultura[strcspn(cultura, "\n")] = '\0';
+
+                buscar_filtros_hash(&tabela, ano_min, ano_max, estado, cultura, &indice);
+                break;
+            }
+
+            case 8:{
+                char resposta;
+                int agrupar = 0;
+                int largura_ano = 0;
+                int medida = 0;
+
+                printf("Agrupar por estado? (s/n): ");
+                scanf(" %c", &resposta);
+                if(resposta == 's' || resposta == 'S'){
+                    agrupar |= AGRUPAR_ESTADO;
+                }
+                printf("Agrupar por cultura? (s/n): ");
+                scanf(" %c", &resposta);
+                if(resposta == 's' || resposta == 'S'){
+                    agrupar |= AGRUPAR_CULTURA;
+                }
+                printf("Intervalo de anos de cada grupo (0 para nao agrupar por ano, 1 para ano a ano, 10 para decadas): ");
+                scanf("%d", &largura_ano);
+                if(largura_ano > 0){
+                    agrupar |= AGRUPAR_ANO;
+                }
+                printf("Medida (1 - Producao, 2 - Valor total, 3 - Area plantada, 4 - Preco/Ton, 5 - Rendimento): ");
+                scanf("%d", &medida);
+                getchar();
+                if(medida < 1 || medida > N_MEDIDAS_AGREGACAO){
+                    medida = 1;
+                }
+
+                TabelaAgregacao agregacao;
+                iniciar_agregacao(&agregacao, agrupar, largura_ano);
+                agregar_armazem(&agregacao, &armazem, 0);
+                ordenar_agregacao(&agregacao);
+                imprimir_agregacao(&agregacao, medida - 1);
+                liberar_agregacao(&agregacao);
+                break;
+            }
+
+            case 9:{
+                int ano_min, ano_max;
+                char estado[50];
+                char cultura[50];
+
+                printf("Digite o estado: ");
+                fgets(estado, sizeof(estado), stdin);
+                estado[strcspn(estado, "\n")] = '\0';
+
+                printf("Digite a cultura: ");
+                fgets(cultura, sizeof(cultura), stdin);
+                cultura[strcspn(cultura, "\n")] = '\0';
+
+                printf("Digite o ano minimo e o ano maximo: ");
+                scanf("%d %d", &ano_min, &ano_max);
+                getchar();
+
+                TotalSerie total;
+                if(consultar_series(&series, estado, cultura, ano_min, ano_max, &total)){
+                    printf("\n%s | %s | %d-%d\n", estado, cultura, ano_min, ano_max);
+                    printf("Amostras: %lld | Producao: %.2f | Valor Total: %.2f | Area: %.2f\n",
+                        total.contagem, total.producao, total.valor_total, total.area_plantada);
+                }else{
+                    printf("Nenhuma amostra de %s em %s.\n", cultura, estado);
+                }
+                break;
+            }
+
             default:
                 printf("Opcao invalida!\n");
         }
@@ -530,12 +896,17 @@ int main(){
     raiz = NULL;
     trie_estado = criar_trie();
     trie_cultura = criar_trie();
+    iniciar_armazem(&armazem);
+    iniciar_indice_bitmap(&indice, &armazem);
+    iniciar_indice_series(&series);
 
-    sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, nome_arquivo);
+    sincronizar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, &indice, &series, &armazem, nome_arquivo);
 
     menu_principal();
 
-    liberar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura);
+    liberar_estruturas(&skiplist, &tabela, &cabeca, &raiz, &trie_estado, &trie_cultura, &indice, &series, &armazem);
+    liberar_dicionario(&dicionario_estados);
+    liberar_dicionario(&dicionario_culturas);
 
     return 0;
 }
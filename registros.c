@@ -0,0 +1,210 @@
+/*
+->registros.c
+Implementação do armazém único de registros (amostras agrícolas).
+Cada amostra existe uma única vez, em blocos contíguos de registros que nunca são realocados,
+de modo que os ponteiros para os registros permanecem válidos enquanto a amostra existir.
+As estruturas de dados (hash, AVL, skiplist e listas) guardam apenas o ID e um ponteiro para o
+registro, além dos seus próprios campos de ligação. As posições liberadas por remoções são
+reaproveitadas pelas inserções seguintes.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "registros.h"
+#include "memoria.h"
+
+/*
+Inicializa um armazém vazio.
+Parâmetro: armazem - ponteiro para o armazém
+*/
+void iniciar_armazem(ArmazemRegistros *armazem){
+    armazem->blocos = NULL;
+    armazem->n_blocos = 0;
+    armazem->cap_blocos = 0;
+    armazem->livres = NULL;
+    armazem->n_livres = 0;
+    armazem->cap_livres = 0;
+    armazem->total = 0;
+}
+
+/*
+Acrescenta um bloco de registros ao armazém. O vetor de blocos cresce dobrando de tamanho,
+mas os blocos em si nunca mudam de endereço. Cada bloco ocupa uma faixa fixa de posições,
+logo após as posições do bloco anterior.
+Parâmetros:
+    armazem - ponteiro para o armazém
+    itens - vetor de registros do bloco
+    capacidade - número de registros que cabem no bloco
+    usados - número de registros já ocupados no bloco
+*/
+static void acrescentar_bloco(ArmazemRegistros *armazem, Registro *itens, int capacidade, int usados){
+    if(armazem->n_blocos == armazem->cap_blocos){
+        int nova_capacidade = armazem->cap_blocos == 0 ? 8 : armazem->cap_blocos * 2;
+        BlocoRegistros *blocos = (BlocoRegistros*)realocar_memoria(MEMORIA_REGISTROS, armazem->blocos, nova_capacidade * sizeof(BlocoRegistros));
+        if(!blocos){
+            printf("Erro ao alocar memoria para o armazem de registros\n");
+            exit(EXIT_FAILURE);
+        }
+        armazem->blocos = blocos;
+        armazem->cap_blocos = nova_capacidade;
+    }
+
+    armazem->blocos[armazem->n_blocos].itens = itens;
+    armazem->blocos[armazem->n_blocos].capacidade = capacidade;
+    armazem->blocos[armazem->n_blocos].usados = usados;
+    armazem->blocos[armazem->n_blocos].inicio = 0;
+    if(armazem->n_blocos > 0){
+        const BlocoRegistros *anterior = &armazem->blocos[armazem->n_blocos - 1];
+        armazem->blocos[armazem->n_blocos].inicio = anterior->inicio + anterior->capacidade;
+    }
+    armazem->n_blocos++;
+}
+
+/*
+Copia um registro para o armazém, reaproveitando uma posição liberada quando houver.
+Parâmetros:
+    armazem - ponteiro para o armazém
+    r - ponteiro para o registro a ser copiado
+Retorno: ponteiro estável para o registro armazenado
+*/
+Registro* adicionar_armazem(ArmazemRegistros *armazem, const Registro *r){
+    Registro *destino;
+
+    if(armazem->n_livres > 0){
+        armazem->n_livres--;
+        destino = armazem->livres[armazem->n_livres];
+    }else{
+        BlocoRegistros *ultimo = armazem->n_blocos > 0 ? &armazem->blocos[armazem->n_blocos - 1] : NULL;
+        if(ultimo == NULL || ultimo->usados == ultimo->capacidade){
+            Registro *itens = (Registro*)alocar_memoria(MEMORIA_REGISTROS, TAM_BLOCO_REGISTROS * sizeof(Registro));
+            if(!itens){
+                printf("Erro ao alocar memoria para o armazem de registros\n");
+                exit(EXIT_FAILURE);
+            }
+            acrescentar_bloco(armazem, itens, TAM_BLOCO_REGISTROS, 0);
+            ultimo = &armazem->blocos[armazem->n_blocos - 1];
+        }
+        destino = &ultimo->itens[ultimo->usados];
+        ultimo->usados++;
+    }
+
+    *destino = *r;
+    armazem->total++;
+    return destino;
+}
+
+/*
+Libera a posição de um registro para ser reaproveitada. O registro deve ter sido removido
+antes de todas as estruturas que apontam para ele. A posição fica marcada com o ID
+ID_LIVRE_ARMAZEM até ser reaproveitada, para que varreduras diretas dos blocos a ignorem.
+Parâmetros:
+    armazem - ponteiro para o armazém
+    r - ponteiro para o registro a ser liberado
+*/
+void remover_armazem(ArmazemRegistros *armazem, Registro *r){
+    if(armazem->n_livres == armazem->cap_livres){
+        int nova_capacidade = armazem->cap_livres == 0 ? 64 : armazem->cap_livres * 2;
+        Registro **livres = (Registro**)realocar_memoria(MEMORIA_REGISTROS, armazem->livres, nova_capacidade * sizeof(Registro*));
+        if(!livres){
+            printf("Erro ao alocar memoria para o armazem de registros\n");
+            exit(EXIT_FAILURE);
+        }
+        armazem->livres = livres;
+        armazem->cap_livres = nova_capacidade;
+    }
+
+    r->id = ID_LIVRE_ARMAZEM;
+    armazem->livres[armazem->n_livres] = r;
+    armazem->n_livres++;
+    armazem->total--;
+}
+
+/*
+Transfere para o armazém o vetor de registros de um dataset, sem copiá-lo: o vetor passa a
+ser um bloco do armazém e os ponteiros para os seus registros continuam válidos. O dataset
+fica vazio.
+Parâmetros:
+    armazem - ponteiro para o armazém
+    ds - ponteiro para o dataset cujos registros serão transferidos
+*/
+void adotar_dataset_armazem(ArmazemRegistros *armazem, Dataset *ds){
+    if(ds->itens != NULL){
+        transferir_memoria(MEMORIA_DATASET, MEMORIA_REGISTROS, ds->itens);
+        acrescentar_bloco(armazem, ds->itens, ds->capacidade, ds->total);
+        armazem->total += ds->total;
+    }
+    iniciar_dataset(ds);
+}
+
+/*
+Retorna a posição de um registro no armazém. A posição é estável enquanto o registro existir
+e é reaproveitada, como o próprio registro, quando ele é removido.
+Parâmetros:
+    armazem - ponteiro para o armazém
+    r - ponteiro para um registro do armazém
+Retorno: posição do registro, ou -1 se ele não pertence ao armazém
+*/
+int posicao_armazem(const ArmazemRegistros *armazem, const Registro *r){
+    int i = armazem->n_blocos - 1;
+    for(i; i >= 0; i--){
+        const BlocoRegistros *bloco = &armazem->blocos[i];
+        if(r >= bloco->itens && r < bloco->itens + bloco->usados){
+            return bloco->inicio + (int)(r - bloco->itens);
+        }
+    }
+    return -1;
+}
+
+/*
+Retorna o registro que ocupa uma posição do armazém (busca binária pelo bloco).
+Parâmetros:
+    armazem - ponteiro para o armazém
+    posicao - posição obtida com posicao_armazem
+Retorno: ponteiro para o registro, ou NULL se a posição não está em uso por nenhum bloco
+*/
+Registro* registro_posicao_armazem(const ArmazemRegistros *armazem, int posicao){
+    int inicio = 0;
+    int fim = armazem->n_blocos - 1;
+    while(inicio <= fim){
+        int meio = inicio + (fim - inicio) / 2;
+        const BlocoRegistros *bloco = &armazem->blocos[meio];
+        if(posicao < bloco->inicio){
+            fim = meio - 1;
+        }else if(posicao >= bloco->inicio + bloco->capacidade){
+            inicio = meio + 1;
+        }else{
+            return posicao - bloco->inicio < bloco->usados ? &bloco->itens[posicao - bloco->inicio] : NULL;
+        }
+    }
+    return NULL;
+}
+
+/*
+Retorna a memória ocupada pelos blocos de registros do armazém.
+Parâmetro: armazem - ponteiro para o armazém
+Retorno: memória em bytes
+*/
+size_t memoria_armazem(const ArmazemRegistros *armazem){
+    size_t memoria = 0;
+    int i = 0;
+    for(i; i < armazem->n_blocos; i++){
+        memoria += (size_t)armazem->blocos[i].capacidade * sizeof(Registro);
+    }
+    return memoria;
+}
+
+/*
+Libera todos os registros do armazém. As estruturas que apontam para eles devem ser
+liberadas antes.
+Parâmetro: armazem - ponteiro para o armazém
+*/
+void liberar_armazem(ArmazemRegistros *armazem){
+    int i = 0;
+    for(i; i < armazem->n_blocos; i++){
+        liberar_memoria(MEMORIA_REGISTROS, armazem->blocos[i].itens);
+    }
+    liberar_memoria(MEMORIA_REGISTROS, armazem->blocos);
+    liberar_memoria(MEMORIA_REGISTROS, armazem->livres);
+    iniciar_armazem(armazem);
+}
@@ -0,0 +1,35 @@
+#ifndef REGISTROS_H
+#define REGISTROS_H
+
+#include "dataset.h"
+
+#define TAM_BLOCO_REGISTROS 1024
+#define ID_LIVRE_ARMAZEM -1
+
+typedef struct{
+    Registro *itens;
+    int capacidade;
+    int usados;
+    int inicio;
+} BlocoRegistros;
+
+typedef struct{
+    BlocoRegistros *blocos;
+    int n_blocos;
+    int cap_blocos;
+    Registro **livres;
+    int n_livres;
+    int cap_livres;
+    int total;
+} ArmazemRegistros;
+
+void iniciar_armazem(ArmazemRegistros *armazem);
+Registro* adicionar_armazem(ArmazemRegistros *armazem, const Registro *r);
+void remover_armazem(ArmazemRegistros *armazem, Registro *r);
+void adotar_dataset_armazem(ArmazemRegistros *armazem, Dataset *ds);
+int posicao_armazem(const ArmazemRegistros *armazem, const Registro *r);
+Registro* registro_posicao_armazem(const ArmazemRegistros *armazem, int posicao);
+size_t memoria_armazem(const ArmazemRegistros *armazem);
+void liberar_armazem(ArmazemRegistros *armazem);
+
+#endif
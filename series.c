@@ -0,0 +1,405 @@
+/*
+->series.c
+Implementação do índice de séries temporais por (estado, cultura).
+Cada par tem um vetor denso indexado pelo ano, de ANO_INICIAL_SERIES até o último ano visto,
+com as somas acumuladas (prefixos) de produção, valor total e área plantada e a contagem de
+amostras. O total de uma série em um intervalo de anos é a diferença entre dois prefixos,
+ou seja, duas leituras do vetor, sem percorrer as amostras.
+Inserções e remoções atualizam os prefixos a partir do ano da amostra (no máximo um elemento
+por ano da série). Estados e culturas são identificados pela classe do dicionário, como nos
+filtros, sem diferenciar maiúsculas de minúsculas.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "series.h"
+#include "memoria.h"
+
+#define BALDE_VAZIO_SERIES -1
+
+/*
+Inicializa um índice de séries vazio.
+Parâmetro: indice - ponteiro para o índice
+*/
+void iniciar_indice_series(IndiceSeries *indice){
+    indice->series = NULL;
+    indice->total = 0;
+    indice->capacidade = 0;
+    indice->baldes = NULL;
+    indice->n_baldes = 0;
+}
+
+/*
+Calcula o balde inicial de um par (estado, cultura).
+*/
+static unsigned int hash_series(int estado, int cultura, int n_baldes){
+    unsigned int h = ((unsigned int)estado << 16) ^ (unsigned int)cultura;
+    h *= 2654435761u;
+    return (h >> 8) & (unsigned int)(n_baldes - 1);
+}
+
+/*
+Refaz a tabela de baldes com um novo número de baldes (potência de 2).
+*/
+static void refazer_baldes_series(IndiceSeries *indice, int n_baldes){
+    int *baldes = (int*)alocar_memoria(MEMORIA_SERIES, n_baldes * sizeof(int));
+    if(!baldes){
+        printf("Erro ao alocar memoria para o indice de series\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0;
+    for(i; i < n_baldes; i++){
+        baldes[i] = BALDE_VAZIO_SERIES;
+    }
+    for(i = 0; i < indice->total; i++){
+        unsigned int b = hash_series(indice->series[i].estado, indice->series[i].cultura, n_baldes);
+        while(baldes[b] != BALDE_VAZIO_SERIES){
+            b = (b + 1) & (n_baldes - 1);
+        }
+        baldes[b] = i;
+    }
+    liberar_memoria(MEMORIA_SERIES, indice->baldes);
+    indice->baldes = baldes;
+    indice->n_baldes = n_baldes;
+}
+
+/*
+Procura a série de um par (estado, cultura).
+Parâmetros:
+    indice - ponteiro para o índice
+    estado, cultura - classes do dicionário
+Retorno: ponteiro para a série, ou NULL se o par não tem série
+*/
+static SerieTemporal* procurar_serie(const IndiceSeries *indice, int estado, int cultura){
+    if(indice->n_baldes == 0){
+        return NULL;
+    }
+    unsigned int b = hash_series(estado, cultura, indice->n_baldes);
+    while(indice->baldes[b] != BALDE_VAZIO_SERIES){
+        SerieTemporal *serie = &indice->series[indice->baldes[b]];
+        if(serie->estado == estado && serie->cultura == cultura){
+            return serie;
+        }
+        b = (b + 1) & (indice->n_baldes - 1);
+    }
+    return NULL;
+}
+
+/*
+Cria a série (vazia) de um par (estado, cultura).
+Retorno: ponteiro para a série criada
+*/
+static SerieTemporal* criar_serie(IndiceSeries *indice, int estado, int cultura){
+    if(indice->total == indice->capacidade){
+        int nova_capacidade = indice->capacidade == 0 ? 64 : indice->capacidade * 2;
+        SerieTemporal *series = (SerieTemporal*)realocar_memoria(MEMORIA_SERIES, indice->series, nova_capacidade * sizeof(SerieTemporal));
+        if(!series){
+            printf("Erro ao alocar memoria para o indice de series\n");
+            exit(EXIT_FAILURE);
+        }
+        indice->series = series;
+        indice->capacidade = nova_capacidade;
+    }
+
+    SerieTemporal *serie = &indice->series[indice->total];
+    serie->estado = estado;
+    serie->cultura = cultura;
+    serie->ano_inicial = ANO_INICIAL_SERIES;
+    serie->n_anos = 0;
+    serie->acumulado = NULL;
+    indice->total++;
+
+    /* Mantém a ocupação dos baldes em no máximo 50% */
+    if(indice->total * 2 > indice->n_baldes){
+        refazer_baldes_series(indice, indice->n_baldes == 0 ? 128 : indice->n_baldes * 2);
+    }else{
+        unsigned int b = hash_series(estado, cultura, indice->n_baldes);
+        while(indice->baldes[b] != BALDE_VAZIO_SERIES){
+            b = (b + 1) & (indice->n_baldes - 1);
+        }
+        indice->baldes[b] = indice->total - 1;
+    }
+    return serie;
+}
+
+/*
+Estende o vetor de uma série para que ele cubra um ano. Anos novos no fim repetem o último
+prefixo; anos novos no início (anteriores a ANO_INICIAL_SERIES) têm prefixo zero.
+Parâmetros:
+    serie - ponteiro para a série
+    ano - ano que precisa estar coberto
+*/
+static void cobrir_ano_serie(SerieTemporal *serie, int ano){
+    if(serie->n_anos > 0 && ano >= serie->ano_inicial && ano < serie->ano_inicial + serie->n_anos){
+        return;
+    }
+
+    int ano_inicial = serie->ano_inicial;
+    if(ano < ano_inicial){
+        ano_inicial = ano;
+    }
+    int ano_final = serie->ano_inicial + serie->n_anos - 1;
+    if(serie->n_anos == 0 || ano > ano_final){
+        ano_final = ano;
+    }
+    int n_anos = ano_final - ano_inicial + 1;
+    int deslocamento = serie->ano_inicial - ano_inicial;
+
+    TotalSerie *acumulado = (TotalSerie*)alocar_zerada_memoria(MEMORIA_SERIES, n_anos + 1, sizeof(TotalSerie));
+    if(!acumulado){
+        printf("Erro ao alocar memoria para o indice de series\n");
+        exit(EXIT_FAILURE);
+    }
+    if(serie->n_anos > 0){
+        memcpy(&acumulado[deslocamento], serie->acumulado, (serie->n_anos + 1) * sizeof(TotalSerie));
+        int i = deslocamento + serie->n_anos + 1;
+        for(i; i <= n_anos; i++){
+            acumulado[i] = acumulado[deslocamento + serie->n_anos];
+        }
+    }
+
+    liberar_memoria(MEMORIA_SERIES, serie->acumulado);
+    serie->acumulado = acumulado;
+    serie->ano_inicial = ano_inicial;
+    serie->n_anos = n_anos;
+}
+
+/*
+Soma (ou subtrai) os valores de um registro em todos os prefixos a partir do seu ano.
+Parâmetros:
+    serie - ponteiro para a série
+    r - ponteiro para o registro
+    sinal - 1 para inserir, -1 para remover
+*/
+static void acumular_serie(SerieTemporal *serie, const Registro *r, int sinal){
+    int i = r->ano - serie->ano_inicial + 1;
+    for(i; i <= serie->n_anos; i++){
+        serie->acumulado[i].producao += sinal * (double)r->producao;
+        serie->acumulado[i].valor_total += sinal * (double)r->valor_total;
+        serie->acumulado[i].area_plantada += sinal * (double)r->area_plantada;
+        serie->acumulado[i].contagem += sinal;
+    }
+}
+
+/*
+Acrescenta um registro à série do seu par (estado, cultura).
+Parâmetros:
+    indice - ponteiro para o índice
+    r - ponteiro para o registro
+*/
+void inserir_series(IndiceSeries *indice, const Registro *r){
+    int estado = dicionario_estados.classes[r->estado];
+    int cultura = dicionario_culturas.classes[r->cultura];
+    SerieTemporal *serie = procurar_serie(indice, estado, cultura);
+    if(serie == NULL){
+        serie = criar_serie(indice, estado, cultura);
+    }
+    cobrir_ano_serie(serie, r->ano);
+    acumular_serie(serie, r, 1);
+}
+
+/*
+Retira um registro da série do seu par (estado, cultura).
+Parâmetros:
+    indice - ponteiro para o índice
+    r - ponteiro para o registro (com os mesmos valores de quando foi inserido)
+*/
+void remover_series(IndiceSeries *indice, const Registro *r){
+    SerieTemporal *serie = procurar_serie(indice, dicionario_estados.classes[r->estado], dicionario_culturas.classes[r->cultura]);
+    if(serie == NULL || r->ano < serie->ano_inicial || r->ano >= serie->ano_inicial + serie->n_anos){
+        return;
+    }
+    acumular_serie(serie, r, -1);
+}
+
+/*
+Carrega no índice todos os registros de um dataset já carregado. Os totais de cada ano são
+somados primeiro e os prefixos calculados uma única vez por série.
+Parâmetros:
+    indice - ponteiro para o índice
+    ds - ponteiro para o dataset
+*/
+void carregar_registros_series(IndiceSeries *indice, const Dataset *ds){
+    int i = 0;
+    for(i; i < ds->total; i++){
+        const Registro *r = &ds->itens[i];
+        SerieTemporal *serie = procurar_serie(indice, dicionario_estados.classes[r->estado], dicionario_culturas.classes[r->cultura]);
+        if(serie == NULL){
+            serie = criar_serie(indice, dicionario_estados.classes[r->estado], dicionario_culturas.classes[r->cultura]);
+        }
+        cobrir_ano_serie(serie, r->ano);
+    }
+
+    /* Primeiro os totais de cada ano (na posição seguinte ao ano), depois os prefixos */
+    for(i = 0; i < indice->total; i++){
+        SerieTemporal *serie = &indice->series[i];
+        int j = serie->n_anos;
+        for(j; j > 0; j--){
+            TotalSerie *atual = &serie->acumulado[j];
+            const TotalSerie *anterior = &serie->acumulado[j - 1];
+            atual->producao -= anterior->producao;
+            atual->valor_total -= anterior->valor_total;
+            atual->area_plantada -= anterior->area_plantada;
+            atual->contagem -= anterior->contagem;
+        }
+    }
+    for(i = 0; i < ds->total; i++){
+        const Registro *r = &ds->itens[i];
+        SerieTemporal *serie = procurar_serie(indice, dicionario_estados.classes[r->estado], dicionario_culturas.classes[r->cultura]);
+        TotalSerie *ano = &serie->acumulado[r->ano - serie->ano_inicial + 1];
+        ano->producao += r->producao;
+        ano->valor_total += r->valor_total;
+        ano->area_plantada += r->area_plantada;
+        ano->contagem++;
+    }
+    for(i = 0; i < indice->total; i++){
+        SerieTemporal *serie = &indice->series[i];
+        int j = 1;
+        for(j; j <= serie->n_anos; j++){
+            TotalSerie *atual = &serie->acumulado[j];
+            const TotalSerie *anterior = &serie->acumulado[j - 1];
+            atual->producao += anterior->producao;
+            atual->valor_total += anterior->valor_total;
+            atual->area_plantada += anterior->area_plantada;
+            atual->contagem += anterior->contagem;
+        }
+    }
+}
+
+/*
+Calcula os totais de uma série em um intervalo de anos com duas leituras do vetor de prefixos.
+Parâmetros:
+    indice - ponteiro para o índice
+    estado - estado da série (string, sem diferenciar maiúsculas de minúsculas)
+    cultura - cultura da série (string, sem diferenciar maiúsculas de minúsculas)
+    ano_min, ano_max - intervalo de anos (inclusivo)
+    total - ponteiro que recebe os totais (zerados se a série ou o intervalo forem vazios)
+Retorno: 1 se a série existe, 0 caso contrário
+*/
+int consultar_series(const IndiceSeries *indice, const char *estado, const char *cultura, int ano_min, int ano_max, TotalSerie *total){
+    memset(total, 0, sizeof(TotalSerie));
+
+    int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+    int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+    if(filtro_estado < 0 || filtro_cultura < 0){
+        return 0;
+    }
+    const SerieTemporal *serie = procurar_serie(indice, filtro_estado, filtro_cultura);
+    if(serie == NULL){
+        return 0;
+    }
+
+    if(ano_min < serie->ano_inicial){
+        ano_min = serie->ano_inicial;
+    }
+    if(ano_max > serie->ano_inicial + serie->n_anos - 1){
+        ano_max = serie->ano_inicial + serie->n_anos - 1;
+    }
+    if(ano_min > ano_max){
+        return 1;
+    }
+
+    const TotalSerie *ate = &serie->acumulado[ano_max - serie->ano_inicial + 1];
+    const TotalSerie *antes = &serie->acumulado[ano_min - serie->ano_inicial];
+    total->producao = ate->producao - antes->producao;
+    total->valor_total = ate->valor_total - antes->valor_total;
+    total->area_plantada = ate->area_plantada - antes->area_plantada;
+    total->contagem = ate->contagem - antes->contagem;
+    return 1;
+}
+
+/*
+Retorna a memória ocupada pelo índice de séries.
+Parâmetro: indice - ponteiro para o índice
+Retorno: memória em bytes
+*/
+size_t memoria_series(const IndiceSeries *indice){
+    size_t memoria = sizeof(IndiceSeries) + (size_t)indice->capacidade * sizeof(SerieTemporal) + (size_t)indice->n_baldes * sizeof(int);
+    int i = 0;
+    for(i; i < indice->total; i++){
+        memoria += (size_t)(indice->series[i].n_anos + 1) * sizeof(TotalSerie);
+    }
+    return memoria;
+}
+
+/*
+Libera toda a memória do índice de séries, deixando-o vazio.
+Parâmetro: indice - ponteiro para o índice
+*/
+void liberar_indice_series(IndiceSeries *indice){
+    int i = 0;
+    for(i; i < indice->total; i++){
+        liberar_memoria(MEMORIA_SERIES, indice->series[i].acumulado);
+    }
+    liberar_memoria(MEMORIA_SERIES, indice->series);
+    liberar_memoria(MEMORIA_SERIES, indice->baldes);
+    iniciar_indice_series(indice);
+}
+
+/*
+Mede o tempo de n consultas de totais por (estado, cultura) em intervalos de anos aleatórios,
+respondidas pelo índice de séries ou por uma varredura completa dos registros.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada (dataset)
+    n - número de consultas
+    por_varredura - 1 para percorrer os registros em cada consulta, 0 para usar o índice
+    semente - semente do sorteio das consultas, para que os dois modos respondam às mesmas
+Retorno: tempo gasto em segundos (double)
+*/
+double bench_tempo_consulta_series(const char *nome_arquivo, int n, int por_varredura, unsigned int semente){
+    struct timespec inicio, fim;
+    Dataset ds;
+    IndiceSeries indice;
+    iniciar_dataset(&ds);
+    iniciar_indice_series(&indice);
+    carregar_dataset(&ds, nome_arquivo);
+    if(ds.total == 0){
+        liberar_dataset(&ds);
+        return 0;
+    }
+    carregar_registros_series(&indice, &ds);
+
+    srand(semente);
+    volatile double soma = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    int i = 0;
+    for(i; i < n; i++){
+        const Registro *alvo = &ds.itens[rand() % ds.total];
+        int ano_min = ANO_INICIAL_SERIES + rand() % 120;
+        int ano_max = ano_min + rand() % 30;
+        const char *estado = nome_estado(alvo->estado);
+        const char *cultura = nome_cultura(alvo->cultura);
+        TotalSerie total;
+
+        if(por_varredura){
+            int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+            int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+            memset(&total, 0, sizeof(TotalSerie));
+            int j = 0;
+            for(j; j < ds.total; j++){
+                const Registro *r = &ds.itens[j];
+                if(r->ano >= ano_min && r->ano <= ano_max
+                    && ACEITA_FILTRO(dicionario_estados, r->estado, filtro_estado)
+                    && ACEITA_FILTRO(dicionario_culturas, r->cultura, filtro_cultura)){
+                    total.producao += r->producao;
+                    total.valor_total += r->valor_total;
+                    total.area_plantada += r->area_plantada;
+                    total.contagem++;
+                }
+            }
+        }else{
+            consultar_series(&indice, estado, cultura, ano_min, ano_max, &total);
+        }
+        soma += total.producao;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+
+    liberar_indice_series(&indice);
+    liberar_dataset(&ds);
+    return (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+}
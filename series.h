@@ -0,0 +1,41 @@
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <stdio.h>
+#include "dataset.h"
+
+#define ANO_INICIAL_SERIES 1908
+
+typedef struct{
+    double producao;
+    double valor_total;
+    double area_plantada;
+    long long contagem;
+} TotalSerie;
+
+typedef struct{
+    int estado;
+    int cultura;
+    int ano_inicial;
+    int n_anos;
+    TotalSerie *acumulado;
+} SerieTemporal;
+
+typedef struct{
+    SerieTemporal *series;
+    int total;
+    int capacidade;
+    int *baldes;
+    int n_baldes;
+} IndiceSeries;
+
+void iniciar_indice_series(IndiceSeries *indice);
+void inserir_series(IndiceSeries *indice, const Registro *r);
+void remover_series(IndiceSeries *indice, const Registro *r);
+void carregar_registros_series(IndiceSeries *indice, const Dataset *ds);
+int consultar_series(const IndiceSeries *indice, const char *estado, const char *cultura, int ano_min, int ano_max, TotalSerie *total);
+size_t memoria_series(const IndiceSeries *indice);
+void liberar_indice_series(IndiceSeries *indice);
+double bench_tempo_consulta_series(const char *nome_arquivo, int n, int por_varredura, unsigned int semente);
+
+#endif
@@ -2,37 +2,50 @@
 ->skiplist.c
 Implementação de uma skip list para manipulação de amostras agrícolas.
 Este arquivo contém as funções para inserir, remover, buscar, filtrar, imprimir
-e carregar dados em uma skip list, além de funções auxiliares
-e do conjunto de nove funções para benchmark.
+e carregar dados em uma skip list, além de funções auxiliares e das primitivas
+usadas pelo modo benchmark (bench.c).
 */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <strings.h>
 #include <time.h>
 #include <windows.h>
 #include "skiplist.h"
+#include "memoria.h"
+
+#if defined(_MSC_VER)
+#define LOCAL_DA_THREAD __declspec(thread)
+#else
+#define LOCAL_DA_THREAD __thread
+#endif
+
+/* Estado do gerador de números aleatórios dos níveis, um por thread (0 = ainda não semeado) */
+static LOCAL_DA_THREAD unsigned long long estado_aleatorio_skiplist = 0;
 
 /*
 Inicializa e retorna um ponteiro para uma nova skip list vazia.
 Retorno: ponteiro para a estrutura Skiplist inicializada
 */
 Skiplist* iniciar_skiplist(){
-    Skiplist* lista = malloc(sizeof(Skiplist));
+    Skiplist* lista = alocar_memoria(MEMORIA_SKIPLIST, sizeof(Skiplist));
     if (!lista){
         printf("Erro ao alocar memória para a skiplist\n");
         exit(EXIT_FAILURE);
     }
     lista->nivel = 0;
+    lista->bits_probabilidade = BITS_PROBABILIDADE_SKIPLIST;
 
-    lista->cabeca = malloc(sizeof(ElementoSkiplist));
+    lista->cabeca = alocar_memoria(MEMORIA_SKIPLIST, tamanho_elemento_skiplist(NIVEL_MAX_SKIPLIST));
     if (!lista->cabeca){
         printf("Erro ao alocar memória para o header\n");
-        free(lista);
+        liberar_memoria(MEMORIA_SKIPLIST, lista);
         exit(EXIT_FAILURE);
     }
 
+    lista->cabeca->nivel = NIVEL_MAX_SKIPLIST;
     int i = 0;
     for (i; i < NIVEL_MAX_SKIPLIST; i++){
         lista->cabeca->proximo[i] = NULL;
@@ -42,47 +55,128 @@ Skiplist* iniciar_skiplist(){
 }
 
 /*
-Gera de forma probabilística o nível de um novo nó na skip list.
-Retorno: nível inteiro gerado aleatoriamente
+Define a probabilidade p de um nó subir para o nível seguinte. Como os níveis são sorteados
+contando bits, p é arredondada para a potência de 1/2 mais próxima em escala logarítmica
+(1/2, 1/4, 1/8, ...).
+Parâmetros:
+    lista - ponteiro para a skip list
+    p - probabilidade desejada (entre 0 e 1)
+*/
+void definir_probabilidade_skiplist(Skiplist *lista, double p){
+    int bits = 1;
+    while (bits < 16 && p * (1 << bits) < 0.70710678){
+        bits++;
+    }
+    lista->bits_probabilidade = bits;
+}
+
+/*
+Calcula o tamanho de um nó com o número de níveis informado. Cada nó é alocado apenas com
+os ponteiros que usa, em vez de NIVEL_MAX_SKIPLIST ponteiros.
+Parâmetro: nivel - número de níveis do nó
+Retorno: tamanho do nó em bytes
+*/
+size_t tamanho_elemento_skiplist(int nivel){
+    return sizeof(ElementoSkiplist) + nivel * sizeof(ElementoSkiplist*);
+}
+
+/*
+Gera um número aleatório de 64 bits (xorshift64*). Cada thread tem o seu próprio estado, de
+modo que não há disputa nem sincronização entre threads; o estado é semeado na primeira
+chamada com o horário e o endereço do próprio estado, que é diferente em cada thread.
+Retorno: número aleatório de 64 bits
+*/
+unsigned long long aleatorio_skiplist(){
+    unsigned long long x = estado_aleatorio_skiplist;
+    if (x == 0){
+        x = (unsigned long long)time(NULL) ^ (unsigned long long)(size_t)&estado_aleatorio_skiplist;
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        if (x == 0){
+            x = 0x9e3779b97f4a7c15ULL;
+        }
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    estado_aleatorio_skiplist = x;
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+/*
+Fixa o estado do gerador da thread atual, para que a sequência de níveis sorteados (e portanto
+a forma da skiplist) se repita entre execuções. A semente passa pelo mesmo embaralhamento da
+semeadura automática.
+Parâmetro: semente - semente do gerador
 */
-int nivel_aleatorio_skiplist(){
-    int nvl = 1;
-    while ((rand() % 100) < 50 && nvl < NIVEL_MAX_SKIPLIST){
-        nvl++;
+void semear_aleatorio_skiplist(unsigned long long semente){
+    unsigned long long x = semente + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    estado_aleatorio_skiplist = x != 0 ? x : 0x9e3779b97f4a7c15ULL;
+}
+
+/*
+Sorteia um nível. Cada bit de um número aleatório vale 1/2, então o número de zeros à direita
+segue uma distribuição geométrica; agrupando-os de bits_probabilidade em bits_probabilidade,
+a chance de subir cada nível é p = 1/2^bits_probabilidade. Um único sorteio basta para
+qualquer nível.
+Parâmetro: bits_probabilidade - expoente de p
+Retorno: nível entre 1 e NIVEL_MAX_SKIPLIST
+*/
+static int sortear_nivel_skiplist(int bits_probabilidade){
+    unsigned long long x = aleatorio_skiplist();
+    int zeros = x == 0 ? 64 : __builtin_ctzll(x);
+    int nvl = 1 + zeros / bits_probabilidade;
+    if (nvl > NIVEL_MAX_SKIPLIST){
+        nvl = NIVEL_MAX_SKIPLIST;
     }
     return nvl;
 }
 
 /*
-Insere um novo elemento na skip list, mantendo a ordem por ID.
+Gera de forma probabilística o nível de um novo nó na skip list, com a probabilidade
+configurada na lista.
+Parâmetro: lista - ponteiro para a skip list
+Retorno: nível inteiro gerado aleatoriamente
+*/
+int nivel_aleatorio_skiplist(const Skiplist *lista){
+    return sortear_nivel_skiplist(lista->bits_probabilidade);
+}
+
+/*
+Insere um novo elemento na skip list, mantendo a ordem por ID. O nó guarda apenas o ID e o
+ponteiro para o registro, que pertence ao armazém de registros.
 Parâmetros:
     lista - ponteiro para a skip list
-    novo_dado - estrutura com os dados a serem inseridos
+    registro - ponteiro para o registro a ser indexado
+Retorno: ponteiro para o nó criado
 */
-void inserir_skiplist(Skiplist *lista, ElementoSkiplist novo_dado){
+ElementoSkiplist* inserir_skiplist(Skiplist *lista, Registro *registro){
     ElementoSkiplist *atualizacao[NIVEL_MAX_SKIPLIST];
     ElementoSkiplist *x = lista->cabeca;
     
     int i = lista->nivel;
     for (i; i >= 0; i--){
-        while (x->proximo[i] != NULL && x->proximo[i]->id < novo_dado.id){
+        while (x->proximo[i] != NULL && x->proximo[i]->id < registro->id){
             x = x->proximo[i];
         }
         atualizacao[i] = x;
     }
     
-    int novo_nivel = nivel_aleatorio_skiplist();
-    ElementoSkiplist *novo = malloc(sizeof(ElementoSkiplist));
+    int novo_nivel = nivel_aleatorio_skiplist(lista);
+    ElementoSkiplist *novo = alocar_memoria(MEMORIA_SKIPLIST, tamanho_elemento_skiplist(novo_nivel));
     if (!novo){
         printf("Erro na alocação do novo nó\n");
         exit(EXIT_FAILURE);
     }
     
-    *novo = novo_dado;
-    int m = 0;
-    for (m; m < NIVEL_MAX_SKIPLIST; m++) {
-        novo->proximo[m] = NULL;
-    }
+    novo->id = registro->id;
+    novo->nivel = novo_nivel;
+    novo->registro = registro;
     
     if (novo_nivel > lista->nivel){
         int j = lista->nivel + 1;
@@ -97,6 +191,7 @@ void inserir_skiplist(Skiplist *lista, ElementoSkiplist novo_dado){
         novo->proximo[k] = atualizacao[k]->proximo[k];
         atualizacao[k]->proximo[k] = novo;
     }
+    return novo;
 }
 
 /*
@@ -154,7 +249,7 @@ int remover_skiplist(Skiplist *lista, int id){
         atualizacao[j]->proximo[j] = remover->proximo[j];
     }
 
-    free(remover);
+    liberar_memoria(MEMORIA_SKIPLIST, remover);
 
     while (lista->nivel > 0 && lista->cabeca->proximo[lista->nivel] == NULL){
         lista->nivel--;
@@ -171,9 +266,10 @@ void imprime_skiplist(Skiplist* lista){
     int contador = 0;
     
     while (atual != NULL){
+        const Registro *r = atual->registro;
         printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-             atual->id, atual->ano, atual->estado, atual->cultura, atual->preco_ton,
-              atual->rendimento, atual->producao, atual->area_plantada, atual->valor_total);
+             r->id, r->ano, nome_estado(r->estado), nome_cultura(r->cultura), r->preco_ton,
+              r->rendimento, r->producao, r->area_plantada, r->valor_total);
         contador++;
         atual = atual->proximo[0];
     }
@@ -190,66 +286,40 @@ void libera_skiplist(Skiplist* lista){
 
     while (atual != NULL){
         proximo = atual->proximo[0];
-        free(atual);
+        liberar_memoria(MEMORIA_SKIPLIST, atual);
         atual = proximo;
     }
-    free(lista->cabeca);
-    free(lista);
+    liberar_memoria(MEMORIA_SKIPLIST, lista->cabeca);
+    liberar_memoria(MEMORIA_SKIPLIST, lista);
 }
 
 /*
-Carrega dados de um arquivo e insere na skip list.
+Carrega dados de um arquivo e insere na skip list. Os registros passam a pertencer ao armazém.
 Parâmetros:
     lista - ponteiro para a skip list
+    armazem - ponteiro para o armazém que recebe os registros
     nome_arquivo - nome do arquivo de entrada
 */
-void carregar_dados_skiplist(Skiplist* lista, const char* nome_arquivo){
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    while (fgets(linha, sizeof(linha), arquivo)){
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-               &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao,
-               &novo.area_plantada, &novo.valor_total);
-
-        inserir_skiplist(lista, novo);
-    }
-
-    fclose(arquivo);
+void carregar_dados_skiplist(Skiplist* lista, ArmazemRegistros* armazem, const char* nome_arquivo){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_skiplist(lista, &ds);
+    adotar_dataset_armazem(armazem, &ds);
 }
 
 /*
-Salva todos os elementos da skip list em um arquivo.
+Indexa na skip list todos os registros de um dataset já carregado em memória. O vetor do
+dataset deve permanecer alocado (normalmente transferido para o armazém de registros).
 Parâmetros:
     lista - ponteiro para a skip list
-    nome_arquivo - nome do arquivo de saída
+    ds - ponteiro para o dataset com os registros
 */
-void salvar_dados_skiplist(Skiplist* lista, const char* nome_arquivo){
-    FILE* arquivo = fopen(nome_arquivo, "w");
-    if (!arquivo){
-        printf("Erro ao abrir o arquivo");
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(arquivo, "ID;Data;Localizacao;Tipo de plantio;Preco por tonelada (Dolares/tonelada);Rendimento (kilogramas por hectare);Producao (toneladas);Area plantada (hectares);Valor total da safra (Dolares)\n");
-
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    while (atual != NULL){
-        fprintf(arquivo, "%d;%d;%s;%s;%.2f;%.2f;%.2f;%.2f;%.2f\n",
-                atual->id, atual->ano, atual->estado, atual->cultura,
-                atual->preco_ton, atual->rendimento, atual->producao,
-                atual->area_plantada, atual->valor_total);
-        atual = atual->proximo[0];
+void carregar_registros_skiplist(Skiplist* lista, Dataset* ds){
+    int i = 0;
+    for (i; i < ds->total; i++){
+        inserir_skiplist(lista, &ds->itens[i]);
     }
-
-    fclose(arquivo);
 }
 
 /*
@@ -272,78 +342,51 @@ int criar_id_skiplist(Skiplist* lista){
 
 /*
 Cria uma nova amostra a partir da entrada do usuário e insere na skip list.
-Parâmetro: lista - ponteiro para a skip list
+Parâmetros:
+    lista - ponteiro para a skip list
+    armazem - ponteiro para o armazém que recebe o novo registro
 */
-void criar_amostra_skiplist(Skiplist* lista){
-    ElementoSkiplist nova;
-    char entrada[50];
-     
-    nova.id = criar_id_skiplist(lista);
-    
-    printf("\n===Insira os dados da nova amostra===\n");
+void criar_amostra_skiplist(Skiplist* lista, ArmazemRegistros* armazem){
+    Registro nova;
+    ler_registro_usuario(&nova, criar_id_skiplist(lista));
 
-    printf("Ano: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%d", &nova.ano);
-    
-    printf("Estado: ");
-    fgets(nova.estado, sizeof(nova.estado), stdin);
-    nova.estado[strcspn(nova.estado, "\n")] = '\0';
-    
-    printf("Cultura: ");
-    fgets(nova.cultura, sizeof(nova.cultura), stdin);
-    nova.cultura[strcspn(nova.cultura, "\n")] = '\0';
-    
-    printf("Preco por tonelada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &nova.preco_ton);
-    
-    printf("Rendimento: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &nova.rendimento);
-    
-    printf("Producao: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &nova.producao);
-    
-    printf("Area plantada: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &nova.area_plantada);
-    
-    printf("Valor total: ");
-    fgets(entrada, sizeof(entrada), stdin);
-    sscanf(entrada, "%f", &nova.valor_total);
-    
-    inserir_skiplist(lista, nova);
+    inserir_skiplist(lista, adicionar_armazem(armazem, &nova));
     printf("\nAmostra inserida com sucesso! ID: %d\n", nova.id);
 }
 
 /*
-Busca e imprime elementos que atendem aos filtros de ano, estado e cultura.
+Busca e imprime elementos que atendem aos filtros de ano, estado e cultura, percorrendo o
+nível 0 da skiplist ou, quando há índice de bitmaps, consultando o índice.
 Parâmetros:
-  cabeca - ponteiro para a cabeça da lista
+  lista - ponteiro para a skiplist
   ano_min, ano_max - intervalo de anos
   cultura - filtro de cultura (string)
   estado - filtro de estado (string)
+  indice - índice de bitmaps sobre os mesmos registros, ou NULL para percorrer a lista
 */
-void buscarFiltros_skiplist(Skiplist* lista, int ano_min, int ano_max, const char* estado, const char* cultura){
+void buscarFiltros_skiplist(Skiplist* lista, int ano_min, int ano_max, const char* estado, const char* cultura, const IndiceBitmap *indice){
     ElementoSkiplist* atual = lista->cabeca->proximo[0];
     int encontrados = 0;
 
     printf("\n===RESULTADOS DA BUSCA===\n");
-    while (atual != NULL){
-        int ano_certo = (atual->ano >= ano_min) && (atual->ano <= ano_max);
-        int estado_certo = (estado == NULL || strlen(estado) == 0 || strcasecmp(atual->estado, estado) == 0);
-        int cultura_certa = (cultura == NULL || strlen(cultura) == 0 || strcasecmp(atual->cultura, cultura) == 0);
-
-        if (ano_certo && estado_certo && cultura_certa){
-            printf("%d | %d | %s | %s | %.2f | %.2f | %.2f | %.2f | %.2f\n",
-                atual->id, atual->ano, atual->estado, atual->cultura,
-                atual->preco_ton, atual->rendimento, atual->producao,
-                atual->area_plantada, atual->valor_total);
-            encontrados++;
+    if (indice != NULL){
+        encontrados = imprimir_filtro_indice_bitmap(indice, ano_min, ano_max, estado, cultura, imprimir_registro);
+    } else{
+        int filtro_estado = filtro_dicionario(&dicionario_estados, estado);
+        int filtro_cultura = filtro_dicionario(&dicionario_culturas, cultura);
+
+        while (atual != NULL){
+            const Registro *r = atual->registro;
+            int ano_certo = (r->ano >= ano_min) && (r->ano <= ano_max);
+            int estado_certo = ACEITA_FILTRO(dicionario_estados, r->estado, filtro_estado);
+            int cultura_certa = ACEITA_FILTRO(dicionario_culturas, r->cultura, filtro_cultura);
+
+            if (ano_certo && estado_certo && cultura_certa){
+                imprimir_registro(r);
+                encontrados++;
+            }
+            atual = atual->proximo[0];
         }
-        atual = atual->proximo[0];
     }
 
     if (encontrados == 0){
@@ -354,440 +397,575 @@ void buscarFiltros_skiplist(Skiplist* lista, int ano_min, int ano_max, const cha
 }
 
 /*
-Mede o tempo de inserção de n elementos na tabela hash a partir de um arquivo (dataset).
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
+Skip list concorrente (sem travas). Inserções, remoções e buscas podem ser chamadas por várias
+threads ao mesmo tempo. Os ponteiros de avanço são trocados com compare-and-swap e o bit mais
+baixo de proximo[i] marca o nó como removido naquele nível: a remoção primeiro marca o nó
+(remoção lógica) e depois o desliga da lista (remoção física), tarefa que qualquer thread que
+passe pelo nó marcado ajuda a fazer. A memória dos nós removidos é recuperada por épocas: um nó
+só é liberado depois que todas as threads que poderiam estar olhando para ele terminaram suas
+operações. Cada thread usa um índice obtido com registrar_thread_skiplist_concorrente.
 */
-double bench_temp_insercao_skiplist(const char* nome_arquivo, int n){
-    struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    
-    if(!arquivo){
-        printf("Erro ao abrir arquivo");
-        libera_skiplist(lista);
-        exit(EXIT_FAILURE);
-    }
 
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
-
-    int total_inseridos = 0;
-    
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    while(fgets(linha, sizeof(linha), arquivo) && total_inseridos < n){
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-               &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao,
-               &novo.area_plantada, &novo.valor_total);
-        
-        inserir_skiplist(lista, novo);
-        total_inseridos++;
-    }
-    
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+/*
+Funções auxiliares para ler e alterar a marca de remoção guardada no bit mais baixo de um
+ponteiro de avanço (os nós são alinhados, então esse bit é sempre 0 em um endereço válido).
+*/
+static int marcado_skiplist(ElementoSkiplistConcorrente* p){
+    return ((uintptr_t)p & 1) != 0;
+}
 
+static ElementoSkiplistConcorrente* desmarcar_skiplist(ElementoSkiplistConcorrente* p){
+    return (ElementoSkiplistConcorrente*)((uintptr_t)p & ~(uintptr_t)1);
+}
 
-    fclose(arquivo);
-    libera_skiplist(lista);
-    
-    return tempo;
+static ElementoSkiplistConcorrente* marcar_skiplist(ElementoSkiplistConcorrente* p){
+    return (ElementoSkiplistConcorrente*)((uintptr_t)p | 1);
 }
 
 /*
-Mede o tempo de remoção de n elementos da skip list.
+Troca atomicamente um ponteiro de avanço, se ele ainda tiver o valor esperado.
 Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de elementos a serem removidos
-Retorno: tempo gasto em segundos (double)
+    endereco - endereço do ponteiro de avanço
+    esperado - valor esperado
+    novo - novo valor
+Retorno: 1 se a troca foi feita, 0 caso contrário
 */
-double bench_temp_remocao_skiplist(const char* arquivo, int n){
-    struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    carregar_dados_skiplist(lista, arquivo);
+static int cas_skiplist(ElementoSkiplistConcorrente* volatile* endereco, ElementoSkiplistConcorrente* esperado, ElementoSkiplistConcorrente* novo){
+    return InterlockedCompareExchangePointer((PVOID volatile*)endereco, novo, esperado) == esperado;
+}
 
-    int* ids = malloc(n * sizeof(int));
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    int total_ids = 0;
-    
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->proximo[0];
-        total_ids++;
-    }
+/*
+Calcula o tamanho de um nó concorrente com o número de níveis informado.
+Parâmetro: nivel - número de níveis do nó
+Retorno: tamanho do nó em bytes
+*/
+static size_t tamanho_elemento_skiplist_concorrente(int nivel){
+    return sizeof(ElementoSkiplistConcorrente) + nivel * sizeof(ElementoSkiplistConcorrente*);
+}
 
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i + 1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
+/*
+Inicializa e retorna uma nova skip list concorrente vazia.
+Retorno: ponteiro para a estrutura SkiplistConcorrente inicializada
+*/
+SkiplistConcorrente* iniciar_skiplist_concorrente(){
+    SkiplistConcorrente* lista = alocar_memoria(MEMORIA_SKIPLIST, sizeof(SkiplistConcorrente));
+    if (!lista){
+        printf("Erro ao alocar memória para a skiplist\n");
+        exit(EXIT_FAILURE);
     }
+    memset(lista, 0, sizeof(SkiplistConcorrente));
+    lista->bits_probabilidade = BITS_PROBABILIDADE_SKIPLIST;
 
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-
-    int j = 0;
-    for(j; j < total_ids; j++){
-        remover_skiplist(lista, ids[j]);
+    lista->cabeca = alocar_memoria(MEMORIA_SKIPLIST, tamanho_elemento_skiplist_concorrente(NIVEL_MAX_SKIPLIST));
+    if (!lista->cabeca){
+        printf("Erro ao alocar memória para o header\n");
+        liberar_memoria(MEMORIA_SKIPLIST, lista);
+        exit(EXIT_FAILURE);
+    }
+    lista->cabeca->id = 0;
+    lista->cabeca->nivel = NIVEL_MAX_SKIPLIST;
+    lista->cabeca->registro = NULL;
+    int i = 0;
+    for (i; i < NIVEL_MAX_SKIPLIST; i++){
+        lista->cabeca->proximo[i] = NULL;
     }
 
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-
-    free(ids);
-    libera_skiplist(lista);
-
-    return tempo;
+    return lista;
 }
 
 /*
-Mede o tempo de busca de n elementos na skip list.
-Parâmetros:
-    nome_arquivo - nome do arquivo de entrada
-    n - número de buscas a serem realizadas
-Retorno: tempo gasto em segundos (double)
+Reserva um índice para a thread que vai operar sobre a lista. Cada thread deve usar sempre
+o seu próprio índice.
+Parâmetro: lista - ponteiro para a skip list concorrente
+Retorno: índice da thread (de 0 a MAX_THREADS_SKIPLIST - 1)
 */
-double bench_temp_busca_skiplist(const char* arquivo, int n){
-    struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    carregar_dados_skiplist(lista, arquivo);
-
-    int* ids = malloc(n * sizeof(int));
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    int total_ids = 0;
-    
-    while(atual != NULL && total_ids < n){
-        ids[total_ids] = atual->id;
-        atual = atual->proximo[0];
-        total_ids++;
+int registrar_thread_skiplist_concorrente(SkiplistConcorrente* lista){
+    long thread = InterlockedIncrement(&lista->n_threads) - 1;
+    if (thread >= MAX_THREADS_SKIPLIST){
+        printf("Erro: limite de %d threads da skiplist concorrente atingido\n", MAX_THREADS_SKIPLIST);
+        exit(EXIT_FAILURE);
     }
+    return (int)thread;
+}
 
-    srand(time(NULL));
-    int i = total_ids - 1;
-    for(i; i > 0; i--){
-        int j = rand() % (i+1);
-        int temp = ids[i];
-        ids[i] = ids[j];
-        ids[j] = temp;
-    }
+/*
+Marca o início de uma operação: a thread anuncia a época em que entrou. Enquanto ela estiver
+ativa, nenhum nó removido a partir dessa época é liberado.
+*/
+static void entrar_epoca_skiplist(SkiplistConcorrente* lista, int thread){
+    EpocaThreadSkiplist* t = &lista->threads[thread];
+    t->epoca = lista->epoca;
+    InterlockedExchange(&t->ativa, 1);
+}
 
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    int j = 0;
-    for(j; j < total_ids; j++){
-        buscar_skiplist(lista, ids[j]);
+/*
+Marca o fim de uma operação: a partir daqui a thread não guarda mais ponteiros para nós.
+*/
+static void sair_epoca_skiplist(SkiplistConcorrente* lista, int thread){
+    InterlockedExchange(&lista->threads[thread].ativa, 0);
+}
+
+/*
+Avança a época global se todas as threads ativas já estão na época atual.
+Parâmetro: lista - ponteiro para a skip list concorrente
+*/
+static void tentar_avancar_epoca_skiplist(SkiplistConcorrente* lista){
+    long epoca = lista->epoca;
+    long n_threads = lista->n_threads;
+    int i = 0;
+    for (i; i < n_threads && i < MAX_THREADS_SKIPLIST; i++){
+        if (lista->threads[i].ativa && lista->threads[i].epoca != epoca){
+            return;
+        }
     }
-    
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
- 
-    free(ids);
-    libera_skiplist(lista);
-    
-    return tempo;
+    InterlockedCompareExchange(&lista->epoca, epoca + 1, epoca);
 }
 
 /*
-Mede o uso de memoria de n elementos do dataset na skip list.
+Coloca um nó já desligado da lista na fila de nós aposentados da thread. Um nó aposentado na
+época e só é liberado quando a época global chega a e + 2: nesse ponto toda thread que estava
+ativa quando ele foi desligado já terminou a sua operação. Deve ser chamada fora de
+entrar/sair_epoca.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: memória utilizada (bytes)
+    lista - ponteiro para a skip list concorrente
+    thread - índice da thread
+    no - nó a ser aposentado
 */
-size_t bench_uso_memoria_skiplist(const char* nome_arquivo, int n){
-    Skiplist* lista = iniciar_skiplist();
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        libera_skiplist(lista);
-        exit(EXIT_FAILURE);
+static void aposentar_skiplist(SkiplistConcorrente* lista, int thread, ElementoSkiplistConcorrente* no){
+    EpocaThreadSkiplist* t = &lista->threads[thread];
+    no->epoca_aposentado = lista->epoca;
+    no->aposentado_prox = t->aposentados;
+    t->aposentados = no;
+    t->n_aposentados++;
+
+    if (t->n_aposentados < LIMITE_APOSENTADOS_SKIPLIST){
+        return;
+    }
+
+    tentar_avancar_epoca_skiplist(lista);
+    long epoca = lista->epoca;
+    ElementoSkiplistConcorrente** ligacao = &t->aposentados;
+    while (*ligacao != NULL){
+        ElementoSkiplistConcorrente* atual = *ligacao;
+        if (atual->epoca_aposentado + 2 <= epoca){
+            *ligacao = atual->aposentado_prox;
+            liberar_memoria(MEMORIA_SKIPLIST, atual);
+            t->n_aposentados--;
+        }else{
+            ligacao = &atual->aposentado_prox;
+        }
     }
+}
 
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo); 
-
-    int elementos_carregados = 0;
-    while(elementos_carregados < n && fgets(linha, sizeof(linha), arquivo)){
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao,
-            &novo.area_plantada, &novo.valor_total);
-        
-        inserir_skiplist(lista, novo);
-        elementos_carregados++;
-    }
+/*
+Localiza, em cada nível, o último nó com ID menor que o procurado (preds) e o seguinte
+(succs). No caminho, desliga os nós marcados como removidos; se outra thread alterar a lista
+no meio da troca, a busca recomeça do início.
+Parâmetros:
+    lista - ponteiro para a skip list concorrente
+    id - identificador procurado
+    preds, succs - vetores de NIVEL_MAX_SKIPLIST posições preenchidos pela função
+Retorno: 1 se um nó não removido com o ID está na lista, 0 caso contrário
+*/
+static int localizar_skiplist_concorrente(SkiplistConcorrente* lista, int id, ElementoSkiplistConcorrente** preds, ElementoSkiplistConcorrente** succs){
+    ElementoSkiplistConcorrente *pred, *atual, *seguinte;
 
-    fclose(arquivo);
-    
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    int cont = 0;
-    while(atual != NULL){
-        cont++;
-        atual = atual->proximo[0];
+recomecar:
+    pred = lista->cabeca;
+    atual = NULL;
+    int i = NIVEL_MAX_SKIPLIST - 1;
+    for (i; i >= 0; i--){
+        atual = desmarcar_skiplist(pred->proximo[i]);
+        while (atual != NULL){
+            seguinte = atual->proximo[i];
+            while (marcado_skiplist(seguinte)){
+                if (!cas_skiplist(&pred->proximo[i], atual, desmarcar_skiplist(seguinte))){
+                    goto recomecar;
+                }
+                atual = desmarcar_skiplist(seguinte);
+                if (atual == NULL){
+                    break;
+                }
+                seguinte = atual->proximo[i];
+            }
+            if (atual == NULL || atual->id >= id){
+                break;
+            }
+            pred = atual;
+            atual = desmarcar_skiplist(seguinte);
+        }
+        preds[i] = pred;
+        succs[i] = atual;
     }
-
-    size_t uso_memoria = cont * sizeof(ElementoSkiplist);
-    libera_skiplist(lista);
-    
-    return uso_memoria;
+    return atual != NULL && atual->id == id;
 }
 
 /*
-Mede o tempo de inserção com memória restrita de n elementos do dataset na skip list.
+Insere um registro na skip list concorrente. O nó é publicado com um CAS no nível 0 (a partir
+daí ele está na lista) e depois ligado nos níveis superiores, refazendo a busca quando outra
+thread altera a vizinhança. Os IDs são únicos: se o ID já existe, nada é inserido.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  lim_memoria - limite de memória a ser utilizada
-Retorno: tempo gasto em segundos (double)
+    lista - ponteiro para a skip list concorrente
+    thread - índice da thread (registrar_thread_skiplist_concorrente)
+    registro - ponteiro para o registro a ser indexado
+Retorno: 1 se inserido, 0 se o ID já existia
 */
-double bench_insercao_mem_restrita_skiplist(const char* nome_arquivo, double lim_memoria_mb){
-    struct timespec inicio, fim;
-    size_t lim_bytes = (size_t)(lim_memoria_mb * 1024 * 1024);
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
-
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo); 
-
-    Skiplist* lista = iniciar_skiplist();
-    size_t memoria_usada = sizeof(Skiplist) + sizeof(ElementoSkiplist); 
-    int total = 0;
+int inserir_skiplist_concorrente(SkiplistConcorrente* lista, int thread, Registro* registro){
+    ElementoSkiplistConcorrente *preds[NIVEL_MAX_SKIPLIST], *succs[NIVEL_MAX_SKIPLIST];
+    int nivel = sortear_nivel_skiplist(lista->bits_probabilidade);
+    ElementoSkiplistConcorrente* novo = NULL;
+
+    entrar_epoca_skiplist(lista, thread);
+    while (1){
+        if (localizar_skiplist_concorrente(lista, registro->id, preds, succs)){
+            sair_epoca_skiplist(lista, thread);
+            liberar_memoria(MEMORIA_SKIPLIST, novo);
+            return 0;
+        }
 
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
+        if (novo == NULL){
+            novo = alocar_memoria(MEMORIA_SKIPLIST, tamanho_elemento_skiplist_concorrente(nivel));
+            if (!novo){
+                printf("Erro na alocação do novo nó\n");
+                exit(EXIT_FAILURE);
+            }
+            novo->id = registro->id;
+            novo->nivel = nivel;
+            novo->registro = registro;
+            novo->aposentado_prox = NULL;
+            novo->epoca_aposentado = 0;
+        }
+        int i = 0;
+        for (i; i < nivel; i++){
+            novo->proximo[i] = succs[i];
+        }
 
-    while(fgets(linha, sizeof(linha), arquivo)){
-        if(memoria_usada + sizeof(ElementoSkiplist) > lim_bytes){
-            printf("Limite de memoria atingido apos %d elementos\n", total);
+        if (cas_skiplist(&preds[0]->proximo[0], succs[0], novo)){
             break;
         }
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton, &novo.rendimento, &novo.producao, 
-            &novo.area_plantada, &novo.valor_total);
+    }
 
-        inserir_skiplist(lista, novo);
-        memoria_usada += sizeof(ElementoSkiplist);
-        total++;
+    int i = 1;
+    for (i; i < nivel; i++){
+        while (1){
+            ElementoSkiplistConcorrente* seguinte = novo->proximo[i];
+            if (marcado_skiplist(seguinte)){
+                i = nivel;
+                break;
+            }
+            if (seguinte != succs[i] && !cas_skiplist(&novo->proximo[i], seguinte, succs[i])){
+                continue;
+            }
+            if (cas_skiplist(&preds[i]->proximo[i], succs[i], novo)){
+                break;
+            }
+            localizar_skiplist_concorrente(lista, registro->id, preds, succs);
+        }
     }
 
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    /* Se o nó foi removido enquanto era ligado nos níveis superiores, uma ligação feita
+       depois da remoção pode ter ficado para trás; a busca a desfaz antes de sair. */
+    if (marcado_skiplist(novo->proximo[0])){
+        localizar_skiplist_concorrente(lista, registro->id, preds, succs);
+    }
 
-    libera_skiplist(lista);
-    fclose(arquivo);
-    return tempo;
+    sair_epoca_skiplist(lista, thread);
+    return 1;
 }
 
 /*
-Mede o tempo de inserção com delay de n elementos do dataset na skip list.
+Busca um ID na skip list concorrente sem alterar a lista, pulando os nós marcados.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  delay_ms - tempo em milisegundos a ser aplicado como delay
-Retorno: tempo gasto em segundos (double)
-*/
-double bench_insercao_com_delay_skiplist(const char* nome_arquivo, int n, int delay_ms){
-    Skiplist* lista = iniciar_skiplist();
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
-    }
+    lista - ponteiro para a skip list concorrente
+    thread - índice da thread (registrar_thread_skiplist_concorrente)
+    id - identificador a ser buscado
+Retorno: ponteiro para o registro encontrado ou NULL
+*/
+Registro* buscar_skiplist_concorrente(SkiplistConcorrente* lista, int thread, int id){
+    entrar_epoca_skiplist(lista, thread);
 
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
+    ElementoSkiplistConcorrente* pred = lista->cabeca;
+    ElementoSkiplistConcorrente* atual = NULL;
+    int i = NIVEL_MAX_SKIPLIST - 1;
+    for (i; i >= 0; i--){
+        atual = desmarcar_skiplist(pred->proximo[i]);
+        while (atual != NULL){
+            ElementoSkiplistConcorrente* seguinte = atual->proximo[i];
+            if (marcado_skiplist(seguinte)){
+                atual = desmarcar_skiplist(seguinte);
+            }else if (atual->id < id){
+                pred = atual;
+                atual = seguinte;
+            }else{
+                break;
+            }
+        }
+    }
 
-    int total = 0;
+    Registro* encontrado = NULL;
+    if (atual != NULL && atual->id == id && !marcado_skiplist(atual->proximo[0])){
+        encontrado = atual->registro;
+    }
 
-    struct timespec inicio, fim;
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    sair_epoca_skiplist(lista, thread);
+    return encontrado;
+}
 
-    while(fgets(linha, sizeof(linha), arquivo) && total < n){
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-            &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-            &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
+/*
+Remove um ID da skip list concorrente. Os níveis do nó são marcados de cima para baixo; a
+thread que consegue marcar o nível 0 é a dona da remoção, desliga o nó com uma nova busca e o
+aposenta para ser liberado quando nenhuma outra thread puder mais alcançá-lo.
+Parâmetros:
+    lista - ponteiro para a skip list concorrente
+    thread - índice da thread (registrar_thread_skiplist_concorrente)
+    id - identificador do elemento a ser removido
+Retorno: 1 se removido, 0 se não encontrado
+*/
+int remover_skiplist_concorrente(SkiplistConcorrente* lista, int thread, int id){
+    ElementoSkiplistConcorrente *preds[NIVEL_MAX_SKIPLIST], *succs[NIVEL_MAX_SKIPLIST];
 
-        inserir_skiplist(lista, novo);
-        printf("inserido");
-        Sleep(delay_ms);
-        total++;
+    entrar_epoca_skiplist(lista, thread);
+    if (!localizar_skiplist_concorrente(lista, id, preds, succs)){
+        sair_epoca_skiplist(lista, thread);
+        return 0;
     }
 
-    clock_gettime(CLOCK_MONOTONIC, &fim);
+    ElementoSkiplistConcorrente* alvo = succs[0];
+    int i = alvo->nivel - 1;
+    for (i; i >= 1; i--){
+        ElementoSkiplistConcorrente* seguinte = alvo->proximo[i];
+        while (!marcado_skiplist(seguinte)){
+            cas_skiplist(&alvo->proximo[i], seguinte, marcar_skiplist(seguinte));
+            seguinte = alvo->proximo[i];
+        }
+    }
 
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    while (1){
+        ElementoSkiplistConcorrente* seguinte = alvo->proximo[0];
+        if (marcado_skiplist(seguinte)){
+            sair_epoca_skiplist(lista, thread);
+            return 0;
+        }
+        if (cas_skiplist(&alvo->proximo[0], seguinte, marcar_skiplist(seguinte))){
+            break;
+        }
+    }
 
-    libera_skiplist(lista);
-    fclose(arquivo);
+    localizar_skiplist_concorrente(lista, id, preds, succs);
+    sair_epoca_skiplist(lista, thread);
 
-    return tempo;
+    aposentar_skiplist(lista, thread, alvo);
+    return 1;
 }
 
 /*
-Mede o tempo de busca com latência de n elementos do dataset na skip list.
-Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-Retorno: tempo gasto em segundos (double)
+Libera toda a memória da skip list concorrente, inclusive os nós aposentados. Só pode ser
+chamada quando nenhuma thread estiver mais usando a lista.
+Parâmetro: lista - ponteiro para a skip list concorrente
 */
-double bench_busca_latencia_skiplist(const char* nome_arquivo, int n){
-    struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    carregar_dados_skiplist(lista, nome_arquivo);
-
-    int* ids = malloc(n * sizeof(int));
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    int total_ids = 0;
-    while(atual != NULL && total_ids < n){
-        ids[total_ids++] = atual->id;
-        atual = atual->proximo[0];
+void libera_skiplist_concorrente(SkiplistConcorrente* lista){
+    ElementoSkiplistConcorrente* atual = desmarcar_skiplist(lista->cabeca->proximo[0]);
+    while (atual != NULL){
+        ElementoSkiplistConcorrente* proximo = desmarcar_skiplist(atual->proximo[0]);
+        liberar_memoria(MEMORIA_SKIPLIST, atual);
+        atual = proximo;
     }
 
-    if(total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids);
-        libera_skiplist(lista);
-        return 0;
+    int i = 0;
+    for (i; i < MAX_THREADS_SKIPLIST; i++){
+        atual = lista->threads[i].aposentados;
+        while (atual != NULL){
+            ElementoSkiplistConcorrente* proximo = atual->aposentado_prox;
+            liberar_memoria(MEMORIA_SKIPLIST, atual);
+            atual = proximo;
+        }
     }
 
-    srand((unsigned int)time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    liberar_memoria(MEMORIA_SKIPLIST, lista->cabeca);
+    liberar_memoria(MEMORIA_SKIPLIST, lista);
+}
 
-    int j = 0;
-    for(j; j < n; j++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids[idx];
-        buscar_skiplist(lista, id_buscado);
+/* Parâmetros de cada thread do benchmark de vazão da skip list concorrente */
+typedef struct{
+    SkiplistConcorrente* lista;
+    Dataset* ds;
+    int inicio;
+    int fim;
+    int n;
+    volatile long* parar;
+    unsigned long long semente;
+    long long operacoes;
+} TarefaSkiplistConcorrente;
 
-        int delay = 2 + rand() % 8;
-        Sleep(delay);
+/*
+Thread leitora: faz n buscas de IDs sorteados entre os registros carregados. O sorteio usa a
+semente da tarefa, então a mesma semente repete a mesma sequência de buscas.
+Parâmetro: arg - ponteiro para a TarefaSkiplistConcorrente
+Retorno: 0
+*/
+static DWORD WINAPI ler_skiplist_concorrente(LPVOID arg){
+    TarefaSkiplistConcorrente* tarefa = (TarefaSkiplistConcorrente*)arg;
+    semear_aleatorio_skiplist(tarefa->semente);
+    int thread = registrar_thread_skiplist_concorrente(tarefa->lista);
+    int faixa = tarefa->fim - tarefa->inicio;
+    int i = 0;
+    for (i; i < tarefa->n; i++){
+        int posicao = tarefa->inicio + (int)(aleatorio_skiplist() % (unsigned long long)faixa);
+        buscar_skiplist_concorrente(tarefa->lista, thread, tarefa->ds->itens[posicao].id);
     }
+    tarefa->operacoes = tarefa->n;
+    return 0;
+}
 
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    free(ids);
-    libera_skiplist(lista);
-
-    return tempo;
+/*
+Thread escritora: insere e remove repetidamente os registros do intervalo até ser avisada
+para parar.
+Parâmetro: arg - ponteiro para a TarefaSkiplistConcorrente
+Retorno: 0
+*/
+static DWORD WINAPI escrever_skiplist_concorrente(LPVOID arg){
+    TarefaSkiplistConcorrente* tarefa = (TarefaSkiplistConcorrente*)arg;
+    semear_aleatorio_skiplist(tarefa->semente);
+    int thread = registrar_thread_skiplist_concorrente(tarefa->lista);
+    long long operacoes = 0;
+    while (!*tarefa->parar){
+        int i = tarefa->inicio;
+        for (i; i < tarefa->fim && !*tarefa->parar; i++){
+            inserir_skiplist_concorrente(tarefa->lista, thread, &tarefa->ds->itens[i]);
+            operacoes++;
+        }
+        for (i = tarefa->inicio; i < tarefa->fim && !*tarefa->parar; i++){
+            remover_skiplist_concorrente(tarefa->lista, thread, tarefa->ds->itens[i].id);
+            operacoes++;
+        }
+    }
+    tarefa->operacoes = operacoes;
+    return 0;
 }
 
 /*
-Mede o tempo de isnerção de n elementos do dataset, com perda, na skip list.
+Mede a vazão de buscas na skip list concorrente com várias threads leitoras, enquanto uma
+thread escritora insere e remove registros ao mesmo tempo. A primeira metade dos registros é
+carregada antes da medição e é a que as leitoras buscam; a segunda metade é a que a escritora
+insere e remove.
+Cada thread sorteia os IDs buscados e os níveis dos nós inseridos a partir de semente mais o
+seu índice (a escritora usa o índice n_threads e a carga inicial, n_threads + 1), de modo que
+a mesma semente repete os mesmos sorteios.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem inseridos
-Retorno: tempo gasto em segundos (double)
+    nome_arquivo - nome do arquivo de entrada
+    n - número de buscas feitas por cada thread leitora
+    n_threads - número de threads leitoras
+    semente - semente dos sorteios
+    vazao_escritora - recebe as inserções/remoções por segundo da escritora (pode ser NULL)
+Retorno: buscas por segundo (double)
 */
-double bench_temp_insercao_perda_skiplist(const char* nome_arquivo, int n){
+double bench_vazao_busca_skiplist_concorrente(const char* nome_arquivo, int n, int n_threads, unsigned int semente, double *vazao_escritora){
     struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    FILE* arquivo = fopen(nome_arquivo, "r");
-    
-    if(!arquivo){
-        printf("Erro ao abrir arquivo");
-        libera_skiplist(lista);
-        exit(EXIT_FAILURE);
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    if (ds.total < 2){
+        liberar_dataset(&ds);
+        return 0;
     }
 
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
+    if (n_threads < 1){
+        n_threads = 1;
+    }
+    if (n_threads > MAX_THREADS_SKIPLIST - 2){
+        n_threads = MAX_THREADS_SKIPLIST - 2;
+    }
+
+    SkiplistConcorrente* lista = iniciar_skiplist_concorrente();
+    semear_aleatorio_skiplist((unsigned long long)semente + n_threads + 1);
+    int thread = registrar_thread_skiplist_concorrente(lista);
+    int metade = ds.total / 2;
+    int i = 0;
+    for (i; i < metade; i++){
+        inserir_skiplist_concorrente(lista, thread, &ds.itens[i]);
+    }
+
+    volatile long parar = 0;
+    TarefaSkiplistConcorrente* tarefas = alocar_memoria(MEMORIA_SKIPLIST, (n_threads + 1) * sizeof(TarefaSkiplistConcorrente));
+    HANDLE* threads = alocar_memoria(MEMORIA_SKIPLIST, (n_threads + 1) * sizeof(HANDLE));
+    if (!tarefas || !threads){
+        printf("Erro ao alocar memória para as threads do benchmark\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i <= n_threads; i++){
+        tarefas[i].lista = lista;
+        tarefas[i].ds = &ds;
+        tarefas[i].inicio = i < n_threads ? 0 : metade;
+        tarefas[i].fim = i < n_threads ? metade : ds.total;
+        tarefas[i].n = n;
+        tarefas[i].parar = &parar;
+        tarefas[i].semente = (unsigned long long)semente + i;
+        tarefas[i].operacoes = 0;
+    }
 
-    int total_inseridos = 0;
-    srand((unsigned int)time(NULL));
-    
     clock_gettime(CLOCK_MONOTONIC, &inicio);
-    
-    while(fgets(linha, sizeof(linha), arquivo) && total_inseridos < n){
-        if((rand() % 100) < 20){ 
-            continue;
+
+    threads[n_threads] = CreateThread(NULL, 0, escrever_skiplist_concorrente, &tarefas[n_threads], 0, NULL);
+    for (i = 0; i < n_threads; i++){
+        threads[i] = CreateThread(NULL, 0, ler_skiplist_concorrente, &tarefas[i], 0, NULL);
+    }
+    for (i = 0; i <= n_threads; i++){
+        if (threads[i] == NULL){
+            printf("Erro ao criar thread do benchmark\n");
+            exit(EXIT_FAILURE);
         }
-        ElementoSkiplist novo;
-        sscanf(linha, "%d;%d;%9[^;];%49[^;];%f;%f;%f;%f;%f",
-               &novo.id, &novo.ano, novo.estado, novo.cultura, &novo.preco_ton,
-               &novo.rendimento, &novo.producao, &novo.area_plantada, &novo.valor_total);
-        
-        inserir_skiplist(lista, novo);
-        total_inseridos++;
     }
-    
+    WaitForMultipleObjects(n_threads, threads, TRUE, INFINITE);
+
     clock_gettime(CLOCK_MONOTONIC, &fim);
 
+    InterlockedExchange(&parar, 1);
+    WaitForSingleObject(threads[n_threads], INFINITE);
+    for (i = 0; i <= n_threads; i++){
+        CloseHandle(threads[i]);
+    }
+
     double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    long long buscas = 0;
+    for (i = 0; i < n_threads; i++){
+        buscas += tarefas[i].operacoes;
+    }
+    if (vazao_escritora != NULL){
+        *vazao_escritora = tempo > 0 ? tarefas[n_threads].operacoes / tempo : 0;
+    }
 
-    fclose(arquivo);
-    libera_skiplist(lista);
-    
-    return tempo;
+    liberar_memoria(MEMORIA_SKIPLIST, tarefas);
+    liberar_memoria(MEMORIA_SKIPLIST, threads);
+    libera_skiplist_concorrente(lista);
+    liberar_dataset(&ds);
+
+    return tempo > 0 ? buscas / tempo : 0;
 }
 
 /*
-Mede o tempo de busca de n elementos do dataset na skip list.
+Busca um ID fazendo no máximo lim acessos. Cada avanço em um nível e cada descida de nível
+contam como um acesso.
 Parâmetros:
-  nome_arquivo - nome do arquivo de entrada (dataset)
-  n - número de elementos a serem buscados
-  lim - limite de acessos
-Retorno: tempo gasto em segundos (double)
+    lista - ponteiro para a skiplist
+    id - identificador a ser buscado
+    lim - número máximo de acessos
+Retorno: ponteiro para o elemento encontrado ou NULL se o limite acabar antes
 */
-double bench_busca_lim_acessos_skiplist(const char* nome_arquivo, int n, int lim){
-    struct timespec inicio, fim;
-    Skiplist* lista = iniciar_skiplist();
-    carregar_dados_skiplist(lista, nome_arquivo);
-
-    int* ids = malloc(n * sizeof(int));
-    ElementoSkiplist* atual = lista->cabeca->proximo[0];
-    int total_ids = 0;
-    while(atual != NULL && total_ids < n){
-        ids[total_ids++] = atual->id;
-        atual = atual->proximo[0];
-    }
-
-    if(total_ids == 0){
-        printf("Nenhum ID carregado!\n");
-        free(ids);
-        libera_skiplist(lista);
-        return 0;
-    }
-
-    srand((unsigned int)time(NULL));
-    clock_gettime(CLOCK_MONOTONIC, &inicio);
+ElementoSkiplist* buscar_lim_acessos_skiplist(Skiplist* lista, int id, int lim){
+    ElementoSkiplist* atual = lista->cabeca;
+    int acessos = 0;
 
-    int j = 0;
-    for(j; j < n; j++){
-        int idx = rand() % total_ids;
-        int id_buscado = ids[idx];
-
-        ElementoSkiplist* ptr = lista->cabeca;
-        int acessos = 0;
-        int nivel = lista->nivel;
-        while(nivel >= 0 && acessos < lim){
-            while(ptr->proximo[nivel] != NULL && ptr->proximo[nivel]->id < id_buscado && acessos < lim){
-                ptr = ptr->proximo[nivel];
-                acessos++;
-            }
-            nivel--;
+    int i = lista->nivel;
+    for (i; i >= 0 && acessos < lim; i--){
+        while (atual->proximo[i] != NULL && atual->proximo[i]->id < id && acessos < lim){
+            atual = atual->proximo[i];
             acessos++;
         }
-        if(ptr->proximo[0] != NULL && ptr->proximo[0]->id == id_buscado){
-        }
+        acessos++;
     }
 
-    clock_gettime(CLOCK_MONOTONIC, &fim);
-
-    double tempo = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
-    free(ids);
-    libera_skiplist(lista);
-
-    return tempo;
+    if (i < 0 && atual->proximo[0] != NULL && atual->proximo[0]->id == id){
+        return atual->proximo[0];
+    }
+    return NULL;
 }
@@ -1,46 +1,77 @@
 #ifndef SKIPLIST_H
 #define SKIPLIST_H
 
-#define  NIVEL_MAX_SKIPLIST 16
+#include "dataset.h"
+#include "registros.h"
+#include "indice_bitmap.h"
+
+#define  NIVEL_MAX_SKIPLIST 32
+#define BITS_PROBABILIDADE_SKIPLIST 1
 
 typedef struct ElementoSkiplist {
     int id;
-    int ano;
-    char estado[10];
-    char cultura[50];
-    float preco_ton;
-    float rendimento;
-    float producao;
-    float area_plantada;
-    float valor_total;
-    struct ElementoSkiplist* proximo[NIVEL_MAX_SKIPLIST];
+    int nivel;
+    Registro* registro;
+    struct ElementoSkiplist* proximo[];
 } ElementoSkiplist;
 
 typedef struct {
     ElementoSkiplist* cabeca;
     int nivel;
+    int bits_probabilidade;
 } Skiplist;
 
+#define MAX_THREADS_SKIPLIST 64
+#define LIMITE_APOSENTADOS_SKIPLIST 64
+
+typedef struct ElementoSkiplistConcorrente {
+    int id;
+    int nivel;
+    Registro* registro;
+    struct ElementoSkiplistConcorrente* aposentado_prox;
+    long epoca_aposentado;
+    struct ElementoSkiplistConcorrente* volatile proximo[];
+} ElementoSkiplistConcorrente;
+
+typedef struct {
+    volatile long ativa;
+    volatile long epoca;
+    ElementoSkiplistConcorrente* aposentados;
+    int n_aposentados;
+    char preenchimento[64];
+} EpocaThreadSkiplist;
+
+typedef struct {
+    ElementoSkiplistConcorrente* cabeca;
+    int bits_probabilidade;
+    volatile long epoca;
+    volatile long n_threads;
+    EpocaThreadSkiplist threads[MAX_THREADS_SKIPLIST];
+} SkiplistConcorrente;
+
 Skiplist* iniciar_skiplist();
-int nivel_aleatorio_skiplists();
-void inserir_skiplist(Skiplist *lista, ElementoSkiplist novo_dado);
+void definir_probabilidade_skiplist(Skiplist *lista, double p);
+size_t tamanho_elemento_skiplist(int nivel);
+unsigned long long aleatorio_skiplist();
+void semear_aleatorio_skiplist(unsigned long long semente);
+int nivel_aleatorio_skiplist(const Skiplist *lista);
+ElementoSkiplist* inserir_skiplist(Skiplist *lista, Registro *registro);
 ElementoSkiplist* buscar_skiplist(Skiplist* lista, int id);
 int remover_skiplist(Skiplist *lista, int id);
 void imprime_skiplist(Skiplist* lista);
 void libera_skiplist(Skiplist* lista);
-void carregar_dados_skiplist(Skiplist* lista, const char* nome_arquivo);
-void salvar_dados_skiplist(Skiplist* lista, const char* nome_arquivo);
+void carregar_dados_skiplist(Skiplist* lista, ArmazemRegistros* armazem, const char* nome_arquivo);
+void carregar_registros_skiplist(Skiplist* lista, Dataset* ds);
 int criar_id_skiplist(Skiplist* lista);
-void criar_amostra_skiplist(Skiplist* lista);
-void buscarFiltros_skiplist(Skiplist* lista, int ano_min, int ano_max, const char* estado, const char* cultura);
-double bench_temp_insercao_skiplist(const char* novo_arquivo, int n);
-double bench_temp_remocao_skiplist(const char* arquivo, int n);
-double bench_temp_busca_skiplist(const char* arquivo, int n);
-size_t bench_uso_memoria_skiplist(const char* nome_arquivo, int n);
-double bench_insercao_mem_restrita_skiplist(const char* nome_arquivo, double lim_memoria_mb);
-double bench_insercao_com_delay_skiplist(const char* nome_arquivo, int n, int delay_ms);
-double bench_busca_latencia_skiplist(const char* nome_arquivo, int n);
-double bench_temp_insercao_perda_skiplist(const char* nome_arquivo, int n);
-double bench_busca_lim_acessos_skiplist(const char* nome_arquivo, int n, int lim);
+void criar_amostra_skiplist(Skiplist* lista, ArmazemRegistros* armazem);
+void buscarFiltros_skiplist(Skiplist* lista, int ano_min, int ano_max, const char* estado, const char* cultura, const IndiceBitmap *indice);
+SkiplistConcorrente* iniciar_skiplist_concorrente();
+int registrar_thread_skiplist_concorrente(SkiplistConcorrente* lista);
+int inserir_skiplist_concorrente(SkiplistConcorrente* lista, int thread, Registro* registro);
+Registro* buscar_skiplist_concorrente(SkiplistConcorrente* lista, int thread, int id);
+int remover_skiplist_concorrente(SkiplistConcorrente* lista, int thread, int id);
+void libera_skiplist_concorrente(SkiplistConcorrente* lista);
+ElementoSkiplist* buscar_lim_acessos_skiplist(Skiplist* lista, int id, int lim);
+double bench_vazao_busca_skiplist_concorrente(const char* nome_arquivo, int n, int n_threads, unsigned int semente, double *vazao_escritora);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,285 @@
+/*
+->snapshot.c
+Implementação do snapshot binário do dataset de amostras agrícolas.
+O snapshot guarda o dataset já validado em um formato compacto: um cabeçalho com o número de
+registros, a versão do formato e os dicionários de estados e culturas, seguido de registros
+de tamanho fixo que referenciam os dicionários por código. Ele é carregado com um único
+mapeamento do arquivo, evitando interpretar o texto do CSV a cada inicialização, e é
+descartado (recriado a partir do CSV) quando o CSV for alterado por fora do programa.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <windows.h>
+#include "snapshot.h"
+#include "memoria.h"
+
+/*
+Monta o nome do arquivo de snapshot correspondente ao dataset (ex: Dados.csv.snap).
+Parâmetros:
+    nome_arquivo - nome do arquivo do dataset
+    destino - vetor que recebe o nome do snapshot
+    tamanho - tamanho do vetor de destino
+*/
+void nome_snapshot(const char *nome_arquivo, char *destino, int tamanho){
+    snprintf(destino, tamanho, "%s%s", nome_arquivo, EXTENSAO_SNAPSHOT);
+}
+
+/*
+Obtém o tamanho e a data de modificação do CSV, usados para detectar um snapshot desatualizado.
+Parâmetros:
+    nome_arquivo - nome do arquivo do dataset
+    tamanho - ponteiro que recebe o tamanho em bytes
+    modificacao - ponteiro que recebe a data da última modificação
+Retorno: 1 em caso de sucesso, 0 se o arquivo não existir
+*/
+static int estado_csv(const char *nome_arquivo, long long *tamanho, long long *modificacao){
+    struct stat st;
+    if(stat(nome_arquivo, &st) != 0){
+        return 0;
+    }
+    *tamanho = (long long)st.st_size;
+    *modificacao = (long long)st.st_mtime;
+    return 1;
+}
+
+/*
+Retorna o código de um texto no dicionário, acrescentando-o se ainda não existir.
+Parâmetros:
+    dicionario - vetor de textos com largura fixa
+    largura - largura de cada entrada do dicionário
+    total - ponteiro para a quantidade de entradas
+    texto - texto a ser procurado
+Retorno: código do texto, ou -1 se o dicionário estiver cheio
+*/
+static int codigo_dicionario(char *dicionario, int largura, int *total, const char *texto){
+    int i = 0;
+    for(i; i < *total; i++){
+        if(strcmp(dicionario + (size_t)i * largura, texto) == 0){
+            return i;
+        }
+    }
+
+    if(*total >= MAX_DICIONARIO_SNAPSHOT){
+        return -1;
+    }
+    strncpy(dicionario + (size_t)*total * largura, texto, largura - 1);
+    (*total)++;
+    return *total - 1;
+}
+
+/*
+Grava o snapshot binário de um dataset, registrando o tamanho e a data do CSV correspondente.
+Deve ser chamada depois que o CSV foi gravado, para que o snapshot não seja considerado desatualizado.
+Parâmetros:
+    ds - ponteiro para o dataset
+    nome_arquivo - nome do arquivo do dataset (CSV)
+Retorno: 1 se o snapshot foi gravado, 0 caso contrário
+*/
+int salvar_snapshot(const Dataset *ds, const char *nome_arquivo){
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.assinatura, "SNAP", 4);
+    cabecalho.versao = VERSAO_SNAPSHOT;
+    cabecalho.total = ds->total;
+    cabecalho.tamanho_registro = sizeof(RegistroSnapshot);
+
+    if(!estado_csv(nome_arquivo, &cabecalho.tamanho_csv, &cabecalho.modificacao_csv)){
+        return 0;
+    }
+
+    int capacidade = ds->total < MAX_DICIONARIO_SNAPSHOT ? ds->total + 1 : MAX_DICIONARIO_SNAPSHOT;
+    char *estados = (char*)alocar_zerada_memoria(MEMORIA_SNAPSHOT, capacidade, TAM_ESTADO);
+    char *culturas = (char*)alocar_zerada_memoria(MEMORIA_SNAPSHOT, capacidade, TAM_CULTURA);
+    RegistroSnapshot *registros = (RegistroSnapshot*)alocar_zerada_memoria(MEMORIA_SNAPSHOT, ds->total + 1, sizeof(RegistroSnapshot));
+    /* Código de cada texto dos dicionários globais no snapshot (-1 = ainda não gravado) */
+    int *mapa_estados = (int*)alocar_memoria(MEMORIA_SNAPSHOT, MAX_CODIGOS_DICIONARIO * sizeof(int));
+    int *mapa_culturas = (int*)alocar_memoria(MEMORIA_SNAPSHOT, MAX_CODIGOS_DICIONARIO * sizeof(int));
+    if(!estados || !culturas || !registros || !mapa_estados || !mapa_culturas){
+        liberar_memoria(MEMORIA_SNAPSHOT, estados);
+        liberar_memoria(MEMORIA_SNAPSHOT, culturas);
+        liberar_memoria(MEMORIA_SNAPSHOT, registros);
+        liberar_memoria(MEMORIA_SNAPSHOT, mapa_estados);
+        liberar_memoria(MEMORIA_SNAPSHOT, mapa_culturas);
+        return 0;
+    }
+    memset(mapa_estados, -1, MAX_CODIGOS_DICIONARIO * sizeof(int));
+    memset(mapa_culturas, -1, MAX_CODIGOS_DICIONARIO * sizeof(int));
+
+    int i = 0;
+    for(i; i < ds->total; i++){
+        const Registro *r = &ds->itens[i];
+        if(mapa_estados[r->estado] < 0){
+            mapa_estados[r->estado] = codigo_dicionario(estados, TAM_ESTADO, &cabecalho.n_estados, nome_estado(r->estado));
+        }
+        if(mapa_culturas[r->cultura] < 0){
+            mapa_culturas[r->cultura] = codigo_dicionario(culturas, TAM_CULTURA, &cabecalho.n_culturas, nome_cultura(r->cultura));
+        }
+        int estado = mapa_estados[r->estado];
+        int cultura = mapa_culturas[r->cultura];
+        if(estado < 0 || cultura < 0){
+            liberar_memoria(MEMORIA_SNAPSHOT, estados);
+            liberar_memoria(MEMORIA_SNAPSHOT, culturas);
+            liberar_memoria(MEMORIA_SNAPSHOT, registros);
+            liberar_memoria(MEMORIA_SNAPSHOT, mapa_estados);
+            liberar_memoria(MEMORIA_SNAPSHOT, mapa_culturas);
+            return 0;
+        }
+
+        registros[i].id = r->id;
+        registros[i].ano = r->ano;
+        registros[i].estado = (unsigned short)estado;
+        registros[i].cultura = (unsigned short)cultura;
+        registros[i].preco_ton = r->preco_ton;
+        registros[i].rendimento = r->rendimento;
+        registros[i].producao = r->producao;
+        registros[i].area_plantada = r->area_plantada;
+        registros[i].valor_total = r->valor_total;
+    }
+
+    char nome[300];
+    nome_snapshot(nome_arquivo, nome, sizeof(nome));
+    FILE *arquivo = fopen(nome, "wb");
+    int sucesso = 0;
+    if(arquivo){
+        sucesso = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1
+               && fwrite(estados, TAM_ESTADO, cabecalho.n_estados, arquivo) == (size_t)cabecalho.n_estados
+               && fwrite(culturas, TAM_CULTURA, cabecalho.n_culturas, arquivo) == (size_t)cabecalho.n_culturas
+               && fwrite(registros, sizeof(RegistroSnapshot), ds->total, arquivo) == (size_t)ds->total;
+        if(fclose(arquivo) != 0){
+            sucesso = 0;
+        }
+        if(!sucesso){
+            remove(nome);
+        }
+    }
+
+    liberar_memoria(MEMORIA_SNAPSHOT, estados);
+    liberar_memoria(MEMORIA_SNAPSHOT, culturas);
+    liberar_memoria(MEMORIA_SNAPSHOT, registros);
+    liberar_memoria(MEMORIA_SNAPSHOT, mapa_estados);
+    liberar_memoria(MEMORIA_SNAPSHOT, mapa_culturas);
+    return sucesso;
+}
+
+/*
+Carrega o dataset a partir do snapshot binário com um único mapeamento do arquivo.
+O snapshot é recusado se não existir, for de outra versão, estiver incompleto ou se o CSV
+tiver sido modificado depois que ele foi gravado.
+Parâmetros:
+    ds - ponteiro para o dataset (deve estar inicializado)
+    nome_arquivo - nome do arquivo do dataset (CSV)
+Retorno: 1 se o dataset foi carregado do snapshot, 0 caso contrário
+*/
+int carregar_snapshot(Dataset *ds, const char *nome_arquivo){
+    long long tamanho_csv, modificacao_csv;
+    if(!estado_csv(nome_arquivo, &tamanho_csv, &modificacao_csv)){
+        return 0;
+    }
+
+    char nome[300];
+    nome_snapshot(nome_arquivo, nome, sizeof(nome));
+    ArquivoMapeado am;
+    if(!mapear_arquivo(&am, nome)){
+        return 0;
+    }
+
+    const CabecalhoSnapshot *cabecalho = (const CabecalhoSnapshot*)am.dados;
+    if(am.tamanho < sizeof(CabecalhoSnapshot)
+       || memcmp(cabecalho->assinatura, "SNAP", 4) != 0
+       || cabecalho->versao != VERSAO_SNAPSHOT
+       || cabecalho->tamanho_registro != sizeof(RegistroSnapshot)
+       || cabecalho->tamanho_csv != tamanho_csv
+       || cabecalho->modificacao_csv != modificacao_csv
+       || cabecalho->total < 0 || cabecalho->n_estados < 0 || cabecalho->n_culturas < 0){
+        desmapear_arquivo(&am);
+        return 0;
+    }
+
+    size_t esperado = sizeof(CabecalhoSnapshot)
+                    + (size_t)cabecalho->n_estados * TAM_ESTADO
+                    + (size_t)cabecalho->n_culturas * TAM_CULTURA
+                    + (size_t)cabecalho->total * sizeof(RegistroSnapshot);
+    if(am.tamanho != esperado){
+        desmapear_arquivo(&am);
+        return 0;
+    }
+
+    const char *estados = am.dados + sizeof(CabecalhoSnapshot);
+    const char *culturas = estados + (size_t)cabecalho->n_estados * TAM_ESTADO;
+    const RegistroSnapshot *registros = (const RegistroSnapshot*)(culturas + (size_t)cabecalho->n_culturas * TAM_CULTURA);
+
+    Registro *itens = (Registro*)alocar_memoria(MEMORIA_DATASET, (cabecalho->total > 0 ? cabecalho->total : 1) * sizeof(Registro));
+    unsigned short *codigos_estados = (unsigned short*)alocar_memoria(MEMORIA_SNAPSHOT, (cabecalho->n_estados + 1) * sizeof(unsigned short));
+    unsigned short *codigos_culturas = (unsigned short*)alocar_memoria(MEMORIA_SNAPSHOT, (cabecalho->n_culturas + 1) * sizeof(unsigned short));
+    if(!itens || !codigos_estados || !codigos_culturas){
+        printf("Erro ao alocar memoria para o dataset\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Os textos do snapshot são internados uma vez; os registros só traduzem os códigos */
+    char texto[TAM_CULTURA];
+    int j = 0;
+    for(j; j < cabecalho->n_estados; j++){
+        memcpy(texto, estados + (size_t)j * TAM_ESTADO, TAM_ESTADO);
+        texto[TAM_ESTADO - 1] = '\0';
+        codigos_estados[j] = (unsigned short)codigo_estado(texto);
+    }
+    for(j = 0; j < cabecalho->n_culturas; j++){
+        memcpy(texto, culturas + (size_t)j * TAM_CULTURA, TAM_CULTURA);
+        texto[TAM_CULTURA - 1] = '\0';
+        codigos_culturas[j] = (unsigned short)codigo_cultura(texto);
+    }
+
+    int i = 0;
+    for(i; i < cabecalho->total; i++){
+        RegistroSnapshot rs;
+        memcpy(&rs, &registros[i], sizeof(rs));
+        if(rs.estado >= cabecalho->n_estados || rs.cultura >= cabecalho->n_culturas){
+            liberar_memoria(MEMORIA_DATASET, itens);
+            liberar_memoria(MEMORIA_SNAPSHOT, codigos_estados);
+            liberar_memoria(MEMORIA_SNAPSHOT, codigos_culturas);
+            desmapear_arquivo(&am);
+            return 0;
+        }
+
+        Registro *r = &itens[i];
+        r->id = rs.id;
+        r->ano = rs.ano;
+        r->estado = codigos_estados[rs.estado];
+        r->cultura = codigos_culturas[rs.cultura];
+        r->preco_ton = rs.preco_ton;
+        r->rendimento = rs.rendimento;
+        r->producao = rs.producao;
+        r->area_plantada = rs.area_plantada;
+        r->valor_total = rs.valor_total;
+    }
+
+    liberar_dataset(ds);
+    ds->itens = itens;
+    ds->total = cabecalho->total;
+    ds->capacidade = cabecalho->total > 0 ? cabecalho->total : 1;
+
+    liberar_memoria(MEMORIA_SNAPSHOT, codigos_estados);
+    liberar_memoria(MEMORIA_SNAPSHOT, codigos_culturas);
+    desmapear_arquivo(&am);
+    return 1;
+}
+
+/*
+Carrega o dataset na inicialização: usa o snapshot binário quando ele existe e está em dia
+com o CSV; caso contrário interpreta o CSV e grava um novo snapshot.
+Parâmetros:
+    ds - ponteiro para o dataset (deve estar inicializado)
+    nome_arquivo - nome do arquivo do dataset (CSV)
+*/
+void carregar_dataset_inicial(Dataset *ds, const char *nome_arquivo){
+    if(carregar_snapshot(ds, nome_arquivo)){
+        return;
+    }
+
+    carregar_dataset(ds, nome_arquivo);
+    salvar_snapshot(ds, nome_arquivo);
+}
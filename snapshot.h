@@ -0,0 +1,39 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdio.h>
+#include "dataset.h"
+
+#define VERSAO_SNAPSHOT 1
+#define EXTENSAO_SNAPSHOT ".snap"
+#define MAX_DICIONARIO_SNAPSHOT 65535
+
+typedef struct{
+    char assinatura[4];
+    int versao;
+    int total;
+    int n_estados;
+    int n_culturas;
+    int tamanho_registro;
+    long long tamanho_csv;
+    long long modificacao_csv;
+} CabecalhoSnapshot;
+
+typedef struct{
+    int id;
+    int ano;
+    unsigned short estado;
+    unsigned short cultura;
+    float preco_ton;
+    float rendimento;
+    float producao;
+    float area_plantada;
+    float valor_total;
+} RegistroSnapshot;
+
+void nome_snapshot(const char *nome_arquivo, char *destino, int tamanho);
+int salvar_snapshot(const Dataset *ds, const char *nome_arquivo);
+int carregar_snapshot(Dataset *ds, const char *nome_arquivo);
+void carregar_dataset_inicial(Dataset *ds, const char *nome_arquivo);
+
+#endif
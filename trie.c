@@ -1,11 +1,18 @@
 /*
 ->trie.c
-Implementação de uma Trie para manipulação e busca eficiente de textos (como estados e culturas) 
-em amostras agrícolas.
+Implementação de uma Trie compactada (radix trie) para manipulação e busca eficiente de textos
+(como estados e culturas) em amostras agrícolas.
+Cada aresta guarda um rótulo com vários caracteres, de modo que uma palavra ocupa um único nó
+a partir do ponto em que deixa de compartilhar prefixo com as demais. Os nós, os rótulos e os
+vetores de filhos (ordenados pelo primeiro caractere do rótulo) ficam em três vetores
+contíguos da própria Trie, e os nós se referem uns aos outros por índice.
 Este arquivo contém as funções para criar, inserir, buscar, listar e liberar palavras na Trie, 
 além de funções para busca por prefixo, carregamento de dados a partir de arquivo, e coleta de 
 palavras para filtros.
-Este arquivo não possui benchmarks devido a estrutura peculiar da trie.
+Cada nó terminal guarda a lista de postagens da palavra: os IDs (em ordem crescente) e os
+ponteiros para os registros que contêm a palavra, de modo que uma busca por prefixo chega
+diretamente às amostras, sem percorrer as outras estruturas.
+O único benchmark da trie mede a memória ocupada pelos nós.
 */
 
 #include <stdio.h>
@@ -15,11 +22,12 @@ Este arquivo não possui benchmarks devido a estrutura peculiar da trie.
 #include <time.h>
 #include <windows.h>
 #include "trie.h"
+#include "memoria.h"
 
 /*
 Retorna o índice correspondente ao caractere para uso na Trie.
 Parâmetro: c - caractere a ser convertido
-Retorno: índice inteiro no vetor de filhos da Trie
+Retorno: índice inteiro no alfabeto da Trie, ou -1 se o caractere é ignorado
 */
 int indice_trie(char c){
     if(c == ' '){
@@ -32,89 +40,407 @@ int indice_trie(char c){
 }
 
 /*
-Cria e inicializa um novo nó da Trie para o caractere fornecido.
-Parâmetro: letra - caractere a ser armazenado no nó
-Retorno: ponteiro para o novo nó criado
+Converte uma palavra para a forma guardada na Trie: letras minúsculas e espaços, ignorando os
+demais caracteres.
+Parâmetros:
+    palavra - string original
+    saida - vetor com TAM_MAX_PALAVRA_TRIE posições que recebe a palavra convertida
+Retorno: tamanho da palavra convertida
 */
-NoTrie* criar_no_trie(char letra){
-    NoTrie *no = (NoTrie*)calloc(1, sizeof(NoTrie));
-    no->letra = letra;
-    no->eh_folha = 0;
-
+static int normalizar_trie(const char *palavra, char *saida){
+    int tam = 0;
     int i = 0;
-    for(i; i < TAM_ALFABETO; i++){
-        no->filhos[i] = NULL;
+    for(i; palavra[i] != '\0' && tam < TAM_MAX_PALAVRA_TRIE - 1; i++){
+        char c = palavra[i];
+        if(c >= 'A' && c <= 'Z'){
+            c = c - 'A' + 'a';
+        }
+        if(indice_trie(c) != -1){
+            saida[tam] = c;
+            tam++;
+        }
     }
+    saida[tam] = '\0';
+    return tam;
+}
 
-    return no;
+/*
+Garante espaço para mais n elementos em um dos vetores da Trie, dobrando a capacidade.
+Parâmetros:
+    vetor - endereço do ponteiro para o vetor
+    capacidade - endereço da capacidade atual (em elementos)
+    usados - número de elementos ocupados
+    n - número de elementos que serão acrescentados
+    tamanho - tamanho de cada elemento em bytes
+*/
+static void reservar_vetor_trie(void **vetor, int *capacidade, int usados, int n, size_t tamanho){
+    if(usados + n <= *capacidade){
+        return;
+    }
+    int nova_capacidade = *capacidade == 0 ? 16 : *capacidade;
+    while(nova_capacidade < usados + n){
+        nova_capacidade *= 2;
+    }
+    void *novo = realocar_memoria(MEMORIA_TRIE, *vetor, nova_capacidade * tamanho);
+    if(!novo){
+        printf("Erro ao alocar memoria para a trie\n");
+        exit(EXIT_FAILURE);
+    }
+    *vetor = novo;
+    *capacidade = nova_capacidade;
+}
+
+/*
+Cria um novo nó no vetor de nós da Trie. Como o vetor pode ser realocado, o nó é devolvido
+pelo seu índice.
+Parâmetros:
+    trie - ponteiro para a Trie
+    rotulo - posição do rótulo do nó no vetor de rótulos
+    tam_rotulo - número de caracteres do rótulo
+Retorno: índice do novo nó
+*/
+static int criar_no_trie(Trie *trie, int rotulo, int tam_rotulo){
+    reservar_vetor_trie((void**)&trie->nos, &trie->cap_nos, trie->n_nos, 1, sizeof(NoTrie));
+    NoTrie *no = &trie->nos[trie->n_nos];
+    no->rotulo = rotulo;
+    no->tam_rotulo = tam_rotulo;
+    no->filhos = 0;
+    no->n_filhos = 0;
+    no->cap_filhos = 0;
+    no->eh_folha = 0;
+    iniciar_postagens(&no->postagens);
+    trie->n_nos++;
+    return trie->n_nos - 1;
 }
 
 /*
-Cria e inicializa uma nova Trie vazia.
+Cria e inicializa uma nova Trie vazia (apenas com a raiz, de rótulo vazio).
 Retorno: ponteiro para a Trie criada
 */
 Trie* criar_trie(){
-    Trie *trie = (Trie*)malloc(sizeof(Trie));
-    trie->raiz = criar_no_trie('\0');
+    Trie *trie = (Trie*)alocar_zerada_memoria(MEMORIA_TRIE, 1, sizeof(Trie));
+    if(!trie){
+        printf("Erro ao alocar memoria para a trie\n");
+        exit(EXIT_FAILURE);
+    }
+    criar_no_trie(trie, 0, 0);
     return trie;
 }
 
 /*
-Libera recursivamente toda a memória alocada para um nó da Trie e seus filhos.
-Parâmetro: no - ponteiro para o nó a ser liberado
+Libera toda a memória alocada para a Trie, inclusive as listas de postagens.
+Parâmetro: trie - ponteiro para a Trie a ser liberada
 */
-void liberar_no_trie(NoTrie *no){
-    if(no == NULL){
-        return;
+void liberar_trie(Trie *trie){
+    int i = 0;
+    for(i; i < trie->n_nos; i++){
+        liberar_postagens(&trie->nos[i].postagens);
     }
+    liberar_memoria(MEMORIA_TRIE, trie->nos);
+    liberar_memoria(MEMORIA_TRIE, trie->rotulos);
+    liberar_memoria(MEMORIA_TRIE, trie->filhos);
+    liberar_memoria(MEMORIA_TRIE, trie);
+}
 
-    int i = 0;
-    for(i; i < TAM_ALFABETO; i++){
-        liberar_no_trie(no->filhos[i]);
+/*
+Copia um trecho de palavra para o vetor de rótulos da Trie.
+Parâmetros:
+    trie - ponteiro para a Trie
+    texto - caracteres do rótulo
+    tam - número de caracteres
+Retorno: posição do rótulo no vetor de rótulos
+*/
+static int adicionar_rotulo_trie(Trie *trie, const char *texto, int tam){
+    reservar_vetor_trie((void**)&trie->rotulos, &trie->cap_rotulos, trie->n_rotulos, tam, sizeof(char));
+    memcpy(&trie->rotulos[trie->n_rotulos], texto, tam);
+    trie->n_rotulos += tam;
+    return trie->n_rotulos - tam;
+}
+
+/*
+Retorna o primeiro caractere do rótulo de um nó (chave de ordenação dos filhos).
+*/
+static char primeira_letra_trie(const Trie *trie, int no){
+    return trie->rotulos[trie->nos[no].rotulo];
+}
+
+/*
+Procura, por busca binária, o filho de um nó cujo rótulo começa com o caractere dado.
+Parâmetros:
+    trie - ponteiro para a Trie
+    no - índice do nó pai
+    c - primeiro caractere procurado
+    posicao - recebe a posição do filho no vetor de filhos (ou onde ele deveria entrar)
+Retorno: índice do filho, ou -1 se não existir
+*/
+static int buscar_filho_trie(const Trie *trie, int no, char c, int *posicao){
+    const int *filhos = &trie->filhos[trie->nos[no].filhos];
+    int inicio = 0;
+    int fim = trie->nos[no].n_filhos;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        char letra = primeira_letra_trie(trie, filhos[meio]);
+        if(letra < c){
+            inicio = meio + 1;
+        }else if(letra > c){
+            fim = meio;
+        }else{
+            *posicao = meio;
+            return filhos[meio];
+        }
     }
-    free(no);
+    *posicao = inicio;
+    return -1;
 }
 
 /*
-Libera toda a memória alocada para a Trie.
-Parâmetro: trie - ponteiro para a Trie a ser liberada
+Acrescenta um filho a um nó, na posição que mantém o vetor de filhos ordenado. Quando o vetor
+do nó está cheio, um novo trecho com o dobro do tamanho é reservado no fim do vetor de
+filhos da Trie (os nós têm poucos filhos, então o trecho antigo abandonado é pequeno).
+Parâmetros:
+    trie - ponteiro para a Trie
+    no - índice do nó pai
+    posicao - posição do novo filho no vetor de filhos do pai
+    filho - índice do nó filho
 */
-void liberar_trie(Trie *trie){
-    liberar_no_trie(trie->raiz);
-    free(trie);
+static void adicionar_filho_trie(Trie *trie, int no, int posicao, int filho){
+    if(trie->nos[no].n_filhos == trie->nos[no].cap_filhos){
+        int nova_capacidade = trie->nos[no].cap_filhos == 0 ? 2 : trie->nos[no].cap_filhos * 2;
+        reservar_vetor_trie((void**)&trie->filhos, &trie->cap_filhos, trie->n_filhos, nova_capacidade, sizeof(int));
+        if(trie->nos[no].n_filhos > 0){
+            memcpy(&trie->filhos[trie->n_filhos], &trie->filhos[trie->nos[no].filhos], trie->nos[no].n_filhos * sizeof(int));
+        }
+        trie->nos[no].filhos = trie->n_filhos;
+        trie->nos[no].cap_filhos = nova_capacidade;
+        trie->n_filhos += nova_capacidade;
+    }
+
+    int *filhos = &trie->filhos[trie->nos[no].filhos];
+    memmove(&filhos[posicao + 1], &filhos[posicao], (trie->nos[no].n_filhos - posicao) * sizeof(int));
+    filhos[posicao] = filho;
+    trie->nos[no].n_filhos++;
 }
 
 /*
-Insere uma palavra na Trie.
+Conta quantos caracteres do rótulo de um nó coincidem com o início do texto.
 Parâmetros:
     trie - ponteiro para a Trie
-    palavra - string a ser inserida
+    no - índice do nó
+    texto - caracteres a comparar
+    tam - número de caracteres disponíveis no texto
+Retorno: tamanho do trecho em comum
 */
-void inserir_trie(Trie *trie, const char *palavra){
-    NoTrie *atual = trie->raiz;
-    int i = 0;
-    int len = strlen(palavra);
+static int prefixo_comum_trie(const Trie *trie, int no, const char *texto, int tam){
+    const char *rotulo = &trie->rotulos[trie->nos[no].rotulo];
+    int limite = trie->nos[no].tam_rotulo < tam ? trie->nos[no].tam_rotulo : tam;
+    int k = 0;
+    while(k < limite && rotulo[k] == texto[k]){
+        k++;
+    }
+    return k;
+}
 
-    for(i; i < len; i++){
-        char c = palavra[i];
-        if(c >= 'A' && c <= 'Z'){
-            c = c - 'A' + 'a';
+/*
+Desce pela Trie seguindo uma palavra já normalizada.
+Parâmetros:
+    trie - ponteiro para a Trie
+    palavra - palavra normalizada
+    tam - tamanho da palavra
+    aceitar_meio - 1 para aceitar que a palavra termine no meio de um rótulo (busca por
+                   prefixo), 0 para exigir que termine exatamente em um nó
+    consumidos - se não for NULL, recebe quantos caracteres da palavra precedem o rótulo do
+                 nó retornado
+Retorno: índice do nó alcançado, ou -1 se a palavra não está na Trie
+*/
+static int descer_trie(const Trie *trie, const char *palavra, int tam, int aceitar_meio, int *consumidos){
+    int no = 0;
+    int pos = 0;
+    int anterior = 0;
+    while(pos < tam){
+        int posicao;
+        int filho = buscar_filho_trie(trie, no, palavra[pos], &posicao);
+        if(filho == -1){
+            return -1;
+        }
+        int k = prefixo_comum_trie(trie, filho, &palavra[pos], tam - pos);
+        if(k < trie->nos[filho].tam_rotulo && (pos + k < tam || !aceitar_meio)){
+            return -1;
+        }
+        anterior = pos;
+        pos += k;
+        no = filho;
+    }
+    if(consumidos != NULL){
+        *consumidos = anterior;
+    }
+    return no;
+}
+
+/*
+Inicializa uma lista de postagens vazia.
+Parâmetro: lista - ponteiro para a lista de postagens
+*/
+void iniciar_postagens(ListaPostagens *lista){
+    lista->itens = NULL;
+    lista->total = 0;
+    lista->capacidade = 0;
+}
+
+/*
+Libera a memória de uma lista de postagens, deixando-a vazia.
+Parâmetro: lista - ponteiro para a lista de postagens
+*/
+void liberar_postagens(ListaPostagens *lista){
+    liberar_memoria(MEMORIA_TRIE, lista->itens);
+    iniciar_postagens(lista);
+}
+
+/*
+Garante espaço para mais n postagens na lista, dobrando a capacidade quando necessário.
+Parâmetros:
+    lista - ponteiro para a lista de postagens
+    n - número de postagens que serão acrescentadas
+*/
+static void reservar_postagens(ListaPostagens *lista, int n){
+    if(lista->total + n <= lista->capacidade){
+        return;
+    }
+    int nova_capacidade = lista->capacidade == 0 ? 4 : lista->capacidade;
+    while(nova_capacidade < lista->total + n){
+        nova_capacidade *= 2;
+    }
+    PostagemTrie *itens = (PostagemTrie*)realocar_memoria(MEMORIA_TRIE, lista->itens, nova_capacidade * sizeof(PostagemTrie));
+    if(!itens){
+        printf("Erro ao alocar memoria para a lista de postagens\n");
+        exit(EXIT_FAILURE);
+    }
+    lista->itens = itens;
+    lista->capacidade = nova_capacidade;
+}
+
+/*
+Procura a posição de um ID na lista de postagens (busca binária).
+Parâmetros:
+    lista - ponteiro para a lista de postagens
+    id - identificador procurado
+Retorno: posição do ID, ou posição onde ele deveria ser inserido
+*/
+static int posicao_postagem(const ListaPostagens *lista, int id){
+    int inicio = 0;
+    int fim = lista->total;
+    while(inicio < fim){
+        int meio = inicio + (fim - inicio) / 2;
+        if(lista->itens[meio].id < id){
+            inicio = meio + 1;
+        }else{
+            fim = meio;
         }
+    }
+    return inicio;
+}
 
-        int idx = indice_trie(c);
+/*
+Acrescenta um registro à lista de postagens mantendo a ordem dos IDs. Na carga do arquivo os
+IDs chegam em ordem crescente e a postagem vai direto para o fim da lista.
+Parâmetros:
+    lista - ponteiro para a lista de postagens
+    registro - ponteiro para o registro
+*/
+static void adicionar_postagem(ListaPostagens *lista, Registro *registro){
+    reservar_postagens(lista, 1);
+    int posicao = lista->total;
+    if(lista->total > 0 && lista->itens[lista->total - 1].id > registro->id){
+        posicao = posicao_postagem(lista, registro->id);
+        memmove(&lista->itens[posicao + 1], &lista->itens[posicao], (lista->total - posicao) * sizeof(PostagemTrie));
+    }
+    lista->itens[posicao].id = registro->id;
+    lista->itens[posicao].registro = registro;
+    lista->total++;
+}
+
+/*
+Retira um ID da lista de postagens.
+Parâmetros:
+    lista - ponteiro para a lista de postagens
+    id - identificador a ser retirado
+Retorno: 1 se retirado, 0 se não encontrado
+*/
+static int remover_postagem(ListaPostagens *lista, int id){
+    int posicao = posicao_postagem(lista, id);
+    if(posicao == lista->total || lista->itens[posicao].id != id){
+        return 0;
+    }
+    memmove(&lista->itens[posicao], &lista->itens[posicao + 1], (lista->total - posicao - 1) * sizeof(PostagemTrie));
+    lista->total--;
+    return 1;
+}
 
-        if(idx == -1){
-            continue;
+/*
+Insere uma palavra na Trie e acrescenta o registro à lista de postagens do nó terminal.
+Quando a palavra diverge no meio de um rótulo, a aresta é dividida em duas; o rótulo não é
+copiado, apenas o trecho restante passa a ser referenciado pelo nó de baixo.
+O campo eh_folha conta quantas vezes a palavra foi inserida, permitindo que ela seja
+removida quando a última amostra que a contém for apagada.
+Parâmetros:
+    trie - ponteiro para a Trie
+    palavra - string a ser inserida
+    registro - ponteiro para o registro que contém a palavra
+*/
+void inserir_trie(Trie *trie, const char *palavra, Registro *registro){
+    char texto[TAM_MAX_PALAVRA_TRIE];
+    int tam = normalizar_trie(palavra, texto);
+    int no = 0;
+    int pos = 0;
+
+    while(pos < tam){
+        int posicao;
+        int filho = buscar_filho_trie(trie, no, texto[pos], &posicao);
+
+        if(filho == -1){
+            int rotulo = adicionar_rotulo_trie(trie, &texto[pos], tam - pos);
+            int folha = criar_no_trie(trie, rotulo, tam - pos);
+            adicionar_filho_trie(trie, no, posicao, folha);
+            no = folha;
+            break;
         }
 
-        if(atual->filhos[idx] == NULL){
-            atual->filhos[idx] = criar_no_trie(c);
+        int k = prefixo_comum_trie(trie, filho, &texto[pos], tam - pos);
+        if(k < trie->nos[filho].tam_rotulo){
+            int meio = criar_no_trie(trie, trie->nos[filho].rotulo, k);
+            trie->nos[filho].rotulo += k;
+            trie->nos[filho].tam_rotulo -= k;
+            adicionar_filho_trie(trie, meio, 0, filho);
+            trie->filhos[trie->nos[no].filhos + posicao] = meio;
+            filho = meio;
         }
 
-        atual = atual->filhos[idx];
+        no = filho;
+        pos += k;
     }
 
-    atual->eh_folha = 1;
+    trie->nos[no].eh_folha++;
+    adicionar_postagem(&trie->nos[no].postagens, registro);
+}
+
+/*
+Remove uma ocorrência de uma palavra da Trie, retirando o registro da lista de postagens.
+A palavra deixa de ser encontrada quando todas as suas ocorrências forem removidas.
+Parâmetros:
+    trie - ponteiro para a Trie
+    palavra - string a ser removida
+    id - identificador do registro que continha a palavra
+Retorno: 1 se removida, 0 se não encontrada
+*/
+int remover_trie(Trie *trie, const char *palavra, int id){
+    char texto[TAM_MAX_PALAVRA_TRIE];
+    int tam = normalizar_trie(palavra, texto);
+    int no = descer_trie(trie, texto, tam, 0, NULL);
+
+    if(no == -1 || trie->nos[no].eh_folha == 0 || !remover_postagem(&trie->nos[no].postagens, id)){
+        return 0;
+    }
+    trie->nos[no].eh_folha--;
+    return 1;
 }
 
 /*
@@ -125,54 +451,70 @@ Parâmetros:
 Retorno: 1 se a palavra existe, 0 caso contrário
 */
 int buscar_trie(Trie *trie, const char *palavra){
-    NoTrie *atual = trie->raiz;
-    int i = 0;
-    int len = strlen(palavra);
-    
-    for(i; i < len; i++){
-        char c = palavra[i];
-        if(c >= 'A' && c <= 'Z'){
-            c = c - 'A' + 'a';
-        }
-        int idx = indice_trie(c);
-        if(idx == -1){
-            continue;
-        }
-        if(atual->filhos[idx] == NULL){
-            return 0;
-        }
-        atual = atual->filhos[idx];
-    }
+    char texto[TAM_MAX_PALAVRA_TRIE];
+    int tam = normalizar_trie(palavra, texto);
+    int no = descer_trie(trie, texto, tam, 0, NULL);
 
-    int resultado = (atual != NULL) && (atual->eh_folha);
+    int resultado = (no != -1) && (trie->nos[no].eh_folha);
     return resultado;
 }
 
 /*
-Lista todas as palavras armazenadas a partir do nó atual da Trie.
+Percorre as palavras armazenadas a partir de um nó, imprimindo-as ou guardando-as em uma lista.
+Uma palavra só é guardada se a lista ainda tiver linhas livres e se couber em uma linha
+(TAM_PALAVRA_LISTA_TRIE caracteres, contando o terminador); as demais são apenas contadas.
 Parâmetros:
-    no - ponteiro para o nó atual
-    prefixo - prefixo já montado até o nível atual
-    nivel - profundidade atual na Trie
+    trie - ponteiro para a Trie
+    no - índice do nó atual
+    prefixo - palavra montada até o nó atual, inclusive o seu rótulo
+    nivel - tamanho da palavra montada
+    lista - matriz que recebe as palavras, ou NULL para imprimi-las
+    max - número de linhas da lista
+    total - ponteiro para o número de linhas ocupadas (pode ser NULL ao imprimir)
+Retorno: número de palavras encontradas abaixo do nó
 */
-void listar_palavras_trie(NoTrie *no, char *prefixo, int nivel){
-    if(no == NULL){
-        return;
-    }
-
-    if(no->eh_folha){
+static int percorrer_palavras_trie(const Trie *trie, int no, char *prefixo, int nivel, char lista[][TAM_PALAVRA_LISTA_TRIE], int max, int *total){
+    int encontradas = 0;
+    if(trie->nos[no].eh_folha){
         prefixo[nivel] = '\0';
-        printf("%s\n", prefixo);
+        encontradas++;
+        if(lista == NULL){
+            printf("%s\n", prefixo);
+        }else if(*total < max && nivel < TAM_PALAVRA_LISTA_TRIE){
+            memcpy(lista[*total], prefixo, nivel + 1);
+            (*total)++;
+        }
     }
 
     int i = 0;
-    for(i; i < TAM_ALFABETO; i++){
-        if(no->filhos[i] != NULL){
-            prefixo[nivel] = no->filhos[i]->letra;
-            listar_palavras_trie(no->filhos[i], prefixo, nivel + 1);
-        }
+    for(i; i < trie->nos[no].n_filhos; i++){
+        int filho = trie->filhos[trie->nos[no].filhos + i];
+        memcpy(&prefixo[nivel], &trie->rotulos[trie->nos[filho].rotulo], trie->nos[filho].tam_rotulo);
+        encontradas += percorrer_palavras_trie(trie, filho, prefixo, nivel + trie->nos[filho].tam_rotulo, lista, max, total);
     }
+    return encontradas;
+}
 
+/*
+Localiza o nó de um prefixo e monta, no buffer, a palavra correspondente a esse nó (o
+prefixo pode terminar no meio do rótulo do nó, que é então completado).
+Parâmetros:
+    trie - ponteiro para a Trie
+    prefixo - string com o prefixo
+    buffer - vetor com TAM_MAX_PALAVRA_TRIE posições
+    nivel - recebe o tamanho da palavra montada
+Retorno: índice do nó, ou -1 se nenhuma palavra começa com o prefixo
+*/
+static int preparar_prefixo_trie(const Trie *trie, const char *prefixo, char *buffer, int *nivel){
+    int tam = normalizar_trie(prefixo, buffer);
+    int consumidos = 0;
+    int no = descer_trie(trie, buffer, tam, 1, &consumidos);
+    if(no == -1){
+        return -1;
+    }
+    memcpy(&buffer[consumidos], &trie->rotulos[trie->nos[no].rotulo], trie->nos[no].tam_rotulo);
+    *nivel = consumidos + trie->nos[no].tam_rotulo;
+    return no;
 }
 
 /*
@@ -182,102 +524,229 @@ Parâmetros:
     prefixo - string com o prefixo a ser buscado
 */
 void buscar_prefixo_trie(Trie *trie, const char *prefixo){
-    NoTrie *atual = trie->raiz;
-    int len = strlen(prefixo);
-    int i = 0;
-
-    for(i; i < len; i++){
-        char c = prefixo[i];
-        if(c >= 'A' && c <= 'Z'){
-            c = c - 'A' + 'a';
-        }
-        int idx = indice_trie(c);
-        if(idx == -1){
-            continue;
-        }
-        if(atual->filhos[idx] == NULL){
-            printf("Nenhum resultado encontrado.\n");
-            return;
-        }
-        atual = atual->filhos[idx];
+    char buffer[TAM_MAX_PALAVRA_TRIE];
+    int nivel = 0;
+    int no = preparar_prefixo_trie(trie, prefixo, buffer, &nivel);
+    if(no == -1){
+        printf("Nenhum resultado encontrado.\n");
+        return;
     }
-
-
-    char buffer[100];
-    strcpy(buffer, prefixo);
-    listar_palavras_trie(atual, buffer, strlen(prefixo));
+    percorrer_palavras_trie(trie, no, buffer, nivel, NULL, 0, NULL);
 }
 
 /*
 Carrega dados de um arquivo CSV e insere as palavras da coluna especificada na Trie.
+Os registros passam para o armazém, que deve viver enquanto a Trie apontar para eles.
 Parâmetros:
     trie - ponteiro para a Trie
+    armazem - ponteiro para o armazém que receberá os registros
     nome_arquivo - nome do arquivo de entrada (dataset)
     coluna - índice da coluna a ser lida (ex: 2 para estado, 3 para cultura)
 */
-void carregar_dados_trie(Trie *trie, const char *nome_arquivo, int coluna){
-    FILE *arquivo = fopen(nome_arquivo, "r");
-    if(!arquivo){
-        printf("Erro ao abrir o arquivo\n");
-        exit(EXIT_FAILURE);
+void carregar_dados_trie(Trie *trie, ArmazemRegistros *armazem, const char *nome_arquivo, int coluna){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    carregar_registros_trie(trie, &ds, coluna);
+    adotar_dataset_armazem(armazem, &ds);
+}
+
+/*
+Insere na Trie as palavras da coluna especificada de um dataset já carregado em memória.
+O vetor do dataset deve permanecer alocado (normalmente transferido para o armazém de
+registros), pois as listas de postagens apontam para os seus registros.
+Parâmetros:
+    trie - ponteiro para a Trie
+    ds - ponteiro para o dataset com os registros
+    coluna - índice da coluna a ser lida (2 para estado, 3 para cultura)
+*/
+void carregar_registros_trie(Trie *trie, Dataset *ds, int coluna){
+    int i = 0;
+    for(i; i < ds->total; i++){
+        if(coluna == 2){
+            inserir_trie(trie, nome_estado(ds->itens[i].estado), &ds->itens[i]);
+        }else if(coluna == 3){
+            inserir_trie(trie, nome_cultura(ds->itens[i].cultura), &ds->itens[i]);
+        }
     }
+}
 
-    char linha[256];
-    fgets(linha, sizeof(linha), arquivo);
+/*
+Coleta todas as palavras que começam com o prefixo fornecido e as armazena em uma lista, a
+partir da linha *total. A lista nunca recebe mais que max linhas nem palavras maiores que
+uma linha; se o retorno for maior que o número de palavras acrescentadas, a coleta ficou
+incompleta e o chamador deve repetir com uma lista maior.
+Parâmetros:
+    trie - ponteiro para a Trie
+    prefixo - string com o prefixo (vazio para todas as palavras)
+    lista - matriz de strings para armazenar as palavras encontradas
+    max - número de linhas da lista
+    total - ponteiro para o número de linhas ocupadas da lista, atualizado pela função
+Retorno: número de palavras que começam com o prefixo
+*/
+int coletar_palavras_trie(Trie *trie, const char *prefixo, char lista[][TAM_PALAVRA_LISTA_TRIE], int max, int *total){
+    char buffer[TAM_MAX_PALAVRA_TRIE];
+    int nivel = 0;
+    int no = preparar_prefixo_trie(trie, prefixo, buffer, &nivel);
+    if(no == -1){
+        return 0;
+    }
+    return percorrer_palavras_trie(trie, no, buffer, nivel, lista, max, total);
+}
 
-    while(fgets(linha, sizeof(linha), arquivo)){
-        char *campos[10];
-        char *token = strtok(linha, ";");
-        int idx = 0;
+/*
+Desce pela Trie seguindo o prefixo fornecido. O prefixo pode terminar no meio do rótulo de
+uma aresta: todas as palavras abaixo do nó retornado começam com ele.
+Parâmetros:
+    trie - ponteiro para a Trie
+    prefixo - string com o prefixo
+Retorno: ponteiro para o nó do prefixo, ou NULL se nenhuma palavra começa com ele
+*/
+NoTrie* localizar_prefixo_trie(Trie *trie, const char *prefixo){
+    char texto[TAM_MAX_PALAVRA_TRIE];
+    int tam = normalizar_trie(prefixo, texto);
+    int no = descer_trie(trie, texto, tam, 1, NULL);
+    if(no == -1){
+        return NULL;
+    }
+    return &trie->nos[no];
+}
 
-        while(token != NULL && idx < 10){
-            campos[idx++] = token;
-            token = strtok(NULL, ";");
-        }
+/*
+Acrescenta à saída as listas de postagens de todas as palavras a partir do nó.
+Parâmetros:
+    trie - ponteiro para a Trie
+    no - índice do nó atual
+    saida - ponteiro para a lista que recebe as postagens
+    palavras - ponteiro para o contador de palavras que contribuíram
+*/
+static void acumular_postagens_trie(const Trie *trie, int no, ListaPostagens *saida, int *palavras){
+    const ListaPostagens *postagens = &trie->nos[no].postagens;
+    if(postagens->total > 0){
+        reservar_postagens(saida, postagens->total);
+        memcpy(&saida->itens[saida->total], postagens->itens, postagens->total * sizeof(PostagemTrie));
+        saida->total += postagens->total;
+        (*palavras)++;
+    }
 
-        if(coluna < idx){
-            char palavra[100];
-            strncpy(palavra, campos[coluna], sizeof(palavra));
-            palavra[sizeof(palavra)-1] = '\0';
-            int j = 0;
-            for(j; palavra[j]; j++){
-                if(palavra[j] >= 'A' && palavra[j] <= 'Z'){
-                    palavra[j] = palavra[j] - 'A' + 'a';
-                }
-            }
-
-            inserir_trie(trie, palavra);
-        }
+    int i = 0;
+    for(i; i < trie->nos[no].n_filhos; i++){
+        acumular_postagens_trie(trie, trie->filhos[trie->nos[no].filhos + i], saida, palavras);
     }
+}
 
-    fclose(arquivo);
+/*
+Compara duas postagens pelo ID (usada pelo qsort).
+*/
+static int comparar_postagens(const void *a, const void *b){
+    int id_a = ((const PostagemTrie*)a)->id;
+    int id_b = ((const PostagemTrie*)b)->id;
+    return (id_a > id_b) - (id_a < id_b);
 }
 
 /*
-Coleta todas as palavras armazenadas a partir do nó atual da Trie e as armazena em uma lista.
+Reúne em uma única lista, ordenada por ID, os registros de todas as palavras que começam no
+nó informado (união das listas de postagens). Como cada registro tem um único estado e uma
+única cultura, as listas não se repetem e basta concatená-las; a ordenação só é feita quando
+mais de uma palavra contribuiu.
 Parâmetros:
-    no - ponteiro para o nó atual
-    prefixo - prefixo já montado até o nível atual
-    nivel - profundidade atual na Trie
-    lista - matriz de strings para armazenar as palavras encontradas
-    total - ponteiro para o contador de palavras encontradas
-*/ 
-void coletar_palavras_trie(NoTrie *no, char *prefixo, int nivel, char lista[][50], int *total){
+    trie - ponteiro para a Trie
+    no - ponteiro para o nó do prefixo (localizar_prefixo_trie), ou NULL
+    saida - ponteiro para a lista que recebe as postagens (deve estar iniciada)
+*/
+void coletar_postagens_trie(Trie *trie, NoTrie *no, ListaPostagens *saida){
     if(no == NULL){
         return;
     }
 
-    if(no->eh_folha){
-        prefixo[nivel] = '\0';
-        strcpy(lista[*total], prefixo);
-        (*total)++;
+    int inicio = saida->total;
+    int palavras = 0;
+
+    acumular_postagens_trie(trie, (int)(no - trie->nos), saida, &palavras);
+
+    if(palavras > 1){
+        qsort(&saida->itens[inicio], saida->total - inicio, sizeof(PostagemTrie), comparar_postagens);
     }
-    
-    int i = 0;
-    for(i; i < TAM_ALFABETO; i++){
-        if(no->filhos[i] != NULL){
-            prefixo[nivel] = no->filhos[i]->letra;
-            coletar_palavras_trie(no->filhos[i], prefixo, nivel + 1, lista, total);
+}
+
+/*
+Calcula a interseção de duas listas de postagens ordenadas por ID, percorrendo as duas em
+paralelo.
+Parâmetros:
+    a, b - ponteiros para as listas de postagens
+    saida - ponteiro para a lista que recebe os registros presentes nas duas (deve estar iniciada)
+*/
+void intersectar_postagens(const ListaPostagens *a, const ListaPostagens *b, ListaPostagens *saida){
+    int menor = a->total < b->total ? a->total : b->total;
+    reservar_postagens(saida, menor);
+
+    int i = 0, j = 0;
+    while(i < a->total && j < b->total){
+        if(a->itens[i].id < b->itens[j].id){
+            i++;
+        }else if(a->itens[i].id > b->itens[j].id){
+            j++;
+        }else{
+            saida->itens[saida->total] = a->itens[i];
+            saida->total++;
+            i++;
+            j++;
         }
     }
 }
+
+/*
+Retorna a memória ocupada pela estrutura da Trie: nós, rótulos e vetores de filhos (sem as
+listas de postagens).
+Parâmetro: trie - ponteiro para a Trie
+Retorno: memória em bytes
+*/
+size_t memoria_trie(const Trie *trie){
+    return sizeof(Trie)
+        + (size_t)trie->cap_nos * sizeof(NoTrie)
+        + (size_t)trie->cap_rotulos * sizeof(char)
+        + (size_t)trie->cap_filhos * sizeof(int);
+}
+
+/*
+Retorna a memória ocupada pelas listas de postagens de todos os nós da Trie.
+Parâmetro: trie - ponteiro para a Trie
+Retorno: memória em bytes
+*/
+size_t memoria_postagens_trie(const Trie *trie){
+    size_t memoria = 0;
+    int i = 0;
+    for(i; i < trie->n_nos; i++){
+        memoria += (size_t)trie->nos[i].postagens.capacidade * sizeof(PostagemTrie);
+    }
+    return memoria;
+}
+
+/*
+Mede o uso de memória da Trie de uma coluna (estado ou cultura) com n elementos do dataset.
+Parâmetros:
+    nome_arquivo - nome do arquivo de entrada
+    n - número de elementos a serem inseridos
+    coluna - índice da coluna (2 para estado, 3 para cultura)
+    nos - recebe o número de nós da Trie
+Retorno: bytes vivos que a Trie ocupa no heap segundo o contador de memória (nós, rótulos,
+    filhos e postagens)
+*/
+size_t bench_uso_memoria_trie(const char *nome_arquivo, int n, int coluna, int *nos){
+    Dataset ds;
+    iniciar_dataset(&ds);
+    carregar_dataset(&ds, nome_arquivo);
+    if(n < ds.total){
+        ds.total = n;
+    }
+
+    long long memoria_inicial = memoria_viva(MEMORIA_TRIE);
+    Trie *trie = criar_trie();
+    carregar_registros_trie(trie, &ds, coluna);
+    size_t memoria = (size_t)(memoria_viva(MEMORIA_TRIE) - memoria_inicial);
+    *nos = trie->n_nos;
+
+    liberar_trie(trie);
+    liberar_dataset(&ds);
+    return memoria;
+}
@@ -2,29 +2,65 @@
 #define TRIE_H
 
 #define TAM_ALFABETO 27
+#define TAM_MAX_PALAVRA_TRIE 256
+#define TAM_PALAVRA_LISTA_TRIE 50
 
 #include <stdio.h>
+#include "dataset.h"
+#include "registros.h"
+
+typedef struct{
+    int id;
+    Registro *registro;
+}PostagemTrie;
+
+typedef struct{
+    PostagemTrie *itens;
+    int total;
+    int capacidade;
+}ListaPostagens;
 
 typedef struct NoTrie{
-    char letra;
-    struct NoTrie *filhos[TAM_ALFABETO];
+    int rotulo;
+    int tam_rotulo;
+    int filhos;
+    int n_filhos;
+    int cap_filhos;
     int eh_folha;
+    ListaPostagens postagens;
 }NoTrie;
 
 typedef struct{
-    NoTrie *raiz;
+    NoTrie *nos;
+    int n_nos;
+    int cap_nos;
+    char *rotulos;
+    int n_rotulos;
+    int cap_rotulos;
+    int *filhos;
+    int n_filhos;
+    int cap_filhos;
 }Trie;
 
-NoTrie* criar_no_trie(char letra);
 Trie* criar_trie();
-void liberar_no_trie(NoTrie *no);
 void liberar_trie(Trie *trie);
 
-void inserir_trie(Trie *trie, const char *palavra);
+void inserir_trie(Trie *trie, const char *palavra, Registro *registro);
+int remover_trie(Trie *trie, const char *palavra, int id);
 int buscar_trie(Trie *trie, const char *palavra);
-void listar_palavras_trie(NoTrie *no, char *prefixo, int nivel);
 void buscar_prefixo_trie(Trie *trie, const char *prefixo);
-void carregar_dados_trie(Trie *trie, const char *nome_arquivo, int coluna);
-void coletar_palavras_trie(NoTrie *no, char *prefixo, int nivel, char lista[][50], int *total);
+void carregar_dados_trie(Trie *trie, ArmazemRegistros *armazem, const char *nome_arquivo, int coluna);
+void carregar_registros_trie(Trie *trie, Dataset *ds, int coluna);
+int coletar_palavras_trie(Trie *trie, const char *prefixo, char lista[][TAM_PALAVRA_LISTA_TRIE], int max, int *total);
+
+void iniciar_postagens(ListaPostagens *lista);
+void liberar_postagens(ListaPostagens *lista);
+NoTrie* localizar_prefixo_trie(Trie *trie, const char *prefixo);
+void coletar_postagens_trie(Trie *trie, NoTrie *no, ListaPostagens *saida);
+void intersectar_postagens(const ListaPostagens *a, const ListaPostagens *b, ListaPostagens *saida);
+
+size_t memoria_trie(const Trie *trie);
+size_t memoria_postagens_trie(const Trie *trie);
+size_t bench_uso_memoria_trie(const char *nome_arquivo, int n, int coluna, int *nos);
 
 #endif